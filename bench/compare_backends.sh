@@ -0,0 +1,30 @@
+#!/bin/bash
+#
+# Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+
+# Builds the loopback benchmark with the epoll and io_uring backends,
+# and runs both against the local server.
+# Usage: compare_backends.sh <username> <password> [tcp|unix] [<num-connections>] [<num-lookups>]
+
+set -e
+
+SOURCE_DIR=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_DIR=${BUILD_DIR:-$SOURCE_DIR/__build_bench}
+
+for BACKEND in epoll io_uring; do
+    if [ "$BACKEND" == "io_uring" ]; then IO_URING=ON; else IO_URING=OFF; fi
+    cmake -S "$SOURCE_DIR" -B "$BUILD_DIR/$BACKEND" \
+        -DCMAKE_BUILD_TYPE=Release \
+        -DBUILD_TESTING=OFF \
+        -DBOOST_MYSQL_BENCH=ON \
+        -DBOOST_MYSQL_IO_URING=$IO_URING > /dev/null
+    cmake --build "$BUILD_DIR/$BACKEND" --target boost_mysql_bench_loopback -j$(nproc) > /dev/null
+done
+
+for BACKEND in epoll io_uring; do
+    "$BUILD_DIR/$BACKEND/bench/boost_mysql_bench_loopback" "$@"
+done
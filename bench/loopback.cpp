@@ -0,0 +1,231 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Loopback benchmark, measuring the I/O backend overhead with many connections
+// served by a single thread. Build it once with BOOST_MYSQL_IO_URING=OFF (epoll)
+// and once with BOOST_MYSQL_IO_URING=ON, and compare the results. Workloads:
+//   - point_lookup: every connection repeatedly executes a prepared statement
+//     retrieving a single row by primary key.
+//   - row_streaming: every connection reads a big table, row by row.
+// Requires the database and user created by example/db_setup.sql.
+
+#include <boost/mysql.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/system/system_error.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+
+namespace
+{
+
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL)
+constexpr const char* backend = "io_uring";
+#else
+constexpr const char* backend = "epoll";
+#endif
+
+struct bench_config
+{
+    const char* username;
+    const char* password;
+    std::size_t num_connections {16};
+    std::size_t num_lookups {10000}; // per connection
+    std::size_t num_rows {100000};   // streamed per connection
+    std::size_t lookup_table_size {1000};
+};
+
+void check_error(const error_code& err, const error_info& info = {})
+{
+    if (err)
+    {
+        throw boost::system::system_error(err, info.message());
+    }
+}
+
+// Generates num_rows rows using cross-joined digit tables, as servers
+// may limit recursion depth in CTEs
+std::string populate_query(std::size_t num_rows)
+{
+    const char* digits = "(SELECT 0 d UNION ALL SELECT 1 UNION ALL SELECT 2 UNION ALL SELECT 3 "
+        "UNION ALL SELECT 4 UNION ALL SELECT 5 UNION ALL SELECT 6 UNION ALL SELECT 7 "
+        "UNION ALL SELECT 8 UNION ALL SELECT 9)";
+    std::string id_expr = "d0.d";
+    std::string from = std::string(digits) + " d0";
+    std::size_t multiplier = 10;
+    for (std::size_t i = 1; multiplier < num_rows; ++i, multiplier *= 10)
+    {
+        std::string name = "d" + std::to_string(i);
+        id_expr += " + " + std::to_string(multiplier) + "*" + name + ".d";
+        from += ", " + std::string(digits) + " " + name;
+    }
+    return "INSERT INTO bench_rows (id, payload) SELECT " + id_expr +
+        ", REPEAT('x', 64) FROM " + from + " WHERE " + id_expr + " < " + std::to_string(num_rows);
+}
+
+template <class Connection>
+void setup_table(Connection& conn, std::size_t num_rows, boost::asio::yield_context yield)
+{
+    error_code err;
+    error_info info;
+    conn.async_query("DROP TEMPORARY TABLE IF EXISTS bench_rows", info, yield[err]);
+    check_error(err, info);
+    conn.async_query(
+        "CREATE TEMPORARY TABLE bench_rows (id INT PRIMARY KEY, payload VARCHAR(64) NOT NULL)",
+        info,
+        yield[err]
+    );
+    check_error(err, info);
+    conn.async_query(populate_query(num_rows), info, yield[err]);
+    check_error(err, info);
+}
+
+template <class Connection>
+void point_lookups(Connection& conn, const bench_config& cfg, boost::asio::yield_context yield)
+{
+    error_code err;
+    error_info info;
+    auto stmt = conn.async_prepare_statement("SELECT payload FROM bench_rows WHERE id = ?", info, yield[err]);
+    check_error(err, info);
+    for (std::size_t i = 0; i < cfg.num_lookups; ++i)
+    {
+        auto id = static_cast<std::int64_t>(i % cfg.lookup_table_size);
+        auto result = stmt.async_execute(boost::mysql::make_values(id), info, yield[err]);
+        check_error(err, info);
+        result.async_read_all(info, yield[err]);
+        check_error(err, info);
+    }
+}
+
+template <class Connection>
+void row_streaming(Connection& conn, boost::asio::yield_context yield)
+{
+    error_code err;
+    error_info info;
+    auto result = conn.async_query("SELECT id, payload FROM bench_rows", info, yield[err]);
+    check_error(err, info);
+    boost::mysql::row r;
+    while (result.async_read_one(r, info, yield[err]))
+    {
+    }
+    check_error(err, info);
+}
+
+// Runs fn on every connection concurrently, returning the elapsed seconds.
+// Setup (connect and populate tables) is not measured
+template <class Connection, class Endpoint, class Fn>
+double run_workload(const Endpoint& ep, const bench_config& cfg, std::size_t table_size, Fn fn)
+{
+    boost::asio::io_context ctx (1);
+    boost::mysql::connection_params params (cfg.username, cfg.password, "boost_mysql_examples");
+    params.set_ssl(boost::mysql::ssl_mode::disable); // measure I/O, not encryption
+
+    std::vector<std::unique_ptr<Connection>> conns;
+    std::size_t pending = cfg.num_connections;
+    for (std::size_t i = 0; i < cfg.num_connections; ++i)
+    {
+        conns.emplace_back(new Connection(ctx.get_executor()));
+        boost::asio::spawn(ctx.get_executor(), [&, i](boost::asio::yield_context yield) {
+            error_code err;
+            error_info info;
+            conns[i]->async_connect(ep, params, info, yield[err]);
+            check_error(err, info);
+            setup_table(*conns[i], table_size, yield);
+            --pending;
+        });
+    }
+    ctx.run();
+    if (pending)
+        throw std::runtime_error("Setup failed");
+
+    ctx.restart();
+    for (auto& conn : conns)
+    {
+        Connection* c = conn.get();
+        boost::asio::spawn(ctx.get_executor(), [c, &fn](boost::asio::yield_context yield) {
+            fn(*c, yield);
+            c->async_close(yield);
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    ctx.run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+template <class Connection, class Endpoint>
+void run_benchmarks(const Endpoint& ep, const char* transport, const bench_config& cfg)
+{
+    double lookup_secs = run_workload<Connection>(ep, cfg, cfg.lookup_table_size,
+        [&cfg](Connection& conn, boost::asio::yield_context yield) { point_lookups(conn, cfg, yield); });
+    double total_lookups = static_cast<double>(cfg.num_lookups * cfg.num_connections);
+    std::cout << backend << "," << transport << ",point_lookup," << cfg.num_connections << ","
+              << lookup_secs << "," << total_lookups / lookup_secs << " lookups/s\n";
+
+    double streaming_secs = run_workload<Connection>(ep, cfg, cfg.num_rows,
+        [](Connection& conn, boost::asio::yield_context yield) { row_streaming(conn, yield); });
+    double total_rows = static_cast<double>(cfg.num_rows * cfg.num_connections);
+    std::cout << backend << "," << transport << ",row_streaming," << cfg.num_connections << ","
+              << streaming_secs << "," << total_rows / streaming_secs << " rows/s\n";
+}
+
+void main_impl(int argc, char** argv)
+{
+    if (argc < 3 || argc > 6)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <username> <password> [tcp|unix] [<num-connections>] [<num-lookups>]\n";
+        exit(1);
+    }
+    bench_config cfg;
+    cfg.username = argv[1];
+    cfg.password = argv[2];
+    std::string transport = argc >= 4 ? argv[3] : "tcp";
+    if (argc >= 5)
+        cfg.num_connections = std::strtoul(argv[4], nullptr, 10);
+    if (argc >= 6)
+        cfg.num_lookups = std::strtoul(argv[5], nullptr, 10);
+
+    std::cout << "backend,transport,workload,connections,seconds,throughput\n";
+    if (transport == "tcp")
+    {
+        boost::asio::ip::tcp::endpoint ep (boost::asio::ip::address_v4::loopback(), boost::mysql::default_port);
+        run_benchmarks<boost::mysql::tcp_connection>(ep, "tcp", cfg);
+    }
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+    else if (transport == "unix")
+    {
+        boost::asio::local::stream_protocol::endpoint ep ("/var/run/mysqld/mysqld.sock");
+        run_benchmarks<boost::mysql::unix_connection>(ep, "unix", cfg);
+    }
+#endif
+    else
+    {
+        std::cerr << "Unsupported transport: " << transport << "\n";
+        exit(1);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        main_impl(argc, argv);
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << "Error: " << err.what() << std::endl;
+        return 1;
+    }
+}
@@ -10,5 +10,11 @@
 
 #include <boost/mysql/connection.hpp>
 #include <boost/mysql/socket_connection.hpp>
+#include <boost/mysql/format_sql.hpp>
+#include <boost/mysql/hedged_query.hpp>
+#include <boost/mysql/column_batch.hpp>
+#include <boost/mysql/compact_row.hpp>
+#include <boost/mysql/lazy_row.hpp>
+#include <boost/mysql/decimal.hpp>
 
 #endif
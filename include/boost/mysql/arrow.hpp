@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_ARROW_HPP
+#define BOOST_MYSQL_ARROW_HPP
+
+// Export of resultsets through the Apache Arrow C data interface.
+// This header is not part of the header-only library: using it requires
+// linking to the compiled Boost::mysql_arrow library.
+
+#include <boost/mysql/column_batch.hpp>
+#include <boost/mysql/resultset.hpp>
+#include <stdint.h>
+
+#ifndef BOOST_MYSQL_DOXYGEN
+
+// Structures defined by the Arrow C data interface specification
+// (https://arrow.apache.org/docs/format/CDataInterface.html).
+// The guard allows including this header together with Arrow's own headers.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema
+{
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray
+{
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+#endif // BOOST_MYSQL_DOXYGEN
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief Returns the Arrow format string a [reflink column] is exported with.
+ * \details The mapping is:
+ *
+ *  - [refmem column_type int64]: `"l"` (int64).
+ *  - [refmem column_type uint64]: `"L"` (uint64).
+ *  - [refmem column_type double_]: `"g"` (float64).
+ *  - [refmem column_type date]: `"tdD"` (date32).
+ *  - [refmem column_type datetime]: `"tsu:"` (timestamp with microsecond precision, without time zone).
+ *  - [refmem column_type time]: `"tDu"` (duration with microsecond precision). `__TIME__` values
+ *    may be negative or exceed 24 hours, so they can't be represented as an Arrow time of day.
+ *  - [refmem column_type string]: `"Z"` (large binary) if [refmem column is_binary] is `true`,
+ *    `"U"` (large UTF-8 string) otherwise.
+ *
+ * The returned string has static storage duration.
+ */
+const char* arrow_format(const column& col) noexcept;
+
+/**
+ * \brief Exports a [reflink column_batch] through the Arrow C data interface.
+ * \details On return, `out_array` and `out_schema` hold an Arrow struct array
+ * with a child array per column in `batch`. Column buffers are transferred to
+ * the exported arrays without being copied: `batch` is left empty, as if
+ * [refmem column_batch clear] had been called.
+ *
+ * `out_array` and `out_schema` must point to writable, uninitialized structures. The
+ * caller (usually an Arrow consumer) takes ownership of the exported data and must
+ * eventually call their `release` callbacks, as mandated by the Arrow specification.
+ */
+void export_arrow(column_batch&& batch, ArrowArray* out_array, ArrowSchema* out_schema);
+
+/**
+ * \brief Reads all remaining rows in a resultset and exports them
+ *        through the Arrow C data interface (sync with error code version).
+ * \details Equivalent to calling [reflink read_columns]
+ * followed by [reflink export_arrow]. If the operation fails, `out_array`
+ * and `out_schema` are not modified.
+ */
+template <class Stream>
+void read_arrow(
+    resultset<Stream>& result,
+    ArrowArray* out_array,
+    ArrowSchema* out_schema,
+    error_code& err,
+    error_info& info
+)
+{
+    column_batch batch;
+    read_columns(result, batch, err, info);
+    if (!err)
+        export_arrow(std::move(batch), out_array, out_schema);
+}
+
+/**
+ * \brief Reads all remaining rows in a resultset and exports them
+ *        through the Arrow C data interface (sync with exceptions version).
+ * \details Equivalent to calling [reflink read_columns]
+ * followed by [reflink export_arrow]. If the operation fails, `out_array`
+ * and `out_schema` are not modified.
+ */
+template <class Stream>
+void read_arrow(
+    resultset<Stream>& result,
+    ArrowArray* out_array,
+    ArrowSchema* out_schema
+)
+{
+    column_batch batch;
+    read_columns(result, batch);
+    export_arrow(std::move(batch), out_array, out_schema);
+}
+
+} // mysql
+} // boost
+
+#endif
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_BULK_INSERT_PARAMS_HPP
+#define BOOST_MYSQL_BULK_INSERT_PARAMS_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <cstddef>
+#include <iterator>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief Default maximum size of the statements generated by [refmem connection bulk_insert].
+ * \details Well below MySQL's default `max_allowed_packet`.
+ */
+constexpr std::size_t default_bulk_insert_statement_size = 1024 * 1024;
+
+/**
+  * \brief Represents the parameters required to perform a [refmem connection bulk_insert].
+  * \details Contains the beginning of the `INSERT` statement (e.g.
+  * `"INSERT INTO mytable (col1, col2) VALUES "`), an iterator range \\[first, last)
+  * pointing to the rows to insert, and the maximum size of each generated statement.
+  *
+  * Each row may either be a [reflink ValueCollection] (like a `std::vector<value>` or
+  * the values of a [reflink row]) or a `std::tuple` of types
+  * [reflink value] is constructible from.
+  *
+  * The \ref make_bulk_insert_params helper functions make it easier to create
+  * instances of this class.
+  */
+template <class RowForwardIterator>
+class bulk_insert_params
+{
+    boost::string_view statement_prefix_;
+    RowForwardIterator first_;
+    RowForwardIterator last_;
+    std::size_t max_statement_size_;
+public:
+    /// Constructor.
+    constexpr bulk_insert_params(
+        boost::string_view statement_prefix,
+        RowForwardIterator first,
+        RowForwardIterator last,
+        std::size_t max_statement_size = default_bulk_insert_statement_size
+    ) :
+        statement_prefix_(statement_prefix),
+        first_(first),
+        last_(last),
+        max_statement_size_(max_statement_size)
+    {
+    }
+
+    /// Retrieves the statement text preceding the rows.
+    constexpr boost::string_view statement_prefix() const { return statement_prefix_; }
+
+    /// Retrieves the row range's begin.
+    constexpr RowForwardIterator first() const { return first_; }
+
+    /// Retrieves the row range's end.
+    constexpr RowForwardIterator last() const { return last_; }
+
+    /// Retrieves the maximum size of each generated statement, in bytes.
+    constexpr std::size_t max_statement_size() const { return max_statement_size_; }
+
+    /// Sets the statement text preceding the rows.
+    void set_statement_prefix(boost::string_view v) { statement_prefix_ = v; }
+
+    /// Sets the row range's begin.
+    void set_first(RowForwardIterator v) { first_ = v; }
+
+    /// Sets the row range's end.
+    void set_last(RowForwardIterator v) { last_ = v; }
+
+    /// Sets the maximum size of each generated statement, in bytes.
+    void set_max_statement_size(std::size_t v) { max_statement_size_ = v; }
+};
+
+/**
+  * \relates bulk_insert_params
+  * \brief Creates an instance of [reflink bulk_insert_params] from a pair of iterators.
+  */
+template <class RowForwardIterator>
+constexpr bulk_insert_params<RowForwardIterator>
+make_bulk_insert_params(
+    boost::string_view statement_prefix,
+    RowForwardIterator first,
+    RowForwardIterator last,
+    std::size_t max_statement_size = default_bulk_insert_statement_size
+)
+{
+    return bulk_insert_params<RowForwardIterator>(statement_prefix, first, last, max_statement_size);
+}
+
+/**
+  * \relates bulk_insert_params
+  * \brief Creates an instance of [reflink bulk_insert_params] from a collection of rows.
+  */
+template <class RowCollection>
+constexpr auto make_bulk_insert_params(
+    boost::string_view statement_prefix,
+    const RowCollection& rows,
+    std::size_t max_statement_size = default_bulk_insert_statement_size
+) -> bulk_insert_params<decltype(std::begin(rows))>
+{
+    return make_bulk_insert_params(statement_prefix, std::begin(rows), std::end(rows), max_statement_size);
+}
+
+}
+}
+
+
+#endif
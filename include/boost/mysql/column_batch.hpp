@@ -0,0 +1,274 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_COLUMN_BATCH_HPP
+#define BOOST_MYSQL_COLUMN_BATCH_HPP
+
+#include <boost/mysql/value.hpp>
+#include <boost/mysql/metadata.hpp>
+#include <boost/mysql/error.hpp>
+#include <boost/mysql/resultset.hpp>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief The physical representation used by a [reflink column].
+ * \details Determined by the type of the field the column was created from.
+ */
+enum class column_type
+{
+    int64,     ///< Signed integers. Values are stored in [refmem column int64_values].
+    uint64,    ///< Unsigned integers, `__YEAR__` and `__BIT__`. Values are stored in [refmem column uint64_values].
+    double_,   ///< `__FLOAT__` and `__DOUBLE__`. Values are stored in [refmem column double_values].
+    date,      ///< `__DATE__`. Days since the epoch, stored in [refmem column date_values].
+    datetime,  ///< `__DATETIME__` and `__TIMESTAMP__`. Microseconds since the epoch, stored in [refmem column int64_values].
+    time,      ///< `__TIME__`. Microseconds, stored in [refmem column int64_values].
+    string     ///< Any other type. Stored in [refmem column string_offsets] and [refmem column string_data].
+};
+
+/**
+ * \relates column_type
+ * \brief Streams a boost::mysql::column_type.
+ */
+inline std::ostream& operator<<(std::ostream& os, column_type t)
+{
+    switch (t)
+    {
+    case column_type::int64: return os << "int64";
+    case column_type::uint64: return os << "uint64";
+    case column_type::double_: return os << "double_";
+    case column_type::date: return os << "date";
+    case column_type::datetime: return os << "datetime";
+    case column_type::time: return os << "time";
+    case column_type::string: return os << "string";
+    default: return os << "<unknown column type>";
+    }
+}
+
+/**
+ * \brief A single column of a [reflink column_batch].
+ * \details Values are stored in typed, contiguous arrays, rather than as a sequence
+ * of [reflink value]s. Which of the arrays is populated depends on [refmem column type].
+ *
+ * Fixed-size values are stored one per row, including NULL rows (where the stored
+ * value is zero). Strings are stored contiguously in [refmem column string_data]; the
+ * i-th string spans the range `[string_offsets()[i], string_offsets()[i+1])`.
+ *
+ * Nullness is tracked by [refmem column validity], a bitmap holding one bit per row,
+ * least significant bit first. A set bit means that the value is not NULL.
+ */
+class column
+{
+    std::string name_;
+    column_type type_ { column_type::string };
+    bool binary_ {false};
+    std::size_t size_ {0};
+    std::size_t null_count_ {0};
+    std::vector<std::uint8_t> validity_;
+    std::vector<std::int64_t> int64_data_;
+    std::vector<std::uint64_t> uint64_data_;
+    std::vector<double> double_data_;
+    std::vector<std::int32_t> date_data_;
+    std::vector<std::int64_t> offsets_ { 0 };
+    std::vector<char> string_data_;
+
+    void push_validity(bool is_valid);
+public:
+    /// \brief Default constructor.
+    /// \details Constructs an empty column of type [refmem column_type string].
+    column() = default;
+
+#ifndef BOOST_MYSQL_DOXYGEN
+    // Private, do not use
+    void reset(const field_metadata& meta);
+    error_code push_back(const value& v);
+#endif
+
+    /// Returns the name of the field this column was created from.
+    const std::string& name() const noexcept { return name_; }
+
+    /// Returns the physical representation used by this column.
+    column_type type() const noexcept { return type_; }
+
+    /**
+     * \brief Returns whether a string column holds binary data.
+     * \details `true` for `__BINARY__`, `__VARBINARY__`, `__BLOB__` and `__GEOMETRY__`.
+     * `false` for any other type.
+     */
+    bool is_binary() const noexcept { return binary_; }
+
+    /// Returns the number of values (rows) in the column.
+    std::size_t size() const noexcept { return size_; }
+
+    /// Returns the number of NULL values in the column.
+    std::size_t null_count() const noexcept { return null_count_; }
+
+    /// Returns `true` if the i-th value is NULL. `i` must be less than [refmem column size].
+    bool is_null(std::size_t i) const noexcept { return !((validity_[i / 8] >> (i % 8)) & 1); }
+
+    /// Returns the validity bitmap, with one bit per value, least significant bit first.
+    const std::vector<std::uint8_t>& validity() const noexcept { return validity_; }
+
+    /// Values for [refmem column_type int64], [refmem column_type datetime] and [refmem column_type time] columns.
+    const std::vector<std::int64_t>& int64_values() const noexcept { return int64_data_; }
+
+    /// Values for [refmem column_type uint64] columns.
+    const std::vector<std::uint64_t>& uint64_values() const noexcept { return uint64_data_; }
+
+    /// Values for [refmem column_type double_] columns.
+    const std::vector<double>& double_values() const noexcept { return double_data_; }
+
+    /// Values for [refmem column_type date] columns, as days since the epoch.
+    const std::vector<std::int32_t>& date_values() const noexcept { return date_data_; }
+
+    /// String offsets for [refmem column_type string] columns. Contains [refmem column size] + 1 elements.
+    const std::vector<std::int64_t>& string_offsets() const noexcept { return offsets_; }
+
+    /// String bytes for [refmem column_type string] columns.
+    const std::vector<char>& string_data() const noexcept { return string_data_; }
+
+    /**
+     * \brief Retrieves the i-th value as a [reflink value].
+     * \details `i` must be less than [refmem column size]. If the value is a string,
+     * it will point into the column's memory.
+     */
+    value at(std::size_t i) const noexcept;
+
+#ifndef BOOST_MYSQL_DOXYGEN
+    // Private, do not use
+    std::vector<std::uint8_t>& validity_buffer() noexcept { return validity_; }
+    std::vector<std::int64_t>& int64_buffer() noexcept { return int64_data_; }
+    std::vector<std::uint64_t>& uint64_buffer() noexcept { return uint64_data_; }
+    std::vector<double>& double_buffer() noexcept { return double_data_; }
+    std::vector<std::int32_t>& date_buffer() noexcept { return date_data_; }
+    std::vector<std::int64_t>& offsets_buffer() noexcept { return offsets_; }
+    std::vector<char>& string_buffer() noexcept { return string_data_; }
+#endif
+};
+
+/**
+ * \brief A set of rows stored column by column (struct of arrays).
+ * \details Populated by [reflink read_columns]. Contains one [reflink column]
+ * per field in the resultset, in the same order as [refmem resultset fields].
+ * All columns have [refmem column_batch num_rows] elements.
+ *
+ * Compared to a sequence of [reflink row]s, this representation does not store a
+ * [reflink value] per field, nor retains the protocol buffers the rows were received in.
+ * This makes it more compact and more suitable for analytical processing.
+ */
+class column_batch
+{
+    std::vector<column> columns_;
+    std::size_t num_rows_ {0};
+public:
+    /// Default constructor. Constructs a batch without columns.
+    column_batch() = default;
+
+    /// Returns the columns in the batch.
+    const std::vector<column>& columns() const noexcept { return columns_; }
+
+    /// Returns the number of rows in the batch.
+    std::size_t num_rows() const noexcept { return num_rows_; }
+
+    /// Returns the i-th column. `i` must be less than `columns().size()`.
+    const column& operator[](std::size_t i) const noexcept { return columns_[i]; }
+
+    /// Removes all columns and rows from the batch.
+    void clear() noexcept { columns_.clear(); num_rows_ = 0; }
+
+#ifndef BOOST_MYSQL_DOXYGEN
+    // Private, do not use
+    void reset(const std::vector<field_metadata>& fields);
+    error_code append_row(const std::vector<value>& values);
+    std::vector<column>& mutable_columns() noexcept { return columns_; }
+#endif
+};
+
+/**
+ * \brief Reads all available rows into a columnar representation
+ *        (sync with error code version).
+ * \details `output` is reset to contain a [reflink column] per field in the resultset,
+ * possibly reusing its memory, and is then populated with all the remaining rows.
+ * Rows are decoded one at a time and appended to the columns, so
+ * no [reflink row] object is kept for each read row.
+ *
+ * If the operation fails, `output` is left in a valid but undetermined state.
+ */
+template <class Stream>
+void read_columns(
+    resultset<Stream>& result,
+    column_batch& output,
+    error_code& err,
+    error_info& info
+);
+
+/**
+ * \brief Reads all available rows into a columnar representation
+ *        (sync with exceptions version).
+ * \details See the error code version for more info.
+ */
+template <class Stream>
+void read_columns(
+    resultset<Stream>& result,
+    column_batch& output
+);
+
+/**
+ * \brief Reads all available rows into a columnar representation
+ *        (async without [reflink error_info] version).
+ * \details See the sync version for more info.
+ *
+ * The handler signature for this operation is
+ * `void(boost::mysql::error_code)`.
+ */
+template <
+    class Stream,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+    CompletionToken
+    BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(typename resultset<Stream>::executor_type)
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+async_read_columns(
+    resultset<Stream>& result,
+    column_batch& output,
+    CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(typename resultset<Stream>::executor_type)
+);
+
+/**
+ * \brief Reads all available rows into a columnar representation
+ *        (async with [reflink error_info] version).
+ * \details See the sync version for more info.
+ *
+ * The handler signature for this operation is
+ * `void(boost::mysql::error_code)`.
+ */
+template <
+    class Stream,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+    CompletionToken
+    BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(typename resultset<Stream>::executor_type)
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+async_read_columns(
+    resultset<Stream>& result,
+    column_batch& output,
+    error_info& output_info,
+    CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(typename resultset<Stream>::executor_type)
+);
+
+} // mysql
+} // boost
+
+#include <boost/mysql/impl/column_batch.ipp>
+#include <boost/mysql/impl/column_batch.hpp>
+
+#endif
@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_COMPACT_ROW_HPP
+#define BOOST_MYSQL_COMPACT_ROW_HPP
+
+#include <boost/mysql/row.hpp>
+#include <boost/mysql/value.hpp>
+#include <boost/mysql/detail/auxiliar/bytestring.hpp>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// A value, stored in 16 bytes. Strings are stored as an offset
+// into the owning compact_row's buffer, rather than as a pointer.
+struct compact_cell
+{
+    enum class kind : std::uint8_t
+    {
+        null,
+        int64,
+        uint64,
+        string,
+        float_,
+        double_,
+        date,
+        datetime,
+        time
+    };
+
+    struct string_ref
+    {
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    union
+    {
+        std::int64_t int64;
+        std::uint64_t uint64;
+        float float_;
+        double double_;
+        std::int32_t days;     // date
+        std::int64_t micros;   // datetime and time
+        string_ref string;
+    } data;
+    kind type;
+};
+
+static_assert(sizeof(compact_cell) == 16, "compact_cell should be 16 bytes");
+
+} // detail
+
+/**
+ * \brief A memory-efficient, owning representation of a [reflink row].
+ * \details A [reflink row] stores a sequence of [reflink value]s plus the buffer
+ * the row was received in. Every [reflink value] takes 24 bytes,
+ * regardless of its type, and the buffer holds the entire protocol message,
+ * including the representation of non-string values.
+ *
+ * A [reflink compact_row] stores each field in a 16 byte cell, and only keeps the bytes
+ * of string values in its buffer. Strings are stored as offsets into this buffer,
+ * which makes [reflink compact_row] copyable. This makes it suitable
+ * for keeping large amounts of rows in memory (e.g. in a cache).
+ *
+ * Fields are accessed as [reflink value]s, which are computed on every access.
+ * String [reflink value]s returned by the accessors point into the
+ * [reflink compact_row]'s buffer, and are valid as long as the object is alive
+ * and is not assigned to or cleared.
+ *
+ * A single [reflink compact_row] can't hold more than 4GB of string data,
+ * which exceeds the maximum row size MySQL allows.
+ */
+class compact_row
+{
+    std::vector<detail::compact_cell> cells_;
+    detail::bytestring buffer_;
+public:
+    /// Default constructor. Constructs an empty row.
+    compact_row() = default;
+
+    /// Constructs a compact row holding a copy of the given values.
+    explicit compact_row(const std::vector<value>& values);
+
+    /// Constructs a compact row holding a copy of the given row's values.
+    explicit compact_row(const row& r): compact_row(r.values()) {}
+
+    /// Returns the number of values in the row.
+    std::size_t size() const noexcept { return cells_.size(); }
+
+    /// Returns `true` if the row has no values.
+    bool empty() const noexcept { return cells_.empty(); }
+
+    /// Returns the i-th value. `i` must be less than [refmem compact_row size].
+    value operator[](std::size_t i) const noexcept;
+
+    /// Returns the i-th value. Throws `std::out_of_range` if `i` is not less than [refmem compact_row size].
+    value at(std::size_t i) const;
+
+    /**
+     * \brief Returns all values in the row.
+     * \details String values will point into `*this`.
+     */
+    std::vector<value> values() const;
+
+    /// Removes all values from the row, invalidating any string values obtained from it.
+    void clear() noexcept
+    {
+        cells_.clear();
+        buffer_.clear();
+    }
+};
+
+/**
+ * \relates compact_row
+ * \brief Compares two rows.
+ */
+inline bool operator==(const compact_row& lhs, const compact_row& rhs) noexcept;
+
+/**
+ * \relates compact_row
+ * \brief Compares two rows.
+ */
+inline bool operator!=(const compact_row& lhs, const compact_row& rhs) noexcept { return !(lhs == rhs); }
+
+/**
+ * \relates compact_row
+ * \brief Streams a row, using the same format as [reflink row].
+ */
+inline std::ostream& operator<<(std::ostream& os, const compact_row& r);
+
+} // mysql
+} // boost
+
+#include <boost/mysql/impl/compact_row.ipp>
+
+#endif
@@ -14,10 +14,14 @@
 #include <boost/mysql/detail/protocol/channel.hpp>
 #include <boost/mysql/detail/protocol/protocol_types.hpp>
 #include <boost/mysql/detail/network_algorithms/handshake.hpp>
+#include <boost/mysql/detail/network_algorithms/change_user.hpp>
 #include <boost/mysql/error.hpp>
 #include <boost/mysql/resultset.hpp>
 #include <boost/mysql/prepared_statement.hpp>
 #include <boost/mysql/connection_params.hpp>
+#include <boost/mysql/local_infile.hpp>
+#include <boost/mysql/bulk_insert_params.hpp>
+#include <boost/mysql/format_options.hpp>
 #endif
 
 /// The Boost libraries namespace.
@@ -77,11 +81,13 @@ public:
      * \details
      * As part of the initialization, a Stream object is created
      * by forwarding any passed in arguments to its constructor.
-     * If SSL ends up being used for this connection, a
-     * [asioreflink ssl__context ssl::context] object will be created
-     * on-demmand, with the minimum configuration settings to make SSL work.
-     * In particular, no certificate validation will be performed. If you need
-     * more flexibility, have a look at the other constructor overloads.
+     * If SSL ends up being used for this connection, a library-managed
+     * [asioreflink ssl__context ssl::context] object, shared among all connections
+     * constructed this way, will be used. It has the minimum configuration settings
+     * to make SSL work. In particular, no certificate validation will be performed.
+     * TLS sessions are cached by server endpoint, and resumed by later connections
+     * established using [refmem socket_connection connect] to the same endpoint.
+     * If you need more flexibility, have a look at the other constructor overloads.
      * 
      * The constructed connection will have [refmem connection valid]
      * return `true`.
@@ -171,6 +177,69 @@ public:
      */
     bool uses_ssl() const noexcept { return get_channel().ssl_active(); }
 
+    /**
+     * \brief Returns the server-side ID of this connection.
+     * \details This is the value returned by `CONNECTION_ID()`, and the one
+     * `KILL` statements expect. It's sent by the server during the handshake,
+     * so this function returns zero for connections that haven't been established yet.
+     */
+    std::uint32_t connection_id() const noexcept { return get_channel().connection_id(); }
+
+    /**
+     * \brief Returns the options required to compose SQL for this connection with [reflink format_sql].
+     * \details The collation is the one passed to [refmem connection handshake] or
+     * [refmem connection change_user]. Whether backslashes are escape characters is
+     * reported by the server during the handshake and after each statement that doesn't
+     * return rows, like `SET sql_mode = 'NO_BACKSLASH_ESCAPES'`. Changing the character
+     * set using SQL (e.g. `SET NAMES`) is not tracked: use a [reflink format_options]
+     * object reflecting the new character set, instead.
+     */
+    format_options format_opts() const noexcept
+    {
+        return format_options(get_channel().connection_collation(), get_channel().backslash_escapes());
+    }
+
+    /**
+     * \brief Sets the handler providing data for `LOAD DATA LOCAL INFILE` statements.
+     * \details `LOAD DATA LOCAL INFILE` is disabled by default. Installing a
+     * [reflink local_infile_handler] enables it, making the client advertise support
+     * for it during the handshake. Thus, the handler must be set __before__ calling
+     * [refmem connection handshake] or [refmem socket_connection connect]. If the
+     * server requests a local file and no handler is set, the operation fails
+     * with [link mysql.ref.boost__mysql__errc `errc::local_infile_disabled`].
+     *
+     * Passing an empty handler disables the feature for subsequent handshakes.
+     */
+    void set_local_infile_handler(local_infile_handler handler)
+    {
+        get_channel().set_local_infile_handler(std::move(handler));
+    }
+
+    /// Returns the handler set by [refmem connection set_local_infile_handler], if any.
+    const local_infile_handler& get_local_infile_handler() const noexcept
+    {
+        return get_channel().get_local_infile_handler();
+    }
+
+    /**
+     * \brief Enables or disables deferred statement closing.
+     * \details When enabled, [refmem prepared_statement close] and
+     * [refmem prepared_statement async_close] don't perform any network transfer.
+     * The close request is queued instead, and written together with the request
+     * for the next operation involving the server, saving a write per closed statement.
+     * Use [refmem connection flush_deferred_closes] to write queued requests
+     * without starting any other operation (e.g. before leaving a connection idle).
+     *
+     * Queued requests are discarded on handshake. Disabled by default.
+     */
+    void set_deferred_close(bool value) noexcept { get_channel().set_deferred_close(value); }
+
+    /// Returns whether deferred statement closing is enabled.
+    bool deferred_close() const noexcept { return get_channel().deferred_close(); }
+
+    /// Returns whether there are statement close requests waiting to be written.
+    bool has_deferred_closes() const noexcept { return get_channel().has_pending_writes(); }
+
     /**
      * \brief Performs the MySQL-level handshake (sync with error code version).
      * \details Does not connect the underlying stream. 
@@ -243,6 +312,69 @@ public:
         CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
     );
 
+    /**
+     * \brief Authenticates as a different user over this connection (sync with error code version).
+     * \details Issues a `COM_CHANGE_USER` command, authenticating with the username, password,
+     * database and collation in `params`, as if a new connection had been established,
+     * but reusing the underlying stream (and its TLS session, if any). The SSL mode
+     * in `params` is ignored. The connection must have completed a handshake.
+     *
+     * The server resets the session: prepared statements are deallocated,
+     * and session variables, temporary tables and user variables are cleared.
+     * If authentication fails, the server closes the connection.
+     */
+    void change_user(const connection_params& params, error_code& ec, error_info& info);
+
+    /**
+     * \brief Authenticates as a different user over this connection (sync with exceptions version).
+     * \details See [refmem connection change_user] for more info.
+     */
+    void change_user(const connection_params& params);
+
+    /**
+     * \brief Authenticates as a different user over this connection
+     *        (async without [reflink error_info] version).
+     * \details See [refmem connection change_user] for more info.
+     * The strings pointed to by params should be kept alive by the caller
+     * until the operation completes, as no copy is made by the library.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_change_user(
+        const connection_params& params,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        return async_change_user(params, shared_info(), std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Authenticates as a different user over this connection
+     *        (async with [reflink error_info] version).
+     * \details See [refmem connection change_user] for more info.
+     * The strings pointed to by params should be kept alive by the caller
+     * until the operation completes, as no copy is made by the library.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_change_user(
+        const connection_params& params,
+        error_info& output_info,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    );
+
     /**
      * \brief Executes a SQL text query (sync with error code version).
      * \details See [link mysql.queries this section] for more info.
@@ -311,6 +443,162 @@ public:
         CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
     );
 
+    /**
+     * \brief Inserts a sequence of rows using multi-row `INSERT` statements
+     *        (sync with error code version).
+     * \details See [link mysql.queries.bulk_insert this section] for more info.
+     * Rows are escaped and serialized as SQL literals, and grouped in as few statements
+     * as possible, each one no larger than [refmem bulk_insert_params max_statement_size].
+     * Statements are executed in order, as text queries.
+     * The statement prefix must produce no rows (e.g. an `INSERT` or `REPLACE`).
+     *
+     * Returns the total number of affected rows. If an error occurs, the rows
+     * inserted by previous statements are not rolled back: use a transaction if you
+     * need this behavior.
+     */
+    template <class RowForwardIterator>
+    std::uint64_t bulk_insert(const bulk_insert_params<RowForwardIterator>& params, error_code&, error_info&);
+
+    /**
+     * \brief Inserts a sequence of rows using multi-row `INSERT` statements
+     *        (sync with exceptions version).
+     * \details See [link mysql.queries.bulk_insert this section] for more info.
+     */
+    template <class RowForwardIterator>
+    std::uint64_t bulk_insert(const bulk_insert_params<RowForwardIterator>& params);
+
+    /**
+     * \brief Inserts a sequence of rows using multi-row `INSERT` statements
+     *        (async without [reflink error_info] version).
+     * \details See [link mysql.queries.bulk_insert this section] for more info.
+     * The statement prefix and the rows should be kept alive by the caller
+     * until the operation completes, as no copy is made by the library.
+     *
+     * The handler signature for this operation is
+     * `void(boost::mysql::error_code, std::uint64_t)`.
+     */
+    template <
+        class RowForwardIterator,
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, std::uint64_t))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::uint64_t))
+    async_bulk_insert(
+        const bulk_insert_params<RowForwardIterator>& params,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        return async_bulk_insert(params, shared_info(), std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Inserts a sequence of rows using multi-row `INSERT` statements
+     *        (async with [reflink error_info] version).
+     * \details See [link mysql.queries.bulk_insert this section] for more info.
+     * The statement prefix and the rows should be kept alive by the caller
+     * until the operation completes, as no copy is made by the library.
+     *
+     * The handler signature for this operation is
+     * `void(boost::mysql::error_code, std::uint64_t)`.
+     */
+    template <
+        class RowForwardIterator,
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, std::uint64_t))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::uint64_t))
+    async_bulk_insert(
+        const bulk_insert_params<RowForwardIterator>& params,
+        error_info& output_info,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    );
+
+    /**
+     * \brief Prepares, executes and closes a statement, minimizing round-trips
+     *        (sync with error code version).
+     * \details See [link mysql.prepared_statements.execute_once this section] for more info.
+     * Equivalent to preparing `statement`, executing it once with `params` and
+     * closing it, but all requests are written back to back. This takes a single
+     * round-trip on MariaDB 10.2 and later, and two on MySQL.
+     * ValueCollection should meet the [reflink ValueCollection] requirements.
+     *
+     * The returned resultset uses the binary protocol. You should read it entirely
+     * before calling any function that involves communication with the server over this
+     * connection. Otherwise, the results are undefined.
+     */
+    template <class ValueCollection, class EnableIf = detail::enable_if_value_collection<ValueCollection>>
+    resultset<Stream> execute_once(
+        boost::string_view statement,
+        const ValueCollection& params,
+        error_code&,
+        error_info&
+    );
+
+    /**
+     * \brief Prepares, executes and closes a statement, minimizing round-trips
+     *        (sync with exceptions version).
+     * \details See [refmem connection execute_once] for more info.
+     */
+    template <class ValueCollection, class EnableIf = detail::enable_if_value_collection<ValueCollection>>
+    resultset<Stream> execute_once(
+        boost::string_view statement,
+        const ValueCollection& params
+    );
+
+    /**
+     * \brief Prepares, executes and closes a statement, minimizing round-trips
+     *        (async without [reflink error_info] version).
+     * \details See [refmem connection execute_once] for more info.
+     * It is __not__ necessary to keep the statement, the collection of parameters or the
+     * values they may point to alive after the initiating function returns.
+     *
+     * The handler signature for this operation is
+     * `void(boost::mysql::error_code, boost::mysql::resultset<Stream>)`.
+     */
+    template <
+        class ValueCollection,
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, resultset<Stream>))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type),
+        class EnableIf = detail::enable_if_value_collection<ValueCollection>
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, resultset<Stream>))
+    async_execute_once(
+        boost::string_view statement,
+        const ValueCollection& params,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        return async_execute_once(statement, params, shared_info(), std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Prepares, executes and closes a statement, minimizing round-trips
+     *        (async with [reflink error_info] version).
+     * \details See [refmem connection execute_once] for more info.
+     * It is __not__ necessary to keep the statement, the collection of parameters or the
+     * values they may point to alive after the initiating function returns.
+     *
+     * The handler signature for this operation is
+     * `void(boost::mysql::error_code, boost::mysql::resultset<Stream>)`.
+     */
+    template <
+        class ValueCollection,
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, resultset<Stream>))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type),
+        class EnableIf = detail::enable_if_value_collection<ValueCollection>
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, resultset<Stream>))
+    async_execute_once(
+        boost::string_view statement,
+        const ValueCollection& params,
+        error_info& output_info,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    );
+
     /**
      * \brief Prepares a statement (sync with error code version).
      * \details See [link mysql.prepared_statements this section] for more info.
@@ -371,6 +659,58 @@ public:
         CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
     );
 
+    /**
+     * \brief Writes any queued statement close requests (sync with error code version).
+     * \details See [refmem connection set_deferred_close] for more info.
+     * Does nothing if there are no queued requests.
+     */
+    void flush_deferred_closes(error_code&, error_info&);
+
+    /**
+     * \brief Writes any queued statement close requests (sync with exceptions version).
+     * \details See [refmem connection set_deferred_close] for more info.
+     * Does nothing if there are no queued requests.
+     */
+    void flush_deferred_closes();
+
+    /**
+     * \brief Writes any queued statement close requests
+     * (async without [reflink error_info] version).
+     * \details See [refmem connection set_deferred_close] for more info.
+     * Does nothing if there are no queued requests.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_flush_deferred_closes(CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    {
+        return async_flush_deferred_closes(shared_info(), std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Writes any queued statement close requests
+     * (async with [reflink error_info] version).
+     * \details See [refmem connection set_deferred_close] for more info.
+     * Does nothing if there are no queued requests.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_flush_deferred_closes(
+        error_info& output_info,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    );
+
     /**
      * \brief Notifies the MySQL server that the client wants to end the session
      * (sync with error code version).
@@ -10,6 +10,7 @@
 
 #include <boost/utility/string_view.hpp>
 #include <boost/mysql/collation.hpp>
+#include <boost/mysql/password_hashes.hpp>
 
 namespace boost {
 namespace mysql {
@@ -49,6 +50,9 @@ class connection_params
     boost::string_view database_;
     collation connection_collation_;
     ssl_mode ssl_;
+    boost::string_view server_public_key_;
+    bool request_server_public_key_ {false};
+    const boost::mysql::password_hashes* password_hashes_ {nullptr};
 public:
     /**
      * \brief Initializing constructor
@@ -103,6 +107,51 @@ public:
 
     /// Sets SSL mode
     void set_ssl(ssl_mode value) noexcept { ssl_ = value; }
+
+    /// Retrieves the server RSA public key.
+    boost::string_view server_public_key() const noexcept { return server_public_key_; }
+
+    /**
+     * \brief Sets the server RSA public key, in PEM format.
+     * \details Used by `caching_sha2_password` to encrypt the password when
+     * the server requires it in full, but the connection doesn't use TLS.
+     * This is the secure way of authenticating without TLS: the key should be
+     * obtained from a trusted source (e.g. the server's `public_key.pem` file).
+     * The pointed string is not copied.
+     */
+    void set_server_public_key(boost::string_view value) noexcept { server_public_key_ = value; }
+
+    /// Retrieves whether the server RSA public key may be requested to the server.
+    bool request_server_public_key() const noexcept { return request_server_public_key_; }
+
+    /**
+     * \brief Sets whether the server RSA public key may be requested to the server.
+     * \details Defaults to `false`. Only used by `caching_sha2_password` when full
+     * authentication is required, the connection doesn't use TLS and no key was set by
+     * [refmem connection_params set_server_public_key]. If enabled, the key is
+     * requested to the server over the unencrypted connection and cached for later
+     * connections to the same endpoint. If disabled, such handshakes fail with
+     * [refmem errc auth_plugin_requires_ssl].
+     *
+     * \warning The requested key is not authenticated. An attacker able to
+     * tamper with the connection can supply its own key and obtain the password.
+     * Only enable this in trusted networks. This is equivalent to libmysqlclient's
+     * `MYSQL_OPT_GET_SERVER_PUBLIC_KEY`.
+     */
+    void set_request_server_public_key(bool value) noexcept { request_server_public_key_ = value; }
+
+    /// Retrieves the precomputed password hashes, or `nullptr` if not set.
+    const boost::mysql::password_hashes* password_hashes() const noexcept { return password_hashes_; }
+
+    /**
+     * \brief Sets precomputed password hashes, to be used instead of [refmem connection_params password].
+     * \details The pointed object is not copied, and must be kept alive while it's
+     * used by handshakes. It can be shared between connections. The cleartext password
+     * can then be left empty, unless `caching_sha2_password` may need to perform full
+     * authentication (i.e. the server cache doesn't contain the user). Pass `nullptr`
+     * to use the cleartext password again.
+     */
+    void set_password_hashes(const boost::mysql::password_hashes* value) noexcept { password_hashes_ = value; }
 };
 
 } // mysql
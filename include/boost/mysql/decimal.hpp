@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DECIMAL_HPP
+#define BOOST_MYSQL_DECIMAL_HPP
+
+#include <boost/mysql/value.hpp>
+#include <boost/mysql/metadata.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/utility/string_view.hpp>
+#include <boost/config.hpp>
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief A fixed-point decimal number, as stored by `__DECIMAL__` columns.
+ *        See [link mysql.values.decimal this section] for more info.
+ * \details Represented as a 128-bit unscaled integer plus a scale (number of
+ * fractional digits). The represented number is `unscaled / 10^scale`.
+ * Decimals support up to [refmem decimal max_precision] significant digits.
+ *
+ * MySQL transmits `__DECIMAL__` values as strings in both the text and the binary protocol,
+ * so [reflink value]s retrieved from these columns hold `boost::string_view`s.
+ * Use [reflink get_decimal] or [reflink parse_decimal] to obtain a [reflink decimal]
+ * from them, and [refmem decimal to_chars] to serialize a decimal for a statement parameter.
+ *
+ * This is a lightweight, cheap-to-copy class.
+ */
+class decimal
+{
+public:
+    /// The maximum number of significant digits a decimal may have.
+    static constexpr unsigned max_precision = 38;
+
+    /// The maximum scale (number of fractional digits) a decimal may have.
+    static constexpr unsigned max_scale = max_precision;
+
+    /// The maximum number of characters [refmem decimal to_chars] may write.
+    static constexpr std::size_t max_string_size = max_precision + 3; // sign, leading zero, period
+
+    /// Constructs a decimal representing zero, with a scale of zero.
+    decimal() = default;
+
+    /**
+     * \brief Constructs a decimal from an unscaled value and a scale.
+     * \details The constructed object represents `unscaled_value / 10^scale`.
+     * `scale` must not be greater than [refmem decimal max_scale].
+     */
+    decimal(std::int64_t unscaled_value, unsigned scale) noexcept;
+
+    /// Returns the scale of the decimal (number of fractional digits).
+    unsigned scale() const noexcept { return scale_; }
+
+    /// Returns `true` if the decimal is less than zero.
+    bool is_negative() const noexcept { return negative_; }
+
+    /// Returns `true` if the decimal is zero.
+    bool is_zero() const noexcept;
+
+    /**
+     * \brief Returns the unscaled value as a `std::int64_t`, if it fits.
+     * \details Returns an empty optional if the unscaled value
+     * can't be represented as a `std::int64_t`.
+     */
+    boost::optional<std::int64_t> unscaled_value() const noexcept;
+
+#if defined(BOOST_HAS_INT128) || defined(BOOST_MYSQL_DOXYGEN)
+    /**
+     * \brief Returns the unscaled value as a 128-bit integer.
+     * \details Only available in compilers supporting 128-bit integers.
+     */
+    boost::int128_type unscaled_value_int128() const noexcept;
+#endif
+
+    /**
+     * \brief Changes the scale of the decimal, preserving the represented number.
+     * \details Returns `false` and leaves `*this` unmodified if the number can't be
+     * represented with the new scale without losing precision (i.e. when decreasing
+     * the scale would drop non-zero digits, or when increasing it would exceed
+     * [refmem decimal max_precision] digits).
+     */
+    bool rescale(unsigned new_scale) noexcept;
+
+    /**
+     * \brief Converts the decimal to the closest `double`.
+     * \details The conversion may incur a rounding error.
+     */
+    double to_double() const noexcept;
+
+    /**
+     * \brief Writes the decimal's textual representation into `output`.
+     * \details `output` must point to a buffer of at least [refmem decimal max_string_size]
+     * characters. No null terminator is written. Returns the number of characters written.
+     * The representation uses exactly [refmem decimal scale] fractional digits
+     * (e.g. `"-12.50"`), and is suitable to be sent to the server as a statement parameter.
+     */
+    std::size_t to_chars(char* output) const noexcept;
+
+    /// Returns the decimal's textual representation, as written by [refmem decimal to_chars].
+    std::string to_string() const;
+
+#ifndef BOOST_MYSQL_DOXYGEN
+    // Private, do not use
+    using magnitude_type = std::array<std::uint32_t, 4>; // little endian
+    decimal(const magnitude_type& magnitude, bool negative, unsigned scale) noexcept:
+        magnitude_(magnitude), negative_(negative), scale_(static_cast<std::uint8_t>(scale))
+    {
+        if (is_zero())
+            negative_ = false;
+    }
+    const magnitude_type& magnitude() const noexcept { return magnitude_; }
+#endif
+
+private:
+    magnitude_type magnitude_ {{}};
+    bool negative_ {false};
+    std::uint8_t scale_ {0};
+};
+
+/**
+ * \relates decimal
+ * \brief Tests for equality.
+ * \details Decimals compare equal if they represent the same number, regardless of their scale
+ * (e.g. `1.5` and `1.50` compare equal).
+ */
+inline bool operator==(const decimal& lhs, const decimal& rhs) noexcept;
+
+/// \relates decimal
+/// \brief Tests for inequality.
+inline bool operator!=(const decimal& lhs, const decimal& rhs) noexcept { return !(lhs == rhs); }
+
+/// \relates decimal
+/// \brief Compares the represented numbers, regardless of their scale.
+inline bool operator<(const decimal& lhs, const decimal& rhs) noexcept;
+
+/// \relates decimal
+/// \brief Compares the represented numbers, regardless of their scale.
+inline bool operator<=(const decimal& lhs, const decimal& rhs) noexcept { return !(rhs < lhs); }
+
+/// \relates decimal
+/// \brief Compares the represented numbers, regardless of their scale.
+inline bool operator>(const decimal& lhs, const decimal& rhs) noexcept { return rhs < lhs; }
+
+/// \relates decimal
+/// \brief Compares the represented numbers, regardless of their scale.
+inline bool operator>=(const decimal& lhs, const decimal& rhs) noexcept { return !(lhs < rhs); }
+
+/**
+ * \relates decimal
+ * \brief Streams a decimal, using the representation produced by [refmem decimal to_chars].
+ */
+inline std::ostream& operator<<(std::ostream& os, const decimal& v);
+
+/**
+ * \relates decimal
+ * \brief Parses a decimal from its textual representation.
+ * \details Accepts strings like `"-12.50"`, the format MySQL uses to transmit
+ * `__DECIMAL__` values. The scale of the result is the number of fractional digits
+ * in `from`. Returns an empty optional if `from` is not a valid decimal or has
+ * more than [refmem decimal max_precision] significant digits.
+ */
+inline boost::optional<decimal> parse_decimal(boost::string_view from) noexcept;
+
+/**
+ * \relates decimal
+ * \brief Parses a decimal from its textual representation, with a fixed scale.
+ * \details Like the single-argument overload, but the result will always have
+ * the given scale. Returns an empty optional if `from` can't be represented
+ * with that scale without losing precision.
+ */
+inline boost::optional<decimal> parse_decimal(boost::string_view from, unsigned scale) noexcept;
+
+/**
+ * \relates decimal
+ * \brief Retrieves a [reflink value] read from a `__DECIMAL__` field as a [reflink decimal].
+ * \details The result's scale will match the field's [refmem field_metadata decimals].
+ * Returns an empty optional if the value is NULL, is not a valid decimal or
+ * can't be represented with the field's scale.
+ * Integer values are also accepted.
+ */
+inline boost::optional<decimal> get_decimal(const value& v, const field_metadata& meta) noexcept;
+
+} // mysql
+} // boost
+
+#include <boost/mysql/impl/decimal.ipp>
+
+#endif
@@ -9,6 +9,7 @@
 #define BOOST_MYSQL_DETAIL_AUTH_AUTH_CALCULATOR_HPP
 
 #include <boost/mysql/error.hpp>
+#include <boost/mysql/password_hashes.hpp>
 #include <boost/mysql/detail/auxiliar/bytestring.hpp>
 #include <array>
 #include <vector>
@@ -22,6 +23,7 @@ struct authentication_plugin
 {
     using calculator_signature = error_code (*)(
         boost::string_view password,
+        const password_hashes* hashes, // may be nullptr
         boost::string_view challenge,
         bool use_ssl,
         bytestring& output
@@ -42,7 +44,8 @@ public:
         boost::string_view plugin_name,
         boost::string_view password,
         boost::string_view challenge,
-        bool use_ssl
+        bool use_ssl,
+        const password_hashes* hashes = nullptr
     );
     boost::string_view response() const noexcept
     {
@@ -11,6 +11,8 @@
 #include <cstddef>
 #include <boost/utility/string_view.hpp>
 #include <boost/mysql/error.hpp>
+#include <boost/mysql/password_hashes.hpp>
+#include <boost/mysql/detail/auxiliar/bytestring.hpp>
 
 namespace boost {
 namespace mysql {
@@ -23,16 +25,28 @@ namespace caching_sha2_password {
 // the password hashed with the challenge. The server may send a challenge
 // equals to perform_full_auth, meaning it could not use the cache to
 // complete the auth. In this case, we should just send the cleartext password.
-// Doing the latter requires a SSL connection. It is possible to perform full
-// auth without an SSL connection, but that requires the server public key,
-// and we do not implement that.
+// Doing the latter requires a SSL connection. Performing full auth without
+// an SSL connection requires the server RSA public key (see compute_rsa_response),
+// and is handled by the handshake algorithm. If hashes is not null, it's used
+// instead of password for challenge/response. password is still required for full auth.
 inline error_code compute_response(
     boost::string_view password,
+    const password_hashes* hashes,
     boost::string_view challenge,
     bool use_ssl,
     bytestring& output
 );
 
+// Full auth over a non-SSL connection: the NULL-terminated password, XOR'ed with
+// the scramble (the challenge sent by the server when the plugin was selected),
+// encrypted using the server RSA public key (PEM) with OAEP padding.
+inline error_code compute_rsa_response(
+    boost::string_view password,
+    boost::string_view scramble,
+    boost::string_view public_key,
+    bytestring& output
+);
+
 } // caching_sha2_password
 } // detail
 } // mysql
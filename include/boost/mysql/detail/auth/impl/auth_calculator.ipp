@@ -53,7 +53,8 @@ boost::mysql::detail::auth_calculator::calculate(
     boost::string_view plugin_name,
     boost::string_view password,
     boost::string_view challenge,
-    bool use_ssl
+    bool use_ssl,
+    const password_hashes* hashes
 )
 {
 
@@ -61,14 +62,14 @@ boost::mysql::detail::auth_calculator::calculate(
     if (plugin_)
     {
         // Blank password: we should just return an empty auth string
-        if (password.empty())
+        if (hashes ? hashes->empty() : password.empty())
         {
             response_.clear();
             return error_code();
         }
         else
         {
-            return plugin_->calculator(password, challenge, use_ssl, response_);
+            return plugin_->calculator(password, hashes, challenge, use_ssl, response_);
         }
     }
     else
@@ -9,7 +9,12 @@
 #define BOOST_MYSQL_DETAIL_AUTH_IMPL_CACHING_SHA2_PASSWORD_IPP
 
 #include <openssl/sha.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#include <openssl/err.h>
 #include <cstring>
+#include <memory>
 #include <boost/mysql/detail/auxiliar/make_string_view.hpp>
 
 namespace boost {
@@ -20,11 +25,36 @@ namespace caching_sha2_password {
 constexpr std::size_t challenge_length = 20;
 constexpr std::size_t response_length = 32;
 constexpr boost::string_view perform_full_auth = make_string_view("\4");
+constexpr std::uint8_t request_public_key = 2;
+
+struct bio_deleter
+{
+    void operator()(BIO* p) const noexcept { BIO_free(p); }
+};
+
+struct evp_pkey_deleter
+{
+    void operator()(EVP_PKEY* p) const noexcept { EVP_PKEY_free(p); }
+};
+
+struct evp_pkey_ctx_deleter
+{
+    void operator()(EVP_PKEY_CTX* p) const noexcept { EVP_PKEY_CTX_free(p); }
+};
+
+inline error_code rsa_error()
+{
+    // Don't leave errors in the OpenSSL error queue, as other OpenSSL users may get confused
+    ERR_clear_error();
+    return make_error_code(errc::invalid_public_key);
+}
 
 // challenge must point to challenge_length bytes of data
 // output must point to response_length bytes of data
+// The parts only depending on the password are passed in, as they may be precomputed
 inline void compute_auth_string(
-    boost::string_view password,
+    const password_hashes::sha256_type& password_sha,
+    const password_hashes::sha256_type& password_double_sha,
     const void* challenge,
     void* output
 )
@@ -32,14 +62,10 @@ inline void compute_auth_string(
     static_assert(response_length == SHA256_DIGEST_LENGTH, "Buffer size mismatch");
 
     // SHA(SHA(password_sha) concat challenge) XOR password_sha
-    // hash1 = SHA(pass)
-    using sha_buffer = std::uint8_t [response_length];
-    sha_buffer password_sha;
-    SHA256(reinterpret_cast<const unsigned char*>(password.data()), password.size(), password_sha);
-
     // SHA(password_sha) concat challenge = buffer
+    using sha_buffer = std::uint8_t [response_length];
     std::uint8_t buffer [response_length + challenge_length];
-    SHA256(password_sha, response_length, buffer);
+    std::memcpy(buffer, password_double_sha.data(), response_length);
     std::memcpy(buffer + response_length, challenge, challenge_length);
 
     // SHA(SHA(password_sha) concat challenge) = SHA(buffer) = salted_password
@@ -63,6 +89,7 @@ inline void compute_auth_string(
 inline boost::mysql::error_code
 boost::mysql::detail::caching_sha2_password::compute_response(
     boost::string_view password,
+    const password_hashes* hashes,
     boost::string_view challenge,
     bool use_ssl,
     bytestring& output
@@ -74,6 +101,11 @@ boost::mysql::detail::caching_sha2_password::compute_response(
         {
             return make_error_code(errc::auth_plugin_requires_ssl);
         }
+        if (password.empty())
+        {
+            // Only hashes were provided
+            return make_error_code(errc::cleartext_password_unavailable);
+        }
         output.assign(password.begin(), password.end());
         output.push_back(0);
         return error_code();
@@ -86,16 +118,72 @@ boost::mysql::detail::caching_sha2_password::compute_response(
             return make_error_code(errc::protocol_value_error);
         }
 
-        // Do the calculation
+        // Do the calculation, hashing the password if not done yet
         output.resize(response_length);
-        compute_auth_string(
-            password,
-            challenge.data(),
-            output.data()
-        );
+        if (hashes)
+        {
+            compute_auth_string(hashes->sha256(), hashes->double_sha256(), challenge.data(), output.data());
+        }
+        else
+        {
+            password_hashes::sha256_type password_sha, password_double_sha;
+            SHA256(reinterpret_cast<const unsigned char*>(password.data()), password.size(), password_sha.data());
+            SHA256(password_sha.data(), password_sha.size(), password_double_sha.data());
+            compute_auth_string(password_sha, password_double_sha, challenge.data(), output.data());
+        }
         return error_code();
     }
 }
 
 
+inline boost::mysql::error_code
+boost::mysql::detail::caching_sha2_password::compute_rsa_response(
+    boost::string_view password,
+    boost::string_view scramble,
+    boost::string_view public_key,
+    bytestring& output
+)
+{
+    if (scramble.empty())
+    {
+        return make_error_code(errc::protocol_value_error);
+    }
+
+    // NULL-terminated password XOR scramble
+    bytestring buffer (password.begin(), password.end());
+    buffer.push_back(0);
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+    {
+        buffer[i] ^= static_cast<std::uint8_t>(scramble[i % scramble.size()]);
+    }
+
+    // Load the key
+    std::unique_ptr<BIO, bio_deleter> bio (BIO_new_mem_buf(
+        public_key.data(),
+        static_cast<int>(public_key.size())
+    ));
+    if (!bio)
+        return rsa_error();
+    std::unique_ptr<EVP_PKEY, evp_pkey_deleter> key (
+        PEM_read_bio_PUBKEY(bio.get(), nullptr, nullptr, nullptr));
+    if (!key)
+        return rsa_error();
+
+    // Encrypt. Fails if the password is too long for the key size
+    std::unique_ptr<EVP_PKEY_CTX, evp_pkey_ctx_deleter> ctx (EVP_PKEY_CTX_new(key.get(), nullptr));
+    std::size_t size = 0;
+    if (!ctx ||
+        EVP_PKEY_encrypt_init(ctx.get()) <= 0 ||
+        EVP_PKEY_CTX_set_rsa_padding(ctx.get(), RSA_PKCS1_OAEP_PADDING) <= 0 ||
+        EVP_PKEY_encrypt(ctx.get(), nullptr, &size, buffer.data(), buffer.size()) <= 0)
+    {
+        return rsa_error();
+    }
+    output.resize(size);
+    if (EVP_PKEY_encrypt(ctx.get(), output.data(), &size, buffer.data(), buffer.size()) <= 0)
+        return rsa_error();
+    output.resize(size);
+    return error_code();
+}
+
 #endif /* INCLUDE_BOOST_MYSQL_DETAIL_AUTH_IMPL_CACHING_SHA2_PASSWORD_IPP_ */
@@ -22,21 +22,19 @@ constexpr std::size_t response_length = 20;
 // challenge must point to challenge_length bytes of data
 // output must point to response_length bytes of data
 // SHA1( password ) XOR SHA1( "20-bytes random data from server" <concat> SHA1( SHA1( password ) ) )
+// The parts only depending on the password are passed in, as they may be precomputed
 inline void compute_auth_string(
-    boost::string_view password,
+    const password_hashes::sha1_type& password_sha1,
+    const password_hashes::sha1_type& password_double_sha1,
     const void* challenge,
     void* output
 )
 {
-    // SHA1 (password)
-    using sha1_buffer = unsigned char [SHA_DIGEST_LENGTH];
-    sha1_buffer password_sha1;
-    SHA1(reinterpret_cast<const unsigned char*>(password.data()), password.size(), password_sha1);
-
     // Add server challenge (salt)
+    using sha1_buffer = unsigned char [SHA_DIGEST_LENGTH];
     unsigned char salted_buffer [challenge_length + SHA_DIGEST_LENGTH];
     memcpy(salted_buffer, challenge, challenge_length);
-    SHA1(password_sha1, sizeof(password_sha1), salted_buffer + 20);
+    memcpy(salted_buffer + challenge_length, password_double_sha1.data(), SHA_DIGEST_LENGTH);
     sha1_buffer salted_sha1;
     SHA1(salted_buffer, sizeof(salted_buffer), salted_sha1);
 
@@ -57,6 +55,7 @@ inline void compute_auth_string(
 inline boost::mysql::error_code
 boost::mysql::detail::mysql_native_password::compute_response(
     boost::string_view password,
+    const password_hashes* hashes,
     boost::string_view challenge,
     bool, // use_ssl
     bytestring& output
@@ -68,13 +67,19 @@ boost::mysql::detail::mysql_native_password::compute_response(
         return make_error_code(errc::protocol_value_error);
     }
 
-    // Do the calculation
+    // Do the calculation, hashing the password if not done yet
     output.resize(response_length);
-    compute_auth_string(
-        password,
-        challenge.data(),
-        output.data()
-    );
+    if (hashes)
+    {
+        compute_auth_string(hashes->sha1(), hashes->double_sha1(), challenge.data(), output.data());
+    }
+    else
+    {
+        password_hashes::sha1_type password_sha1, password_double_sha1;
+        SHA1(reinterpret_cast<const unsigned char*>(password.data()), password.size(), password_sha1.data());
+        SHA1(password_sha1.data(), password_sha1.size(), password_double_sha1.data());
+        compute_auth_string(password_sha1, password_double_sha1, challenge.data(), output.data());
+    }
     return error_code();
 }
 
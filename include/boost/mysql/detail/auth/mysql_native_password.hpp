@@ -11,6 +11,8 @@
 #include <cstdint>
 #include <boost/utility/string_view.hpp>
 #include <boost/mysql/error.hpp>
+#include <boost/mysql/password_hashes.hpp>
+#include <boost/mysql/detail/auxiliar/bytestring.hpp>
 
 namespace boost {
 namespace mysql {
@@ -18,9 +20,10 @@ namespace detail {
 namespace mysql_native_password {
 
 // Authorization for this plugin is always challenge (nonce) -> response
-// (hashed password).
+// (hashed password). If hashes is not null, it's used instead of password.
 inline error_code compute_response(
     boost::string_view password,
+    const password_hashes* hashes,
     boost::string_view challenge,
     bool use_ssl,
     bytestring& output
@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_AUTH_SERVER_PUBLIC_KEY_CACHE_HPP
+#define BOOST_MYSQL_DETAIL_AUTH_SERVER_PUBLIC_KEY_CACHE_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// RSA public keys (PEM) fetched from servers, keyed by server endpoint,
+// so only the first connection to each server needs to request it. Thread-safe
+class server_public_key_cache
+{
+    std::mutex mtx_;
+    std::unordered_map<std::string, std::string> keys_;
+public:
+    static server_public_key_cache& instance()
+    {
+        static server_public_key_cache res;
+        return res;
+    }
+
+    // Returns whether there was a key for endpoint
+    bool get(boost::string_view endpoint, std::string& output)
+    {
+        std::lock_guard<std::mutex> guard (mtx_);
+        auto it = keys_.find(endpoint.to_string());
+        if (it == keys_.end())
+            return false;
+        output = it->second;
+        return true;
+    }
+
+    void put(boost::string_view endpoint, boost::string_view key)
+    {
+        std::lock_guard<std::mutex> guard (mtx_);
+        keys_[endpoint.to_string()] = key.to_string();
+    }
+
+    void erase(boost::string_view endpoint)
+    {
+        std::lock_guard<std::mutex> guard (mtx_);
+        keys_.erase(endpoint.to_string());
+    }
+};
+
+} // detail
+} // mysql
+} // boost
+
+#endif
@@ -0,0 +1,51 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_AUXILIAR_CANCELLATION_HPP
+#define BOOST_MYSQL_DETAIL_AUXILIAR_CANCELLATION_HPP
+
+#include <boost/mysql/error.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/version.hpp>
+
+// Per-operation cancellation was introduced in Asio 1.19 (Boost 1.77)
+#if BOOST_ASIO_VERSION >= 101900
+#define BOOST_MYSQL_HAS_CANCELLATION_SLOTS
+#include <boost/asio/cancellation_type.hpp>
+#endif
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Composed operations (async_compose) propagate terminal cancellation to
+// the I/O they initiate. Cancellation requested between two steps, when no
+// I/O is outstanding, is only recorded in the operation's cancellation state,
+// so it must be checked after each step. If err is empty and cancellation
+// was requested, sets err to operation_aborted.
+// Ops call this at the start of every invocation. On the first one, it has
+// no effect, as cancellation can't have been requested yet.
+// async_compose's default filter only lets terminal cancellation through:
+// partial and total cancellation are not supported, as an interrupted
+// operation leaves the connection in an unspecified state.
+template <class Self>
+void check_cancellation(Self& self, error_code& err) noexcept
+{
+#ifdef BOOST_MYSQL_HAS_CANCELLATION_SLOTS
+    if (!err && self.get_cancellation_state().cancelled() != boost::asio::cancellation_type::none)
+        err = boost::asio::error::operation_aborted;
+#else
+    (void)self;
+    (void)err;
+#endif
+}
+
+} // detail
+} // mysql
+} // boost
+
+#endif
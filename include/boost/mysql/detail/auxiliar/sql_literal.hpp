@@ -0,0 +1,339 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_AUXILIAR_SQL_LITERAL_HPP
+#define BOOST_MYSQL_DETAIL_AUXILIAR_SQL_LITERAL_HPP
+
+#include <boost/mysql/value.hpp>
+#include <boost/mysql/errc.hpp>
+#include <boost/mysql/format_options.hpp>
+#include <boost/mysql/detail/auxiliar/bytestring.hpp>
+#include <boost/mysql/detail/auxiliar/value_type_traits.hpp>
+#include <boost/mysql/detail/protocol/date.hpp>
+#include <boost/mp11/tuple.hpp>
+#include <boost/variant2/variant.hpp>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Serializes values as SQL literals, appending them to a buffer, which may be
+// a bytestring or a std::string.
+// Strings are quoted and escaped the way the server will parse them, which depends
+// on whether the NO_BACKSLASH_ESCAPES SQL mode is active. Escaping works byte by byte,
+// which is only safe for character sets where a multi-byte character can't contain
+// bytes like 0x5c or 0x27. Character sets that don't meet this (e.g. GBK or SJIS)
+// are rejected.
+
+// Whether strings can be escaped safely when the connection uses the given collation
+inline bool is_sql_escape_safe(collation value) noexcept
+{
+    switch (value)
+    {
+    case collation::big5_chinese_ci:
+    case collation::big5_bin:
+    case collation::sjis_japanese_ci:
+    case collation::sjis_bin:
+    case collation::gbk_chinese_ci:
+    case collation::gbk_bin:
+    case collation::cp932_japanese_ci:
+    case collation::cp932_bin:
+    case collation::gb18030_chinese_ci:
+    case collation::gb18030_bin:
+    case collation::gb18030_unicode_520_ci:
+        return false;
+    default:
+        return true;
+    }
+}
+
+inline errc check_format_options(const format_options& opts) noexcept
+{
+    return is_sql_escape_safe(opts.connection_collation()) ? errc::ok : errc::unsafe_charset;
+}
+
+template <class Output>
+void append_sql(Output& output, const char* data, std::size_t size)
+{
+    output.insert(output.end(), data, data + size);
+}
+
+template <class Output>
+void append_sql(Output& output, boost::string_view s)
+{
+    append_sql(output, s.data(), s.size());
+}
+
+template <class Output>
+void append_sql(Output& output, char c)
+{
+    output.push_back(static_cast<typename Output::value_type>(c));
+}
+
+// Non-zero if any of the bytes in word equals c
+inline std::uint64_t sql_word_has_byte(std::uint64_t word, unsigned char c) noexcept
+{
+    constexpr std::uint64_t ones = 0x0101010101010101;
+    constexpr std::uint64_t highs = 0x8080808080808080;
+    std::uint64_t x = word ^ (ones * c);
+    return (x - ones) & ~x & highs;
+}
+
+// The two-character sequence to write instead of c within a quoted string,
+// or nullptr if c can be written as is. Mirrors mysql_real_escape_string
+inline const char* sql_escape_sequence(char c, bool backslash_escapes) noexcept
+{
+    if (!backslash_escapes)
+        return c == '\'' ? "''" : nullptr;
+    switch (c)
+    {
+    case '\\': return "\\\\";
+    case '\'': return "\\'";
+    case '\0': return "\\0";
+    case '\x1a': return "\\Z";
+    default: return nullptr;
+    }
+}
+
+// Strings are usually long and rarely contain characters to escape,
+// so we scan them a word at a time
+inline const char* find_sql_escape(const char* first, const char* last, bool backslash_escapes) noexcept
+{
+    for (; last - first >= 8; first += 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, first, 8);
+        if (sql_word_has_byte(word, '\'') || (backslash_escapes && (
+                sql_word_has_byte(word, '\\') ||
+                sql_word_has_byte(word, 0) ||
+                sql_word_has_byte(word, 0x1a))))
+        {
+            break;
+        }
+    }
+    for (; first != last; ++first)
+    {
+        if (sql_escape_sequence(*first, backslash_escapes))
+            break;
+    }
+    return first;
+}
+
+template <class Output>
+void serialize_sql_string(boost::string_view s, bool backslash_escapes, Output& output)
+{
+    // Copy the runs between characters to escape
+    output.reserve(output.size() + s.size() + 2);
+    append_sql(output, '\'');
+    const char* first = s.data();
+    const char* last = first + s.size();
+    while (true)
+    {
+        const char* escaped = find_sql_escape(first, last, backslash_escapes);
+        append_sql(output, first, static_cast<std::size_t>(escaped - first));
+        if (escaped == last)
+            break;
+        append_sql(output, sql_escape_sequence(*escaped, backslash_escapes), 2);
+        first = escaped + 1;
+    }
+    append_sql(output, '\'');
+}
+
+template <class Output>
+struct sql_literal_visitor
+{
+    Output& output;
+    bool backslash_escapes;
+
+    sql_literal_visitor(Output& output, bool backslash_escapes):
+        output(output), backslash_escapes(backslash_escapes) {}
+
+    template <class... Args>
+    void append_formatted(const char* format, Args... args) const
+    {
+        char buffer [64];
+        int size = snprintf(buffer, sizeof(buffer), format, args...);
+        assert(size > 0 && static_cast<std::size_t>(size) < sizeof(buffer));
+        append_sql(output, buffer, static_cast<std::size_t>(size));
+    }
+
+    template <class T>
+    errc append_floating(T v, const char* format) const
+    {
+        // MySQL has no literals for NaN or infinities
+        if (!std::isfinite(v))
+            return errc::unrepresentable_value;
+        char buffer [64];
+        int size = snprintf(buffer, sizeof(buffer), format, static_cast<double>(v));
+        assert(size > 0 && static_cast<std::size_t>(size) < sizeof(buffer));
+        for (int i = 0; i < size; ++i)
+        {
+            // The C locale may have been changed by the user
+            if (buffer[i] == ',')
+                buffer[i] = '.';
+        }
+        append_sql(output, buffer, static_cast<std::size_t>(size));
+        return errc::ok;
+    }
+
+    void append_date(date v) const
+    {
+        auto ymd = days_to_ymd(v.time_since_epoch().count());
+        append_formatted("%04d-%02u-%02u", ymd.years, ymd.month, ymd.day);
+    }
+
+    void append_time(time v) const
+    {
+        using namespace std::chrono;
+        const char* sign = v < microseconds(0) ? "-" : "";
+        auto num_micros = v % seconds(1);
+        auto num_secs = duration_cast<seconds>(v % minutes(1) - num_micros);
+        auto num_mins = duration_cast<minutes>(v % hours(1) - num_secs);
+        auto num_hours = duration_cast<hours>(v - num_mins);
+        append_formatted("%s%02d:%02u:%02u.%06u",
+            sign,
+            static_cast<int>(std::abs(num_hours.count())),
+            static_cast<unsigned>(std::abs(num_mins.count())),
+            static_cast<unsigned>(std::abs(num_secs.count())),
+            static_cast<unsigned>(std::abs(num_micros.count()))
+        );
+    }
+
+    errc operator()(null_t) const
+    {
+        append_sql(output, "NULL");
+        return errc::ok;
+    }
+    errc operator()(std::int64_t v) const
+    {
+        append_formatted("%lld", static_cast<long long>(v));
+        return errc::ok;
+    }
+    errc operator()(std::uint64_t v) const
+    {
+        append_formatted("%llu", static_cast<unsigned long long>(v));
+        return errc::ok;
+    }
+    errc operator()(boost::string_view v) const
+    {
+        serialize_sql_string(v, backslash_escapes, output);
+        return errc::ok;
+    }
+    errc operator()(float v) const { return append_floating(v, "%.9g"); }
+    errc operator()(double v) const { return append_floating(v, "%.17g"); }
+    errc operator()(date v) const
+    {
+        append_sql(output, '\'');
+        append_date(v);
+        append_sql(output, '\'');
+        return errc::ok;
+    }
+    errc operator()(datetime v) const
+    {
+        using namespace std::chrono;
+        date date_part = time_point_cast<days>(v);
+        if (date_part > v)
+            date_part -= days(1);
+        append_sql(output, '\'');
+        append_date(date_part);
+        append_sql(output, ' ');
+        append_time(duration_cast<time>(v - date_part));
+        append_sql(output, '\'');
+        return errc::ok;
+    }
+    errc operator()(time v) const
+    {
+        append_sql(output, '\'');
+        append_time(v);
+        append_sql(output, '\'');
+        return errc::ok;
+    }
+};
+
+template <class Output>
+errc serialize_sql_literal(const value& v, bool backslash_escapes, Output& output)
+{
+    return boost::variant2::visit(sql_literal_visitor<Output>(output, backslash_escapes), v.to_variant());
+}
+
+// Rows are serialized as a parenthesized list of literals.
+// They may be ValueCollections or std::tuples of types convertible to value.
+template <class ValueCollection>
+errc serialize_sql_row_values(
+    const ValueCollection& row,
+    bool backslash_escapes,
+    bytestring& output,
+    std::true_type
+)
+{
+    bool first = true;
+    for (const auto& v: row)
+    {
+        if (!first)
+            output.push_back(',');
+        first = false;
+        errc err = serialize_sql_literal(v, backslash_escapes, output);
+        if (err != errc::ok)
+            return err;
+    }
+    return errc::ok;
+}
+
+struct sql_tuple_element_serializer
+{
+    bytestring& output;
+    bool backslash_escapes;
+    errc& err;
+    bool first;
+
+    template <class T>
+    void operator()(const T& elm)
+    {
+        if (err != errc::ok)
+            return;
+        if (!first)
+            output.push_back(',');
+        first = false;
+        err = serialize_sql_literal(value(elm), backslash_escapes, output);
+    }
+};
+
+template <class Tuple>
+errc serialize_sql_row_values(
+    const Tuple& row,
+    bool backslash_escapes,
+    bytestring& output,
+    std::false_type
+)
+{
+    errc err = errc::ok;
+    boost::mp11::tuple_for_each(row, sql_tuple_element_serializer{output, backslash_escapes, err, true});
+    return err;
+}
+
+template <class Row>
+errc serialize_sql_row(const Row& row, bool backslash_escapes, bytestring& output)
+{
+    output.push_back('(');
+    errc err = serialize_sql_row_values(row, backslash_escapes, output, is_value_collection<Row>());
+    output.push_back(')');
+    return err;
+}
+
+} // detail
+} // mysql
+} // boost
+
+#endif
@@ -0,0 +1,42 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_BULK_INSERT_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_BULK_INSERT_HPP
+
+#include <boost/mysql/detail/network_algorithms/common.hpp>
+#include <boost/mysql/bulk_insert_params.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+template <class Stream, class RowForwardIterator>
+std::uint64_t bulk_insert(
+    channel<Stream>& channel,
+    const bulk_insert_params<RowForwardIterator>& params,
+    error_code& err,
+    error_info& info
+);
+
+template <class Stream, class RowForwardIterator, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::uint64_t))
+async_bulk_insert(
+    channel<Stream>& chan,
+    const bulk_insert_params<RowForwardIterator>& params,
+    CompletionToken&& token,
+    error_info& info
+);
+
+} // detail
+} // mysql
+} // boost
+
+#include <boost/mysql/detail/network_algorithms/impl/bulk_insert.hpp>
+
+#endif
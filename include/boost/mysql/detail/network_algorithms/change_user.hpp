@@ -0,0 +1,42 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_CHANGE_USER_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_CHANGE_USER_HPP
+
+#include <boost/mysql/detail/network_algorithms/common.hpp>
+#include <boost/mysql/connection_params.hpp>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Authenticates again over an already established connection (COM_CHANGE_USER)
+template <class Stream>
+void change_user(
+    channel<Stream>& chan,
+    const connection_params& params,
+    error_code& err,
+    error_info& info
+);
+
+template <class Stream, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+async_change_user(
+    channel<Stream>& chan,
+    const connection_params& params,
+    CompletionToken&& token,
+    error_info& info
+);
+
+} // detail
+} // mysql
+} // boost
+
+#include <boost/mysql/detail/network_algorithms/impl/change_user.hpp>
+
+#endif
@@ -16,9 +16,16 @@ namespace boost {
 namespace mysql {
 namespace detail {
 
+// A request message already serialized by the caller. Executing it
+// takes ownership of the buffer contents, avoiding a copy.
+struct serialized_request
+{
+    bytestring& buffer;
+};
+
 template <class Stream, class Serializable>
 void execute_generic(
-    deserialize_row_fn deserializer,
+    resultset_encoding encoding,
     channel<Stream>& channel,
     const Serializable& request,
     resultset<Stream>& output,
@@ -29,7 +36,7 @@ void execute_generic(
 template <class Stream, class Serializable, class CompletionToken>
 BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, resultset<Stream>))
 async_execute_generic(
-    deserialize_row_fn deserializer,
+    resultset_encoding encoding,
     channel<Stream>& chan,
     const Serializable& request,
     CompletionToken&& token,
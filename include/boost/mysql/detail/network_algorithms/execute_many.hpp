@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_EXECUTE_MANY_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_EXECUTE_MANY_HPP
+
+#include <boost/mysql/detail/network_algorithms/common.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Maximum number of executions and bytes (approximate) sent by execute_many
+// before reading their responses. Small enough to fit in the socket buffers
+constexpr std::size_t execute_many_max_window_requests = 256;
+constexpr std::size_t execute_many_max_window_size = 64 * 1024;
+
+// Executes a prepared statement once per parameter set. Executions
+// are written in windows: all the executions in a window are written
+// at once, and then their responses are read (pipelining).
+// long_data_params applies to the first execution only
+template <class Stream, class ParamSetCollection>
+std::uint64_t execute_many(
+    channel<Stream>& chan,
+    std::uint32_t statement_id,
+    unsigned num_params,
+    const ParamSetCollection& param_sets,
+    const std::vector<bool>* long_data_params,
+    error_code& err,
+    error_info& info
+);
+
+template <class Stream, class ParamSetCollection, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::uint64_t))
+async_execute_many(
+    channel<Stream>& chan,
+    std::uint32_t statement_id,
+    unsigned num_params,
+    const ParamSetCollection& param_sets,
+    const std::vector<bool>* long_data_params,
+    CompletionToken&& token,
+    error_info& info
+);
+
+} // detail
+} // mysql
+} // boost
+
+#include <boost/mysql/detail/network_algorithms/impl/execute_many.hpp>
+
+#endif
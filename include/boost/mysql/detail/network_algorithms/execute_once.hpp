@@ -0,0 +1,49 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_EXECUTE_ONCE_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_EXECUTE_ONCE_HPP
+
+#include <boost/mysql/detail/network_algorithms/common.hpp>
+#include <boost/mysql/resultset.hpp>
+#include <boost/utility/string_view.hpp>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Prepares, executes and closes a statement, writing the requests
+// back to back to minimize round-trips
+template <class Stream, class ValueForwardIterator>
+void execute_once(
+    channel<Stream>& chan,
+    boost::string_view statement,
+    ValueForwardIterator params_begin,
+    ValueForwardIterator params_end,
+    resultset<Stream>& output,
+    error_code& err,
+    error_info& info
+);
+
+template <class Stream, class ValueForwardIterator, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, resultset<Stream>))
+async_execute_once(
+    channel<Stream>& chan,
+    boost::string_view statement,
+    ValueForwardIterator params_begin,
+    ValueForwardIterator params_end,
+    CompletionToken&& token,
+    error_info& info
+);
+
+} // detail
+} // mysql
+} // boost
+
+#include <boost/mysql/detail/network_algorithms/impl/execute_once.hpp>
+
+#endif
@@ -11,6 +11,7 @@
 #include <boost/mysql/detail/network_algorithms/common.hpp>
 #include <boost/mysql/resultset.hpp>
 #include <boost/mysql/value.hpp>
+#include <vector>
 
 namespace boost {
 namespace mysql {
@@ -22,6 +23,7 @@ void execute_statement(
     std::uint32_t statement_id,
     ValueForwardIterator params_begin,
     ValueForwardIterator params_end,
+    const std::vector<bool>* long_data_params,
     resultset<Stream>& output,
     error_code& err,
     error_info& info
@@ -34,6 +36,7 @@ async_execute_statement(
     std::uint32_t statement_id,
     ValueForwardIterator params_begin,
     ValueForwardIterator params_end,
+    const std::vector<bool>* long_data_params,
     CompletionToken&& token,
     error_info& info
 );
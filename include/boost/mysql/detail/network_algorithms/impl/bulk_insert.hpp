@@ -0,0 +1,250 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_BULK_INSERT_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_BULK_INSERT_HPP
+
+#include <boost/mysql/detail/auxiliar/sql_literal.hpp>
+#include <boost/mysql/detail/protocol/query_messages.hpp>
+#include <boost/mysql/detail/network_algorithms/execute_generic.hpp>
+#include <boost/asio/post.hpp>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Builds INSERT statements, directly serialized as COM_QUERY messages,
+// splitting rows so that each statement stays under the size limit
+class bulk_insert_processor
+{
+    boost::string_view prefix_;
+    std::size_t max_size_;
+    format_options opts_;
+    bytestring buffer_;   // the statement being built, including the command byte
+    bytestring overflow_; // a row that didn't fit in the current statement
+    std::size_t num_rows_ {0};
+    bool full_ {false};
+    std::uint64_t affected_rows_ {0};
+
+    void start_statement()
+    {
+        buffer_.clear();
+        buffer_.push_back(com_query_packet::command_id);
+        append_sql(buffer_, prefix_);
+        num_rows_ = 0;
+    }
+public:
+    bulk_insert_processor(boost::string_view prefix, std::size_t max_size, format_options opts):
+        prefix_(prefix), max_size_(max_size), opts_(opts) {}
+
+    // Serializes a row into the current statement. If it doesn't fit,
+    // the statement is marked as full and the row is kept for the next one.
+    // A single row exceeding the limit is sent on its own.
+    template <class Row>
+    error_code add_row(const Row& row)
+    {
+        assert(!full_);
+        errc err = check_format_options(opts_);
+        if (err != errc::ok)
+            return make_error_code(err);
+        if (num_rows_ == 0)
+            start_statement();
+        std::size_t row_start = buffer_.size();
+        if (num_rows_ > 0)
+            buffer_.push_back(',');
+        err = serialize_sql_row(row, opts_.backslash_escapes(), buffer_);
+        if (err != errc::ok)
+            return make_error_code(err);
+        if (buffer_.size() - 1 > max_size_ && num_rows_ > 0)
+        {
+            overflow_.assign(buffer_.begin() + row_start + 1, buffer_.end()); // skip the comma
+            buffer_.resize(row_start);
+            full_ = true;
+        }
+        else
+        {
+            ++num_rows_;
+        }
+        return error_code();
+    }
+
+    // Whether the current statement must be sent before adding more rows
+    bool full() const noexcept { return full_; }
+
+    // Whether there is a statement to be sent
+    bool has_rows() const noexcept { return num_rows_ > 0; }
+
+    // The statement to send. Executing it will take ownership of the buffer
+    serialized_request statement() noexcept { return serialized_request{buffer_}; }
+
+    // Call after a statement has been executed. Moves any overflowing row to
+    // the next statement
+    void on_statement_executed(std::uint64_t affected_rows)
+    {
+        affected_rows_ += affected_rows;
+        num_rows_ = 0;
+        if (full_)
+        {
+            start_statement();
+            buffer_.insert(buffer_.end(), overflow_.begin(), overflow_.end());
+            num_rows_ = 1;
+            full_ = false;
+        }
+    }
+
+    std::uint64_t affected_rows() const noexcept { return affected_rows_; }
+};
+
+template<class Stream, class RowForwardIterator>
+struct bulk_insert_op : boost::asio::coroutine
+{
+    channel<Stream>& chan_;
+    error_info& output_info_;
+    RowForwardIterator current_;
+    RowForwardIterator last_;
+    bulk_insert_processor processor_;
+    error_code err_;
+    bool cont_ {false};
+
+    bulk_insert_op(
+        channel<Stream>& chan,
+        error_info& output_info,
+        const bulk_insert_params<RowForwardIterator>& params
+    ) :
+        chan_(chan),
+        output_info_(output_info),
+        current_(params.first()),
+        last_(params.last()),
+        processor_(
+            params.statement_prefix(),
+            params.max_statement_size(),
+            format_options(chan.connection_collation(), chan.backslash_escapes())
+        )
+    {
+    }
+
+    // Serializes rows until the current statement is full or we run out of rows
+    void fill_statement()
+    {
+        while (current_ != last_ && !processor_.full())
+        {
+            err_ = processor_.add_row(*current_);
+            if (err_)
+                return;
+            ++current_;
+        }
+    }
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        resultset<Stream> result = {}
+    )
+    {
+        // Error checking
+        check_cancellation(self, err);
+        if (err)
+        {
+            self.complete(err, processor_.affected_rows());
+            return;
+        }
+
+        // Non-error path
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            while (true)
+            {
+                fill_statement();
+                if (err_ || !processor_.has_rows())
+                    break;
+                BOOST_ASIO_CORO_YIELD async_execute_generic(
+                    resultset_encoding::text,
+                    chan_,
+                    processor_.statement(),
+                    std::move(self),
+                    output_info_
+                );
+                cont_ = true;
+                processor_.on_statement_executed(result.affected_rows());
+            }
+
+            if (!cont_)
+            {
+                // Ensure we call handler as if dispatched using post
+                BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+            }
+            self.complete(err_, processor_.affected_rows());
+        }
+    }
+};
+
+} // detail
+} // mysql
+} // boost
+
+template <class Stream, class RowForwardIterator>
+std::uint64_t boost::mysql::detail::bulk_insert(
+    channel<Stream>& channel,
+    const bulk_insert_params<RowForwardIterator>& params,
+    error_code& err,
+    error_info& info
+)
+{
+    bulk_insert_processor processor (
+        params.statement_prefix(),
+        params.max_statement_size(),
+        format_options(channel.connection_collation(), channel.backslash_escapes())
+    );
+    auto current = params.first();
+    auto last = params.last();
+    resultset<Stream> result;
+    while (true)
+    {
+        // Serialize as many rows as fit in a statement
+        while (current != last && !processor.full())
+        {
+            err = processor.add_row(*current);
+            if (err)
+                return processor.affected_rows();
+            ++current;
+        }
+        if (!processor.has_rows())
+            break;
+
+        // Send it
+        execute_generic(resultset_encoding::text, channel, processor.statement(), result, err, info);
+        if (err)
+            return processor.affected_rows();
+        processor.on_statement_executed(result.affected_rows());
+    }
+    return processor.affected_rows();
+}
+
+template <class Stream, class RowForwardIterator, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, std::uint64_t)
+)
+boost::mysql::detail::async_bulk_insert(
+    channel<Stream>& chan,
+    const bulk_insert_params<RowForwardIterator>& params,
+    CompletionToken&& token,
+    error_info& info
+)
+{
+    return boost::asio::async_compose<
+        CompletionToken,
+        void(error_code, std::uint64_t)
+    >(
+        bulk_insert_op<Stream, RowForwardIterator>(chan, info, params),
+        token,
+        chan
+    );
+}
+
+#endif
@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_CHANGE_USER_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_CHANGE_USER_HPP
+
+#include <boost/mysql/detail/network_algorithms/handshake.hpp>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+template<class Stream>
+struct change_user_op : boost::asio::coroutine
+{
+    channel<Stream>& chan_;
+    error_info& output_info_;
+    handshake_processor processor_;
+    auth_result auth_state_ {auth_result::invalid};
+    error_code err_;
+
+    change_user_op(
+        channel<Stream>& chan,
+        error_info& output_info,
+        const connection_params& params
+    ) :
+        chan_(chan),
+        output_info_(output_info),
+        processor_(
+            params,
+            static_cast<bool>(chan.get_local_infile_handler()),
+            chan.endpoint_key()
+        )
+    {
+    }
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code err = {}
+    )
+    {
+        // Error checking
+        check_cancellation(self, err);
+        if (err)
+        {
+            self.complete(err);
+            return;
+        }
+
+        // Non-error path
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            // Compose and send the request
+            err_ = processor_.compose_change_user(
+                chan_.current_capabilities(),
+                chan_.auth_plugin(),
+                chan_.scramble(),
+                chan_.shared_buffer()
+            );
+            if (err_)
+            {
+                BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+                self.complete(err_);
+                BOOST_ASIO_CORO_YIELD break;
+            }
+            chan_.reset_sequence_number();
+            BOOST_ASIO_CORO_YIELD chan_.async_write(chan_.shared_buffer(), std::move(self));
+
+            // Same exchange as in the handshake
+            while (auth_state_ != auth_result::complete)
+            {
+                BOOST_ASIO_CORO_YIELD chan_.async_read(chan_.shared_buffer(), std::move(self));
+
+                err = processor_.process_handshake_server_response(
+                    chan_.shared_buffer(),
+                    auth_state_,
+                    output_info_
+                );
+                if (err)
+                {
+                    self.complete(err);
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+
+                if (auth_state_ == auth_result::send_more_data)
+                {
+                    BOOST_ASIO_CORO_YIELD chan_.async_write(chan_.shared_buffer(), std::move(self));
+                }
+            }
+
+            chan_.set_auth_state(processor_.auth_plugin(), processor_.scramble());
+            chan_.set_connection_collation(processor_.connection_collation());
+            chan_.set_status_flags(processor_.status_flags());
+            self.complete(error_code());
+        }
+    }
+};
+
+} // detail
+} // mysql
+} // boost
+
+template <class Stream>
+void boost::mysql::detail::change_user(
+    channel<Stream>& chan,
+    const connection_params& params,
+    error_code& err,
+    error_info& info
+)
+{
+    handshake_processor processor (
+        params,
+        static_cast<bool>(chan.get_local_infile_handler()),
+        chan.endpoint_key()
+    );
+
+    // Request
+    err = processor.compose_change_user(
+        chan.current_capabilities(),
+        chan.auth_plugin(),
+        chan.scramble(),
+        chan.shared_buffer()
+    );
+    if (err)
+        return;
+    chan.reset_sequence_number();
+    chan.write(boost::asio::buffer(chan.shared_buffer()), err);
+    if (err)
+        return;
+
+    // Same exchange as in the handshake
+    auth_result auth_outcome = auth_result::invalid;
+    while (auth_outcome != auth_result::complete)
+    {
+        chan.read(chan.shared_buffer(), err);
+        if (err)
+            return;
+
+        err = processor.process_handshake_server_response(chan.shared_buffer(), auth_outcome, info);
+        if (err)
+            return;
+
+        if (auth_outcome == auth_result::send_more_data)
+        {
+            chan.write(boost::asio::buffer(chan.shared_buffer()), err);
+            if (err)
+                return;
+        }
+    }
+
+    chan.set_auth_state(processor.auth_plugin(), processor.scramble());
+    chan.set_connection_collation(processor.connection_collation());
+    chan.set_status_flags(processor.status_flags());
+}
+
+template <class Stream, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::detail::async_change_user(
+    channel<Stream>& chan,
+    const connection_params& params,
+    CompletionToken&& token,
+    error_info& info
+)
+{
+    return boost::asio::async_compose<
+        CompletionToken,
+        void(error_code)
+    >(
+        change_user_op<Stream>(chan, info, params),
+        token,
+        chan
+    );
+}
+
+#endif
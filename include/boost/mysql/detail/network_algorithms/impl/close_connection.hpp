@@ -51,6 +51,7 @@ struct close_connection_op : boost::asio::coroutine
         error_code err = {}
     )
     {
+        check_cancellation(self, err);
         error_code close_err;
         BOOST_ASIO_CORO_REENTER(*this)
         {
@@ -9,6 +9,50 @@
 #define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_CLOSE_STATEMENT_HPP
 
 #include <boost/mysql/detail/protocol/prepared_statement_messages.hpp>
+#include <boost/asio/post.hpp>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+template <class Stream>
+struct close_statement_op : boost::asio::coroutine
+{
+    channel<Stream>& chan_;
+
+    close_statement_op(channel<Stream>& chan) : chan_(chan) {}
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code err = {}
+    )
+    {
+        check_cancellation(self, err);
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if (chan_.deferred_close())
+            {
+                // Queued to be sent with the next command. Ensure return as if by post
+                chan_.defer_write(boost::asio::buffer(chan_.shared_buffer()));
+                BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+            }
+            else
+            {
+                chan_.reset_sequence_number();
+                BOOST_ASIO_CORO_YIELD chan_.async_write(
+                    boost::asio::buffer(chan_.shared_buffer()),
+                    std::move(self)
+                );
+            }
+            self.complete(err);
+        }
+    }
+};
+
+} // detail
+} // mysql
+} // boost
 
 template <class Stream>
 void boost::mysql::detail::close_statement(
@@ -24,6 +68,13 @@ void boost::mysql::detail::close_statement(
     // Serialize it
     serialize_message(packet, chan.current_capabilities(), chan.shared_buffer());
 
+    // If deferred, it will be sent together with the next command
+    if (chan.deferred_close())
+    {
+        chan.defer_write(boost::asio::buffer(chan.shared_buffer()));
+        return;
+    }
+
     // Send it. No response is sent back
     chan.reset_sequence_number();
     chan.write(boost::asio::buffer(chan.shared_buffer()), code);
@@ -47,11 +98,11 @@ boost::mysql::detail::async_close_statement(
     // Serialize it
     serialize_message(packet, chan.current_capabilities(), chan.shared_buffer());
 
-    // Send it. No response is sent back
-    chan.reset_sequence_number();
-    return chan.async_write(
-        boost::asio::buffer(chan.shared_buffer()),
-        std::forward<CompletionToken>(token)
+    // Send it or defer it. No response is sent back
+    return boost::asio::async_compose<CompletionToken, void(error_code)>(
+        close_statement_op<Stream>(chan),
+        token,
+        chan
     );
 }
 
@@ -9,6 +9,7 @@
 #define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_CONNECT_HPP
 
 #include <boost/mysql/detail/network_algorithms/handshake.hpp>
+#include <boost/mysql/detail/auxiliar/stringize.hpp>
 
 namespace boost {
 namespace mysql {
@@ -43,10 +44,12 @@ struct connect_op : boost::asio::coroutine
         error_code code = {}
     )
     {
+        check_cancellation(self, code);
         BOOST_ASIO_CORO_REENTER(*this)
         {
             // Physical connect
-            BOOST_ASIO_CORO_YIELD chan_.next_layer().async_connect(ep_, std::move(self));
+            chan_.set_endpoint_key(stringize(ep_));
+            BOOST_ASIO_CORO_YIELD chan_.async_connect(ep_, std::move(self));
             if (code)
             {
                 chan_.close();
@@ -84,6 +87,7 @@ void boost::mysql::detail::connect(
     error_info& info
 )
 {
+    chan.set_endpoint_key(stringize(endpoint));
     chan.next_layer().connect(endpoint, err);
     if (err)
     {
@@ -8,24 +8,33 @@
 #ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_EXECUTE_GENERIC_HPP
 #define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_EXECUTE_GENERIC_HPP
 
+#include <boost/mysql/detail/protocol/prepared_statement_messages.hpp>
+#include <algorithm>
 #include <limits>
+#include <string>
 
 namespace boost {
 namespace mysql {
 namespace detail {
 
+// Size of the packets sent when streaming a local infile
+constexpr std::size_t local_infile_chunk_size = 0x10000;
+
 class execute_processor
 {
-    deserialize_row_fn deserializer_;
+    resultset_encoding encoding_;
     capabilities caps_;
     bytestring buffer_;
     std::size_t field_count_ {};
     ok_packet ok_packet_ {};
     std::vector<field_metadata> fields_;
     std::vector<bytestring> field_buffers_;
+    bool local_infile_requested_ {false};
+    std::string local_infile_filename_;
+    error_code local_infile_error_;
 public:
-    execute_processor(deserialize_row_fn deserializer, capabilities caps):
-        deserializer_(deserializer), caps_(caps) {};
+    execute_processor(resultset_encoding encoding, capabilities caps):
+        encoding_(encoding), caps_(caps) {};
 
     template <class Serializable>
     void process_request(
@@ -35,25 +44,46 @@ public:
         serialize_message(request, caps_, buffer_);
     }
 
+    void process_request(
+        const serialized_request& request
+    )
+    {
+        buffer_.swap(request.buffer);
+    }
+
     void process_response(
         error_code& err,
         error_info& info
     )
     {
-        // Response may be: ok_packet, err_packet, local infile request (not implemented)
+        // Response may be: ok_packet, err_packet, local infile request
         // If it is none of this, then the message type itself is the beginning of
         // a length-encoded int containing the field count
+        local_infile_requested_ = false;
         deserialization_context ctx (boost::asio::buffer(buffer_), caps_);
         std::uint8_t msg_type = 0;
         err = make_error_code(deserialize(ctx, msg_type));
         if (err)
             return;
-        if (msg_type == ok_packet_header)
+        if (msg_type == local_infile_request_header)
+        {
+            string_eof filename;
+            err = deserialize_message(ctx, filename);
+            if (err)
+                return;
+            local_infile_requested_ = true;
+            local_infile_filename_.assign(filename.value.data(), filename.value.size());
+            local_infile_error_.clear();
+        }
+        else if (msg_type == ok_packet_header)
         {
             err = deserialize_message(ctx, ok_packet_);
             if (err)
                 return;
             field_count_ = 0;
+
+            // If we aborted a local infile, report why
+            err = local_infile_error_;
         }
         else if (msg_type == error_packet_header)
         {
@@ -92,6 +122,31 @@ public:
         }
     }
 
+    bool local_infile_requested() const noexcept { return local_infile_requested_; }
+
+    // Places the next chunk of the local infile in the buffer. An empty
+    // buffer signals the end of the data. If the handler fails or there
+    // is no handler, we send no more data and report the error later.
+    void read_local_infile_chunk(const local_infile_handler& handler)
+    {
+        if (!handler)
+        {
+            local_infile_error_ = make_error_code(errc::local_infile_disabled);
+        }
+        if (local_infile_error_)
+        {
+            buffer_.clear();
+            return;
+        }
+        buffer_.resize(local_infile_chunk_size);
+        std::size_t size = handler(
+            local_infile_filename_,
+            boost::asio::buffer(buffer_),
+            local_infile_error_
+        );
+        buffer_.resize(local_infile_error_ ? 0 : (std::min)(size, local_infile_chunk_size));
+    }
+
     error_code process_field_definition()
     {
         column_definition_packet field_definition;
@@ -113,6 +168,8 @@ public:
     {
         if (field_count_ == 0)
         {
+            // Statements like SET sql_mode may change how SQL text is parsed
+            chan.set_status_flags(ok_packet_.status_flags);
             return resultset<Stream>(
                 chan,
                 std::move(buffer_),
@@ -124,7 +181,7 @@ public:
             return resultset<Stream>(
                 chan,
                 resultset_metadata(std::move(field_buffers_), std::move(fields_)),
-                deserializer_
+                encoding_
             );
         }
     }
@@ -132,24 +189,62 @@ public:
     bytestring& get_buffer() { return buffer_; }
 
     std::size_t field_count() const noexcept { return field_count_; }
+
+    // For consumers not using resultset. The OK packet points into the buffer
+    const ok_packet& get_ok_packet() const noexcept { return ok_packet_; }
+    resultset_metadata release_metadata() &&
+    {
+        return resultset_metadata(std::move(field_buffers_), std::move(fields_));
+    }
 };
 
+// Sends the request for the sync algorithm
+template <class Stream, class Serializable>
+void write_execute_request(
+    channel<Stream>& chan,
+    execute_processor& processor,
+    const Serializable& request,
+    error_code& err
+)
+{
+    processor.process_request(request);
+    chan.write(boost::asio::buffer(processor.get_buffer()), err);
+}
+
+// Statement parameters are alive until the request is sent, so big strings
+// are sent from the caller's memory, without copying them
+template <class Stream, class ValueForwardIterator>
+void write_execute_request(
+    channel<Stream>& chan,
+    execute_processor&,
+    const com_stmt_execute_packet<ValueForwardIterator>& request,
+    error_code& err
+)
+{
+    gathered_message msg;
+    serialize_stmt_execute_gathered(request, chan.current_capabilities(), msg);
+    chan.write(msg, err);
+}
+
 template<class Stream>
 struct execute_generic_op : boost::asio::coroutine
 {
     channel<Stream>& chan_;
     error_info& output_info_;
     std::shared_ptr<execute_processor> processor_;
+    bool write_request_;
     std::uint64_t remaining_fields_ {0};
 
     execute_generic_op(
         channel<Stream>& chan,
         error_info& output_info,
-        std::shared_ptr<execute_processor>&& processor
+        std::shared_ptr<execute_processor>&& processor,
+        bool write_request = true
     ) :
         chan_(chan),
         output_info_(output_info),
-        processor_(std::move(processor))
+        processor_(std::move(processor)),
+        write_request_(write_request)
     {
     }
 
@@ -160,6 +255,7 @@ struct execute_generic_op : boost::asio::coroutine
     )
     {
         // Error checking
+        check_cancellation(self, err);
         if (err)
         {
             self.complete(err, resultset<Stream>());
@@ -169,22 +265,43 @@ struct execute_generic_op : boost::asio::coroutine
         // Non-error path
         BOOST_ASIO_CORO_REENTER(*this)
         {
-            chan_.reset_sequence_number();
-
-            // The request message has already been composed in the ctor. Send it
-            BOOST_ASIO_CORO_YIELD chan_.async_write(processor_->get_buffer(), std::move(self));
+            // The request message has already been composed in the ctor. Send it,
+            // unless the caller already did
+            if (write_request_)
+            {
+                chan_.reset_sequence_number();
+                BOOST_ASIO_CORO_YIELD chan_.async_write(processor_->get_buffer(), std::move(self));
+            }
 
             // Read the response
             BOOST_ASIO_CORO_YIELD chan_.async_read(processor_->get_buffer(), std::move(self));
 
             // Response may be: ok_packet, err_packet, local infile request
-            // (not implemented), or response with fields
+            // or response with fields
             processor_->process_response(err, output_info_);
             if (err)
             {
                 self.complete(err, resultset<Stream>());
                 BOOST_ASIO_CORO_YIELD break;
             }
+
+            // Local infile request: stream the contents, followed by an empty packet
+            while (processor_->local_infile_requested())
+            {
+                do
+                {
+                    processor_->read_local_infile_chunk(chan_.get_local_infile_handler());
+                    BOOST_ASIO_CORO_YIELD chan_.async_write(processor_->get_buffer(), std::move(self));
+                } while (!processor_->get_buffer().empty());
+
+                BOOST_ASIO_CORO_YIELD chan_.async_read(processor_->get_buffer(), std::move(self));
+                processor_->process_response(err, output_info_);
+                if (err)
+                {
+                    self.complete(err, resultset<Stream>());
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+            }
             remaining_fields_ = processor_->field_count();
 
             // Read all of the field definitions
@@ -213,40 +330,46 @@ struct execute_generic_op : boost::asio::coroutine
     }
 };
 
-} // detail
-} // mysql
-} // boost
-
-template <class Stream, class Serializable>
-void boost::mysql::detail::execute_generic(
-    deserialize_row_fn deserializer,
+// Reads the response to an already sent request, for the sync algorithm
+template <class Stream>
+void read_execute_response(
     channel<Stream>& channel,
-    const Serializable& request,
+    execute_processor& processor,
     resultset<Stream>& output,
     error_code& err,
     error_info& info
 )
 {
-    // Compose a com_query message, reset seq num
-    execute_processor processor (deserializer, channel.current_capabilities());
-    processor.process_request(request);
-    channel.reset_sequence_number();
-
-    // Send it
-    channel.write(boost::asio::buffer(processor.get_buffer()), err);
-    if (err)
-        return;
-
     // Read the response
     channel.read(processor.get_buffer(), err);
     if (err)
         return;
 
-    // Response may be: ok_packet, err_packet, local infile request (not implemented), or response with fields
+    // Response may be: ok_packet, err_packet, local infile request, or response with fields
     processor.process_response(err, info);
     if (err)
         return;
 
+    // Local infile request: stream the contents, followed by an empty packet
+    // signaling the end of the data. The server then sends the actual response
+    while (processor.local_infile_requested())
+    {
+        do
+        {
+            processor.read_local_infile_chunk(channel.get_local_infile_handler());
+            channel.write(boost::asio::buffer(processor.get_buffer()), err);
+            if (err)
+                return;
+        } while (!processor.get_buffer().empty());
+
+        channel.read(processor.get_buffer(), err);
+        if (err)
+            return;
+        processor.process_response(err, info);
+        if (err)
+            return;
+    }
+
     // Read all of the field definitions (zero if empty resultset)
     for (std::uint64_t i = 0; i < processor.field_count(); ++i)
     {
@@ -265,20 +388,44 @@ void boost::mysql::detail::execute_generic(
     output = std::move(processor).create_resultset(channel);
 }
 
+} // detail
+} // mysql
+} // boost
+
+template <class Stream, class Serializable>
+void boost::mysql::detail::execute_generic(
+    resultset_encoding encoding,
+    channel<Stream>& channel,
+    const Serializable& request,
+    resultset<Stream>& output,
+    error_code& err,
+    error_info& info
+)
+{
+    // Compose the request message, reset seq num and send it
+    execute_processor processor (encoding, channel.current_capabilities());
+    channel.reset_sequence_number();
+    write_execute_request(channel, processor, request, err);
+    if (err)
+        return;
+
+    read_execute_response(channel, processor, output, err, info);
+}
+
 template <class Stream, class Serializable, class CompletionToken>
 BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
     CompletionToken,
     void(boost::mysql::error_code, boost::mysql::resultset<Stream>)
 )
 boost::mysql::detail::async_execute_generic(
-    deserialize_row_fn deserializer,
+    resultset_encoding encoding,
     channel<Stream>& chan,
     const Serializable& request,
     CompletionToken&& token,
     error_info& info
 )
 {
-    auto processor = std::make_shared<execute_processor>(deserializer, chan.current_capabilities());
+    auto processor = std::make_shared<execute_processor>(encoding, chan.current_capabilities());
     processor->process_request(request);
     return boost::asio::async_compose<
         CompletionToken,
@@ -0,0 +1,390 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_EXECUTE_MANY_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_EXECUTE_MANY_HPP
+
+#include <boost/mysql/detail/network_algorithms/execute_statement.hpp>
+#include <boost/mysql/detail/auxiliar/stringize.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/optional/optional.hpp>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+class execute_many_processor
+{
+    enum class state
+    {
+        response, // expecting the first packet of a response
+        fields,   // skipping field definitions
+        rows      // skipping rows
+    };
+
+    capabilities caps_;
+    std::size_t max_window_requests_;
+    std::size_t max_window_size_;
+    std::uint32_t statement_id_ {0};
+    std::vector<bool> long_data_params_; // only used by the first execution
+    bool first_execution_ {true};
+    bytestring buffer_;  // the requests in the current window, then every response packet
+    bytestring message_; // each request, before being split into packets
+    std::vector<std::uint8_t> response_seqnums_; // first sequence number of each response in the window
+    std::size_t current_response_ {0};
+    state state_ {state::response};
+    std::uint64_t remaining_fields_ {0};
+    std::uint64_t affected_rows_ {0};
+    error_code server_err_; // first error reported by the server
+    error_info ignored_info_; // for errors after the first one
+
+    void finish_response()
+    {
+        ++current_response_;
+        state_ = state::response;
+    }
+
+    void process_server_error(deserialization_context& ctx, error_info& info)
+    {
+        // Report the first error. Further executions may fail because of it
+        if (server_err_)
+        {
+            process_error_packet(ctx, ignored_info_);
+        }
+        else
+        {
+            server_err_ = process_error_packet(ctx, info);
+        }
+    }
+public:
+    execute_many_processor(
+        capabilities caps,
+        std::size_t max_window_requests = execute_many_max_window_requests,
+        std::size_t max_window_size = execute_many_max_window_size
+    ) :
+        caps_(caps),
+        max_window_requests_(max_window_requests),
+        max_window_size_(max_window_size)
+    {
+    }
+
+    // Checks that every parameter set has the right number of parameters,
+    // so that nothing is sent if any of them is wrong. The server
+    // discards long data after the first execution
+    template <class ParamSetCollection>
+    error_code process_requests(
+        std::uint32_t statement_id,
+        unsigned num_params,
+        const ParamSetCollection& param_sets,
+        const std::vector<bool>* long_data_params,
+        error_info& info
+    )
+    {
+        std::size_t index = 0;
+        for (const auto& params: param_sets)
+        {
+            auto param_count = std::distance(std::begin(params), std::end(params));
+            if (param_count != static_cast<decltype(param_count)>(num_params))
+            {
+                info.set_message(stringize(
+                    "prepared_statement::execute_many: expected ", num_params,
+                    " params, but got ", param_count, " in parameter set ", index));
+                return make_error_code(errc::wrong_num_params);
+            }
+            ++index;
+        }
+        statement_id_ = statement_id;
+        if (long_data_params)
+            long_data_params_ = *long_data_params;
+        return error_code();
+    }
+
+    // Serializes a COM_STMT_EXECUTE for each parameter set in [first, last),
+    // until the window is full. Windows are kept small, so the server can always
+    // read the whole window even if we're not reading its responses yet.
+    // Otherwise, both ends could block writing to each other. Returns
+    // an iterator to the first parameter set not serialized.
+    template <class ParamSetIterator>
+    ParamSetIterator serialize_window(ParamSetIterator first, ParamSetIterator last)
+    {
+        assert(!has_pending_responses());
+        buffer_.clear();
+        response_seqnums_.clear();
+        current_response_ = 0;
+        for (; first != last; ++first)
+        {
+            if (response_seqnums_.size() == max_window_requests_ ||
+                (!response_seqnums_.empty() && buffer_.size() >= max_window_size_))
+            {
+                break;
+            }
+            serialize_message(
+                make_stmt_execute_packet(
+                    statement_id_,
+                    std::begin(*first),
+                    std::end(*first),
+                    first_execution_ ? &long_data_params_ : nullptr
+                ),
+                caps_,
+                message_
+            );
+            response_seqnums_.push_back(frame_message(boost::asio::buffer(message_), 0, buffer_));
+            first_execution_ = false;
+        }
+        return first;
+    }
+
+    bytestring& get_buffer() noexcept { return buffer_; }
+
+    bool has_pending_responses() const noexcept { return current_response_ < response_seqnums_.size(); }
+
+    // If set, the channel's sequence number should be reset to this value before the next read
+    boost::optional<std::uint8_t> response_sequence_number() const noexcept
+    {
+        if (state_ != state::response)
+            return {};
+        return response_seqnums_[current_response_];
+    }
+
+    // Processes a packet read into the buffer. Errors reported by the server are
+    // stored and don't interrupt the processing; other errors are returned.
+    // Statements returning rows are accepted, but their rows are discarded.
+    error_code process_packet(error_info& info)
+    {
+        assert(has_pending_responses());
+        if (buffer_.empty())
+            return make_error_code(errc::incomplete_message);
+        deserialization_context ctx (boost::asio::buffer(buffer_), caps_);
+        std::uint8_t msg_type = buffer_[0];
+        switch (state_)
+        {
+        case state::response:
+            if (msg_type == ok_packet_header)
+            {
+                ctx.advance(1);
+                ok_packet ok;
+                auto err = deserialize_message(ctx, ok);
+                if (err)
+                    return err;
+                affected_rows_ += ok.affected_rows.value;
+                finish_response();
+            }
+            else if (msg_type == error_packet_header)
+            {
+                ctx.advance(1);
+                process_server_error(ctx, info);
+                finish_response();
+            }
+            else
+            {
+                int_lenenc num_fields;
+                auto err = deserialize_message(ctx, num_fields);
+                if (err)
+                    return err;
+                if (num_fields.value == 0)
+                    return make_error_code(errc::protocol_value_error);
+                remaining_fields_ = num_fields.value;
+                state_ = state::fields;
+            }
+            break;
+        case state::fields:
+            if (--remaining_fields_ == 0)
+                state_ = state::rows;
+            break;
+        case state::rows:
+            // Binary rows start with a zero byte, so anything else signals the end.
+            // No need to handle multi-packet OK packets, as they don't start with 0xfe
+            if (msg_type == eof_packet_header)
+            {
+                finish_response();
+            }
+            else if (msg_type == error_packet_header)
+            {
+                ctx.advance(1);
+                process_server_error(ctx, info);
+                finish_response();
+            }
+            break;
+        }
+        return error_code();
+    }
+
+    std::uint64_t affected_rows() const noexcept { return affected_rows_; }
+    error_code server_error() const noexcept { return server_err_; }
+};
+
+template<class Stream, class ParamSetIterator>
+struct execute_many_op : boost::asio::coroutine
+{
+    channel<Stream>& chan_;
+    error_info& output_info_;
+    std::shared_ptr<execute_many_processor> processor_;
+    ParamSetIterator next_;
+    ParamSetIterator last_;
+    error_code initial_err_;
+
+    execute_many_op(
+        channel<Stream>& chan,
+        error_info& output_info,
+        std::shared_ptr<execute_many_processor>&& processor,
+        ParamSetIterator first,
+        ParamSetIterator last,
+        error_code initial_err
+    ) :
+        chan_(chan),
+        output_info_(output_info),
+        processor_(std::move(processor)),
+        next_(first),
+        last_(last),
+        initial_err_(initial_err)
+    {
+    }
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        std::size_t = 0
+    )
+    {
+        // Error checking
+        check_cancellation(self, err);
+        if (err)
+        {
+            self.complete(err, processor_->affected_rows());
+            return;
+        }
+
+        // Non-error path
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if (initial_err_ || next_ == last_)
+            {
+                // ensure return as if by post
+                BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+                self.complete(initial_err_, 0);
+                BOOST_ASIO_CORO_YIELD break;
+            }
+
+            while (next_ != last_)
+            {
+                // Send all requests in the window at once
+                next_ = processor_->serialize_window(next_, last_);
+                BOOST_ASIO_CORO_YIELD chan_.async_write_raw(
+                    boost::asio::buffer(processor_->get_buffer()),
+                    std::move(self)
+                );
+
+                // Read their responses
+                while (processor_->has_pending_responses())
+                {
+                    if (processor_->response_sequence_number())
+                        chan_.reset_sequence_number(*processor_->response_sequence_number());
+                    BOOST_ASIO_CORO_YIELD chan_.async_read(processor_->get_buffer(), std::move(self));
+                    err = processor_->process_packet(output_info_);
+                    if (err)
+                    {
+                        self.complete(err, processor_->affected_rows());
+                        BOOST_ASIO_CORO_YIELD break;
+                    }
+                }
+            }
+
+            self.complete(processor_->server_error(), processor_->affected_rows());
+        }
+    }
+};
+
+} // detail
+} // mysql
+} // boost
+
+template <class Stream, class ParamSetCollection>
+std::uint64_t boost::mysql::detail::execute_many(
+    channel<Stream>& chan,
+    std::uint32_t statement_id,
+    unsigned num_params,
+    const ParamSetCollection& param_sets,
+    const std::vector<bool>* long_data_params,
+    error_code& err,
+    error_info& info
+)
+{
+    execute_many_processor processor (chan.current_capabilities());
+    err = processor.process_requests(statement_id, num_params, param_sets, long_data_params, info);
+    if (err)
+        return 0;
+
+    auto next = std::begin(param_sets);
+    auto last = std::end(param_sets);
+    while (next != last)
+    {
+        // Send all requests in the window at once
+        next = processor.serialize_window(next, last);
+        chan.write_raw(boost::asio::buffer(processor.get_buffer()), err);
+        if (err)
+            return processor.affected_rows();
+
+        // Read their responses
+        while (processor.has_pending_responses())
+        {
+            if (processor.response_sequence_number())
+                chan.reset_sequence_number(*processor.response_sequence_number());
+            chan.read(processor.get_buffer(), err);
+            if (err)
+                return processor.affected_rows();
+            err = processor.process_packet(info);
+            if (err)
+                return processor.affected_rows();
+        }
+    }
+
+    err = processor.server_error();
+    return processor.affected_rows();
+}
+
+template <class Stream, class ParamSetCollection, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, std::uint64_t)
+)
+boost::mysql::detail::async_execute_many(
+    channel<Stream>& chan,
+    std::uint32_t statement_id,
+    unsigned num_params,
+    const ParamSetCollection& param_sets,
+    const std::vector<bool>* long_data_params,
+    CompletionToken&& token,
+    error_info& info
+)
+{
+    // Parameter sets are serialized one window at a time, so they must
+    // outlive the operation. Long data is copied into the processor
+    using iterator_type = decltype(std::begin(param_sets));
+    auto processor = std::make_shared<execute_many_processor>(chan.current_capabilities());
+    error_code err = processor->process_requests(statement_id, num_params, param_sets, long_data_params, info);
+    return boost::asio::async_compose<
+        CompletionToken,
+        void(error_code, std::uint64_t)
+    >(
+        execute_many_op<Stream, iterator_type>(
+            chan,
+            info,
+            std::move(processor),
+            std::begin(param_sets),
+            std::end(param_sets),
+            err
+        ),
+        token,
+        chan
+    );
+}
+
+#endif
@@ -0,0 +1,329 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_EXECUTE_ONCE_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_EXECUTE_ONCE_HPP
+
+#include <boost/mysql/detail/network_algorithms/execute_statement.hpp>
+#include <boost/mysql/detail/network_algorithms/prepare_statement.hpp>
+#include <boost/mysql/detail/auxiliar/stringize.hpp>
+#include <iterator>
+#include <memory>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// MariaDB allows referring to the last statement prepared in the
+// connection using this ID, before knowing its actual ID. Supported since 10.2
+constexpr std::uint32_t mariadb_last_statement_id = 0xffffffff;
+constexpr std::uint32_t mariadb_last_statement_id_min_version = 100200;
+
+inline bool supports_last_statement_id(bool is_mariadb, std::uint32_t server_version) noexcept
+{
+    return is_mariadb && server_version >= mariadb_last_statement_id_min_version;
+}
+
+// Offset of the statement ID in framed execute and close requests
+// (packet header + command ID)
+constexpr std::size_t framed_statement_id_offset = 5;
+
+// On MariaDB >= 10.2, the prepare and execute requests are written at once,
+// and both responses read afterwards (one round-trip). On MySQL, the statement
+// ID must be known to execute the statement, so the prepare response is read
+// before writing the execute request (two round-trips). In both cases, the close
+// request is written once the prepare response has been read, using the actual
+// statement ID: if preparing fails, the last statement ID could refer to a statement
+// prepared earlier by the user. All requests are serialized upfront, and the
+// statement ID is patched in when known.
+class execute_once_processor
+{
+    capabilities caps_;
+    bool pipeline_;
+    bytestring requests_; // prepare, execute and close requests, split into packets
+    bytestring message_;  // each request, before being split into packets
+    std::size_t execute_offset_ {0};
+    std::size_t close_offset_ {0};
+    std::size_t num_params_ {0};
+    bytestring buffer_;   // responses to prepare
+    com_stmt_prepare_ok_packet prepare_response_ {};
+
+    template <class Serializable>
+    void append_request(const Serializable& request)
+    {
+        serialize_message(request, caps_, message_);
+        frame_message(boost::asio::buffer(message_), 0, requests_);
+    }
+
+    void set_statement_id(std::size_t request_offset)
+    {
+        serialization_context ctx (caps_, requests_.data() + request_offset + framed_statement_id_offset);
+        serialize(ctx, prepare_response_.statement_id);
+    }
+public:
+    execute_once_processor(capabilities caps, bool pipeline):
+        caps_(caps), pipeline_(pipeline) {}
+
+    // Parameters are serialized here, so they don't need to outlive this call
+    template <class ValueForwardIterator>
+    void process_request(
+        boost::string_view statement,
+        ValueForwardIterator params_begin,
+        ValueForwardIterator params_end
+    )
+    {
+        append_request(com_stmt_prepare_packet{string_eof(statement)});
+        execute_offset_ = requests_.size();
+        append_request(make_stmt_execute_packet(
+            pipeline_ ? mariadb_last_statement_id : 0, params_begin, params_end));
+        close_offset_ = requests_.size();
+        append_request(com_stmt_close_packet{0});
+        num_params_ = static_cast<std::size_t>(std::distance(params_begin, params_end));
+    }
+
+    bool pipeline() const noexcept { return pipeline_; }
+
+    // The requests to write first: prepare and execute if pipelining, prepare otherwise
+    boost::asio::const_buffer first_requests() const noexcept
+    {
+        return boost::asio::buffer(requests_.data(), pipeline_ ? close_offset_ : execute_offset_);
+    }
+
+    // The requests to write after successfully reading the prepare response:
+    // close if pipelining, execute and close otherwise. If the number of parameters
+    // doesn't match, the statement is just closed (MySQL only; MariaDB
+    // reports this as an error in the execute response)
+    boost::asio::const_buffer second_requests(error_code& err, error_info& info)
+    {
+        set_statement_id(close_offset_);
+        if (pipeline_)
+            return boost::asio::buffer(requests_.data() + close_offset_, requests_.size() - close_offset_);
+        set_statement_id(execute_offset_);
+        if (num_params_ != prepare_response_.num_params)
+        {
+            err = make_error_code(errc::wrong_num_params);
+            info.set_message(stringize(
+                "connection::execute_once: expected ", prepare_response_.num_params,
+                " params, but got ", num_params_));
+            return boost::asio::buffer(requests_.data() + close_offset_, requests_.size() - close_offset_);
+        }
+        return boost::asio::buffer(requests_.data() + execute_offset_, requests_.size() - execute_offset_);
+    }
+
+    bytestring& get_buffer() noexcept { return buffer_; }
+
+    // If preparing fails when pipelining, executing fails too.
+    // This error response should then be read and discarded
+    error_code process_prepare_response(error_info& info)
+    {
+        return detail::process_prepare_response(buffer_, caps_, prepare_response_, info);
+    }
+
+    unsigned num_metadata_packets() const noexcept
+    {
+        return prepare_response_.num_columns + prepare_response_.num_params;
+    }
+
+    capabilities get_capabilities() const noexcept { return caps_; }
+};
+
+template <class Stream>
+struct execute_once_op : boost::asio::coroutine
+{
+    channel<Stream>& chan_;
+    error_info& output_info_;
+    std::shared_ptr<execute_once_processor> processor_;
+    unsigned remaining_meta_ {0};
+    error_code err_;
+
+    execute_once_op(
+        channel<Stream>& chan,
+        error_info& output_info,
+        std::shared_ptr<execute_once_processor>&& processor
+    ) :
+        chan_(chan),
+        output_info_(output_info),
+        processor_(std::move(processor))
+    {
+    }
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        std::size_t = 0
+    )
+    {
+        // Error checking
+        check_cancellation(self, err);
+        if (err)
+        {
+            self.complete(err, resultset<Stream>());
+            return;
+        }
+
+        // Non-error path
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            BOOST_ASIO_CORO_YIELD chan_.async_write_raw(processor_->first_requests(), std::move(self));
+
+            // Prepare response
+            chan_.reset_sequence_number(1);
+            BOOST_ASIO_CORO_YIELD chan_.async_read(processor_->get_buffer(), std::move(self));
+            err_ = processor_->process_prepare_response(output_info_);
+            if (err_)
+            {
+                if (processor_->pipeline())
+                {
+                    chan_.reset_sequence_number(1);
+                    BOOST_ASIO_CORO_YIELD chan_.async_read(processor_->get_buffer(), std::move(self));
+                }
+                self.complete(err_, resultset<Stream>());
+                BOOST_ASIO_CORO_YIELD break;
+            }
+
+            // Parameter and field definitions, ignored
+            remaining_meta_ = processor_->num_metadata_packets();
+            for (; remaining_meta_ > 0; --remaining_meta_)
+            {
+                BOOST_ASIO_CORO_YIELD chan_.async_read(processor_->get_buffer(), std::move(self));
+            }
+
+            // Close, and execute if not done yet
+            BOOST_ASIO_CORO_YIELD chan_.async_write_raw(
+                processor_->second_requests(err_, output_info_),
+                std::move(self)
+            );
+            if (err_)
+            {
+                self.complete(err_, resultset<Stream>());
+                BOOST_ASIO_CORO_YIELD break;
+            }
+
+            // Execute response. Close has no response
+            chan_.reset_sequence_number(1);
+            BOOST_ASIO_CORO_YIELD boost::asio::async_compose<Self, void(error_code, resultset<Stream>)>(
+                execute_generic_op<Stream>(
+                    chan_,
+                    output_info_,
+                    std::make_shared<execute_processor>(
+                        resultset_encoding::binary,
+                        processor_->get_capabilities()
+                    ),
+                    false
+                ),
+                self,
+                chan_
+            );
+        }
+    }
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code err,
+        resultset<Stream> result
+    )
+    {
+        self.complete(err, std::move(result));
+    }
+};
+
+} // detail
+} // mysql
+} // boost
+
+template <class Stream, class ValueForwardIterator>
+void boost::mysql::detail::execute_once(
+    channel<Stream>& chan,
+    boost::string_view statement,
+    ValueForwardIterator params_begin,
+    ValueForwardIterator params_end,
+    resultset<Stream>& output,
+    error_code& err,
+    error_info& info
+)
+{
+    execute_once_processor processor (
+        chan.current_capabilities(),
+        supports_last_statement_id(chan.is_mariadb(), chan.server_version())
+    );
+    processor.process_request(statement, params_begin, params_end);
+
+    chan.write_raw(processor.first_requests(), err);
+    if (err)
+        return;
+
+    // Prepare response
+    chan.reset_sequence_number(1);
+    chan.read(processor.get_buffer(), err);
+    if (err)
+        return;
+    err = processor.process_prepare_response(info);
+    if (err)
+    {
+        if (processor.pipeline())
+        {
+            error_code ignored;
+            chan.reset_sequence_number(1);
+            chan.read(processor.get_buffer(), ignored);
+        }
+        return;
+    }
+
+    // Parameter and field definitions, ignored
+    for (unsigned i = 0; i < processor.num_metadata_packets(); ++i)
+    {
+        chan.read(processor.get_buffer(), err);
+        if (err)
+            return;
+    }
+
+    // Close, and execute if not done yet
+    error_code params_err;
+    chan.write_raw(processor.second_requests(params_err, info), err);
+    if (!err)
+        err = params_err;
+    if (err)
+        return;
+
+    // Execute response. Close has no response
+    execute_processor exec_processor (resultset_encoding::binary, chan.current_capabilities());
+    chan.reset_sequence_number(1);
+    read_execute_response(chan, exec_processor, output, err, info);
+}
+
+template <class Stream, class ValueForwardIterator, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, boost::mysql::resultset<Stream>)
+)
+boost::mysql::detail::async_execute_once(
+    channel<Stream>& chan,
+    boost::string_view statement,
+    ValueForwardIterator params_begin,
+    ValueForwardIterator params_end,
+    CompletionToken&& token,
+    error_info& info
+)
+{
+    auto processor = std::make_shared<execute_once_processor>(
+        chan.current_capabilities(),
+        supports_last_statement_id(chan.is_mariadb(), chan.server_version())
+    );
+    processor->process_request(statement, params_begin, params_end);
+    return boost::asio::async_compose<
+        CompletionToken,
+        void(error_code, resultset<Stream>)
+    >(
+        execute_once_op<Stream>(chan, info, std::move(processor)),
+        token,
+        chan
+    );
+}
+
+#endif
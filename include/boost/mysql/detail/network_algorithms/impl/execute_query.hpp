@@ -23,7 +23,7 @@ void boost::mysql::detail::execute_query(
 {
     com_query_packet request { string_eof(query) };
     execute_generic(
-        &deserialize_text_row,
+        resultset_encoding::text,
         channel,
         request,
         output,
@@ -47,7 +47,7 @@ boost::mysql::detail::async_execute_query(
 {
     com_query_packet request { string_eof(query) };
     return async_execute_generic(
-        &deserialize_text_row,
+        resultset_encoding::text,
         chan,
         request,
         std::forward<CompletionToken>(token),
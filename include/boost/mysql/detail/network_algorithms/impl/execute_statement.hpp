@@ -20,7 +20,8 @@ template <class ValueForwardIterator>
 com_stmt_execute_packet<ValueForwardIterator> make_stmt_execute_packet(
     std::uint32_t statement_id,
     ValueForwardIterator params_begin,
-    ValueForwardIterator params_end
+    ValueForwardIterator params_end,
+    const std::vector<bool>* long_data_params = nullptr
 )
 {
     return com_stmt_execute_packet<ValueForwardIterator> {
@@ -29,7 +30,8 @@ com_stmt_execute_packet<ValueForwardIterator> make_stmt_execute_packet(
         std::uint32_t(1), // iteration count
         std::uint8_t(1),  // new params flag: set
         params_begin,
-        params_end
+        params_end,
+        long_data_params
     };
 }
 
@@ -43,15 +45,16 @@ void boost::mysql::detail::execute_statement(
     std::uint32_t statement_id,
     ValueForwardIterator params_begin,
     ValueForwardIterator params_end,
+    const std::vector<bool>* long_data_params,
     resultset<Stream>& output,
     error_code& err,
     error_info& info
 )
 {
     execute_generic(
-        &deserialize_binary_row,
+        resultset_encoding::binary,
         chan,
-        make_stmt_execute_packet(statement_id, params_begin, params_end),
+        make_stmt_execute_packet(statement_id, params_begin, params_end, long_data_params),
         output,
         err,
         info
@@ -68,14 +71,15 @@ boost::mysql::detail::async_execute_statement(
     std::uint32_t statement_id,
     ValueForwardIterator params_begin,
     ValueForwardIterator params_end,
+    const std::vector<bool>* long_data_params,
     CompletionToken&& token,
     error_info& info
 )
 {
     return async_execute_generic(
-        &deserialize_binary_row,
+        resultset_encoding::binary,
         chan,
-        make_stmt_execute_packet(statement_id, params_begin, params_end),
+        make_stmt_execute_packet(statement_id, params_begin, params_end, long_data_params),
         std::forward<CompletionToken>(token),
         info
     );
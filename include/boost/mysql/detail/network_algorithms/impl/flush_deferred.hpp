@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_FLUSH_DEFERRED_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_FLUSH_DEFERRED_HPP
+
+#include <boost/asio/post.hpp>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+template <class Stream>
+struct flush_deferred_op : boost::asio::coroutine
+{
+    channel<Stream>& chan_;
+
+    flush_deferred_op(channel<Stream>& chan) : chan_(chan) {}
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        std::size_t = 0
+    )
+    {
+        check_cancellation(self, err);
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if (chan_.has_pending_writes())
+            {
+                BOOST_ASIO_CORO_YIELD chan_.async_write_raw(boost::asio::const_buffer(), std::move(self));
+            }
+            else
+            {
+                // Nothing to do. Ensure return as if by post
+                BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+            }
+            self.complete(err);
+        }
+    }
+};
+
+} // detail
+} // mysql
+} // boost
+
+template <class Stream>
+void boost::mysql::detail::flush_deferred(
+    channel<Stream>& chan,
+    error_code& code,
+    error_info&
+)
+{
+    if (chan.has_pending_writes())
+        chan.write_raw(boost::asio::const_buffer(), code);
+}
+
+template <class Stream, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::detail::async_flush_deferred(
+    channel<Stream>& chan,
+    CompletionToken&& token,
+    error_info&
+)
+{
+    return boost::asio::async_compose<CompletionToken, void(error_code)>(
+        flush_deferred_op<Stream>(chan),
+        token,
+        chan
+    );
+}
+
+#endif
@@ -12,6 +12,7 @@
 #include <boost/mysql/detail/protocol/capabilities.hpp>
 #include <boost/mysql/detail/protocol/handshake_messages.hpp>
 #include <boost/mysql/detail/auth/auth_calculator.hpp>
+#include <boost/mysql/detail/auth/server_public_key_cache.hpp>
 
 namespace boost {
 namespace mysql {
@@ -22,6 +23,38 @@ inline std::uint8_t get_collation_first_byte(collation value)
     return static_cast<std::uint16_t>(value) % 0xff;
 }
 
+// Parses a server version string (e.g. 8.0.27 or 10.6.4-MariaDB) into
+// major * 10000 + minor * 100 + patch. MariaDB may prefix it with 5.5.5-
+// for compatibility with old replication clients. Returns zero on failure
+inline std::uint32_t parse_server_version(boost::string_view value) noexcept
+{
+    boost::string_view mariadb_prefix ("5.5.5-");
+    if (value.substr(0, mariadb_prefix.size()) == mariadb_prefix)
+        value.remove_prefix(mariadb_prefix.size());
+    std::uint32_t res = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        std::uint32_t component = 0;
+        std::size_t num_digits = 0;
+        for (; num_digits < value.size() && num_digits < 2 &&
+                value[num_digits] >= '0' && value[num_digits] <= '9'; ++num_digits)
+        {
+            component = component * 10 + static_cast<std::uint32_t>(value[num_digits] - '0');
+        }
+        if (num_digits == 0)
+            return 0;
+        value.remove_prefix(num_digits);
+        res = res * 100 + component;
+        if (i < 2)
+        {
+            if (value.empty() || value[0] != '.')
+                return 0;
+            value.remove_prefix(1);
+        }
+    }
+    return res;
+}
+
 inline capabilities conditional_capability(bool condition, std::uint32_t cap)
 {
     return capabilities(condition ? cap : 0);
@@ -74,14 +107,105 @@ enum class auth_result
 class handshake_processor
 {
     connection_params params_;
+    bool local_infile_;
+    boost::string_view endpoint_; // to cache the server RSA public key
     capabilities negotiated_caps_;
+    bool is_mariadb_ {false};
+    std::uint32_t connection_id_ {0};
+    std::uint16_t status_flags_ {0};
+    std::uint32_t server_version_ {0};
     auth_calculator auth_calc_;
+    std::string scramble_; // challenge sent when selecting the auth plugin
+    bytestring rsa_response_;
+    bool waiting_public_key_ {false};
+    bool used_cached_key_ {false};
+
+    // caching_sha2_password can't send the password in cleartext without SSL,
+    // so it encrypts it using the server RSA public key. The key must have been
+    // configured, or the user must have explicitly allowed requesting it, as
+    // it can't be authenticated. Otherwise, the handshake fails with
+    // auth_plugin_requires_ssl.
+    bool requires_rsa(boost::string_view challenge) const
+    {
+        return challenge == caching_sha2_password::perform_full_auth &&
+            !use_ssl() &&
+            (!params_.server_public_key().empty() || params_.request_server_public_key()) &&
+            !(params_.password_hashes() ? params_.password_hashes()->empty() : params_.password().empty()) &&
+            auth_calc_.plugin_name() == caching_sha2_password_plugin.name;
+    }
+
+    void compose_rsa_response(bytestring& buffer)
+    {
+        serialize_message(
+            auth_switch_response_packet {string_eof(boost::string_view(
+                reinterpret_cast<const char*>(rsa_response_.data()),
+                rsa_response_.size()
+            ))},
+            negotiated_caps_,
+            buffer
+        );
+    }
+
+    // Encrypts the password with the configured or cached key. If there is none,
+    // asks the server for its key
+    error_code process_rsa_full_auth(bytestring& buffer)
+    {
+        if (params_.password().empty())
+            return make_error_code(errc::cleartext_password_unavailable); // only hashes were provided
+        boost::string_view key = params_.server_public_key();
+        std::string cached_key;
+        if (key.empty() && !endpoint_.empty() && params_.request_server_public_key() &&
+            server_public_key_cache::instance().get(endpoint_, cached_key))
+        {
+            key = cached_key;
+            used_cached_key_ = true;
+        }
+
+        if (key.empty())
+        {
+            rsa_response_.assign(1, caching_sha2_password::request_public_key);
+            waiting_public_key_ = true;
+        }
+        else
+        {
+            auto err = caching_sha2_password::compute_rsa_response(
+                params_.password(), scramble_, key, rsa_response_);
+            if (err)
+                return err;
+        }
+        compose_rsa_response(buffer);
+        return error_code();
+    }
+
+    // key points into buffer
+    error_code process_public_key(boost::string_view key, bytestring& buffer)
+    {
+        waiting_public_key_ = false;
+        if (!endpoint_.empty())
+            server_public_key_cache::instance().put(endpoint_, key);
+        auto err = caching_sha2_password::compute_rsa_response(
+            params_.password(), scramble_, key, rsa_response_);
+        if (err)
+            return err;
+        compose_rsa_response(buffer);
+        return error_code();
+    }
 public:
-    handshake_processor(const connection_params& params): params_(params) {};
+    handshake_processor(const connection_params& params, bool local_infile, boost::string_view endpoint = {}):
+        params_(params), local_infile_(local_infile), endpoint_(endpoint) {};
     capabilities negotiated_capabilities() const noexcept { return negotiated_caps_; }
+    bool is_mariadb() const noexcept { return is_mariadb_; }
+    std::uint32_t connection_id() const noexcept { return connection_id_; }
+    std::uint16_t status_flags() const noexcept { return status_flags_; }
+    std::uint32_t server_version() const noexcept { return server_version_; }
+    collation connection_collation() const noexcept { return params_.connection_collation(); }
     const connection_params& params() const noexcept { return params_; }
     bool use_ssl() const noexcept { return negotiated_caps_.has(CLIENT_SSL); }
 
+    // Authentication state, to be stored in the channel once authentication completes
+    boost::string_view auth_plugin() const noexcept { return auth_calc_.plugin_name(); }
+    const std::string& scramble() const noexcept { return scramble_; }
+
     // Initial greeting processing
     error_code process_capabilities(const handshake_packet& handshake)
     {
@@ -95,7 +219,8 @@ public:
             return make_error_code(errc::server_unsupported);
         }
         negotiated_caps_ = server_caps & (required_caps | optional_capabilities |
-                conditional_capability(ssl == ssl_mode::enable, CLIENT_SSL));
+                conditional_capability(ssl == ssl_mode::enable, CLIENT_SSL) |
+                conditional_capability(local_infile_, CLIENT_LOCAL_FILES));
         return error_code();
     }
 
@@ -107,17 +232,25 @@ public:
         if (err)
             return err;
 
+        // MariaDB reports itself in the version string (e.g. 5.5.5-10.6.4-MariaDB)
+        is_mariadb_ = handshake.server_version.value.find("MariaDB") != boost::string_view::npos;
+        connection_id_ = handshake.connection_id;
+        server_version_ = parse_server_version(handshake.server_version.value);
+        status_flags_ = handshake.status_flags;
+
         // Check capabilities
         err = process_capabilities(handshake);
         if (err)
             return err;
 
         // Compute auth response
+        scramble_ = handshake.auth_plugin_data.value().to_string();
         return auth_calc_.calculate(
             handshake.auth_plugin_name.value,
             params_.password(),
-            handshake.auth_plugin_data.value(),
-            use_ssl()
+            scramble_,
+            use_ssl(),
+            params_.password_hashes()
         );
     }
 
@@ -152,6 +285,39 @@ public:
         serialize_message(response, negotiated_caps_, buffer);
     }
 
+    // COM_CHANGE_USER, over an already established connection. The response
+    // is computed using the plugin and challenge from the last authentication.
+    // The server response is processed as a handshake response
+    error_code compose_change_user(
+        capabilities caps,
+        boost::string_view plugin_name,
+        boost::string_view scramble,
+        bytestring& buffer
+    )
+    {
+        negotiated_caps_ = caps;
+        scramble_ = scramble.to_string();
+        auto err = auth_calc_.calculate(
+            plugin_name,
+            params_.password(),
+            scramble_,
+            use_ssl(),
+            params_.password_hashes()
+        );
+        if (err)
+            return err;
+
+        com_change_user_packet request {
+            string_null(params_.username()),
+            string_lenenc(auth_calc_.response()),
+            string_null(params_.database()),
+            static_cast<std::uint16_t>(params_.connection_collation()),
+            string_null(auth_calc_.plugin_name())
+        };
+        serialize_message(request, negotiated_caps_, buffer);
+        return error_code();
+    }
+
     // Server handshake response
     error_code process_handshake_server_response(
         bytestring& buffer,
@@ -167,11 +333,19 @@ public:
         if (msg_type == ok_packet_header)
         {
             // Auth success via fast auth path
+            ok_packet ok;
+            err = deserialize_message(ctx, ok);
+            if (err)
+                return err;
+            status_flags_ = ok.status_flags;
             result = auth_result::complete;
             return error_code();
         }
         else if (msg_type == error_packet_header)
         {
+            // The server may have changed its key since we cached it
+            if (used_cached_key_)
+                server_public_key_cache::instance().erase(endpoint_);
             return process_error_packet(ctx, info);
         }
         else if (msg_type == auth_switch_request_header)
@@ -183,11 +357,13 @@ public:
                 return err;
 
             // Compute response
+            scramble_ = auth_sw.auth_plugin_data.value.to_string();
             err = auth_calc_.calculate(
                 auth_sw.plugin_name.value,
                 params_.password(),
-                auth_sw.auth_plugin_data.value,
-                use_ssl()
+                scramble_,
+                use_ssl(),
+                params_.password_hashes()
             );
             if (err)
                 return err;
@@ -211,18 +387,30 @@ public:
                 return err;
 
             boost::string_view challenge = more_data.auth_plugin_data.value;
+            if (waiting_public_key_)
+            {
+                // The server sent its RSA public key, as we requested
+                result = auth_result::send_more_data;
+                return process_public_key(challenge, buffer);
+            }
             if (challenge == fast_auth_complete_challenge)
             {
                 result = auth_result::wait_for_ok;
                 return error_code();
             }
+            if (requires_rsa(challenge))
+            {
+                result = auth_result::send_more_data;
+                return process_rsa_full_auth(buffer);
+            }
 
             // Compute response
             err = auth_calc_.calculate(
                 auth_calc_.plugin_name(),
                 params_.password(),
                 challenge,
-                use_ssl()
+                use_ssl(),
+                params_.password_hashes()
             );
             if (err)
                 return err;
@@ -258,7 +446,11 @@ struct handshake_op : boost::asio::coroutine
     ) :
         chan_(channel),
         output_info_(output_info),
-        processor_(params)
+        processor_(
+            params,
+            static_cast<bool>(channel.get_local_infile_handler()),
+            channel.endpoint_key()
+        )
     {
     }
 
@@ -269,6 +461,7 @@ struct handshake_op : boost::asio::coroutine
     )
     {
         // Error checking
+        check_cancellation(self, err);
         if (err)
         {
             self.complete(err);
@@ -289,6 +482,9 @@ struct handshake_op : boost::asio::coroutine
                 BOOST_ASIO_CORO_YIELD break;
             }
             chan_.set_current_capabilities(processor_.negotiated_capabilities());
+            chan_.set_mariadb(processor_.is_mariadb());
+            chan_.set_server_version(processor_.server_version());
+            chan_.set_connection_id(processor_.connection_id());
 
             // SSL
             if (processor_.use_ssl())
@@ -329,6 +525,9 @@ struct handshake_op : boost::asio::coroutine
                 }
             }
 
+            chan_.set_auth_state(processor_.auth_plugin(), processor_.scramble());
+            chan_.set_connection_collation(processor_.connection_collation());
+            chan_.set_status_flags(processor_.status_flags());
             self.complete(error_code());
         }
     }
@@ -349,7 +548,11 @@ void boost::mysql::detail::handshake(
     channel.reset();
 
     // Set up processor
-    handshake_processor processor (params);
+    handshake_processor processor (
+        params,
+        static_cast<bool>(channel.get_local_infile_handler()),
+        channel.endpoint_key()
+    );
 
     // Read server greeting
     channel.read(channel.shared_buffer(), err);
@@ -405,6 +608,12 @@ void boost::mysql::detail::handshake(
     };
 
     channel.set_current_capabilities(processor.negotiated_capabilities());
+    channel.set_mariadb(processor.is_mariadb());
+    channel.set_server_version(processor.server_version());
+    channel.set_connection_id(processor.connection_id());
+    channel.set_connection_collation(processor.connection_collation());
+    channel.set_status_flags(processor.status_flags());
+    channel.set_auth_state(processor.auth_plugin(), processor.scramble());
 }
 
 template <class Stream, class CompletionToken>
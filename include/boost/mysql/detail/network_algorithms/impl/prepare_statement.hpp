@@ -12,6 +12,33 @@ namespace boost {
 namespace mysql {
 namespace detail {
 
+inline error_code process_prepare_response(
+    const bytestring& buffer,
+    capabilities caps,
+    com_stmt_prepare_ok_packet& output,
+    error_info& info
+)
+{
+    deserialization_context ctx (boost::asio::buffer(buffer), caps);
+    std::uint8_t msg_type = 0;
+    auto err = make_error_code(deserialize(ctx, msg_type));
+    if (err)
+        return err;
+
+    if (msg_type == error_packet_header)
+    {
+        return process_error_packet(ctx, info);
+    }
+    else if (msg_type != 0)
+    {
+        return make_error_code(errc::protocol_value_error);
+    }
+    else
+    {
+        return deserialize_message(ctx, output);
+    }
+}
+
 template <class Stream>
 class prepare_statement_processor
 {
@@ -27,27 +54,12 @@ public:
     }
     void process_response(error_code& err, error_info& info)
     {
-        deserialization_context ctx (
-            boost::asio::buffer(channel_.shared_buffer()),
-            channel_.current_capabilities()
+        err = process_prepare_response(
+            channel_.shared_buffer(),
+            channel_.current_capabilities(),
+            response_,
+            info
         );
-        std::uint8_t msg_type = 0;
-        err = make_error_code(deserialize(ctx, msg_type));
-        if (err)
-            return;
-
-        if (msg_type == error_packet_header)
-        {
-            err = process_error_packet(ctx, info);
-        }
-        else if (msg_type != 0)
-        {
-            err = make_error_code(errc::protocol_value_error);
-        }
-        else
-        {
-            err = deserialize_message(ctx, response_);
-        }
     }
     bytestring& get_buffer() noexcept { return channel_.shared_buffer(); }
     channel<Stream>& get_channel() noexcept { return channel_; }
@@ -84,6 +96,7 @@ struct prepare_statement_op : boost::asio::coroutine
     )
     {
         // Error checking
+        check_cancellation(self, err);
         if (err)
         {
             self.complete(err, prepared_statement<Stream>());
@@ -9,24 +9,36 @@
 #define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_READ_ROW_HPP
 
 #include <boost/mysql/detail/protocol/text_deserialization.hpp>
+#include <boost/mysql/detail/protocol/binary_deserialization.hpp>
 
 namespace boost {
 namespace mysql {
 namespace detail {
 
-inline read_row_result process_read_message(
-    deserialize_row_fn deserializer,
+inline error_code deserialize_row(
+    resultset_encoding encoding,
+    deserialization_context& ctx,
+    const std::vector<field_metadata>& meta,
+    row& output
+)
+{
+    return encoding == resultset_encoding::text ?
+        deserialize_text_row(ctx, meta, output.values()) :
+        deserialize_binary_row(ctx, meta, output.values());
+}
+
+template <class RowType>
+read_row_result process_read_message(
+    resultset_encoding encoding,
     capabilities current_capabilities,
     const std::vector<field_metadata>& meta,
-	row& output,
+	RowType& output,
     bytestring& ok_packet_buffer,
     ok_packet& output_ok_packet,
     error_code& err,
     error_info& info
 )
 {
-    assert(deserializer);
-
     // Message type: row, error or eof?
     std::uint8_t msg_type = 0;
     deserialization_context ctx (boost::asio::buffer(output.buffer()), current_capabilities);
@@ -40,8 +52,7 @@ inline read_row_result process_read_message(
         if (err)
             return read_row_result::error;
         std::swap(output.buffer(), ok_packet_buffer);
-        output.buffer().clear();
-        output.values().clear();
+        output.clear();
         return read_row_result::eof;
     }
     else if (msg_type == error_packet_header)
@@ -54,36 +65,36 @@ inline read_row_result process_read_message(
     {
         // An actual row
         ctx.rewind(1); // keep the 'message type' byte, as it is part of the actual message
-        err = deserializer(ctx, meta, output.values());
+        err = deserialize_row(encoding, ctx, meta, output);
         if (err)
             return read_row_result::error;
         return read_row_result::row;
     }
 }
 
-template<class Stream>
+template<class Stream, class RowType>
 struct read_row_op : boost::asio::coroutine
 {
     channel<Stream>& chan_;
     error_info& output_info_;
-    deserialize_row_fn deserializer_;
+    resultset_encoding encoding_;
     const std::vector<field_metadata>& meta_;
-    row& output_;
+    RowType& output_;
     bytestring& ok_packet_buffer_;
     ok_packet& output_ok_packet_;
 
     read_row_op(
         channel<Stream>& chan,
         error_info& output_info,
-        deserialize_row_fn deserializer,
+        resultset_encoding encoding,
         const std::vector<field_metadata>& meta,
-		row& output,
+		RowType& output,
         bytestring& ok_packet_buffer,
         ok_packet& output_ok_packet
     ) :
         chan_(chan),
         output_info_(output_info),
-        deserializer_(deserializer),
+        encoding_(encoding),
         meta_(meta),
 		output_(output),
         ok_packet_buffer_(ok_packet_buffer),
@@ -100,6 +111,7 @@ struct read_row_op : boost::asio::coroutine
         read_row_result result = read_row_result::error;
 
         // Error checking
+        check_cancellation(self, err);
         if (err)
         {
             self.complete(err, result);
@@ -114,7 +126,7 @@ struct read_row_op : boost::asio::coroutine
 
             // Process it
             result = process_read_message(
-                deserializer_,
+                encoding_,
                 chan_.current_capabilities(),
                 meta_,
 				output_,
@@ -133,12 +145,12 @@ struct read_row_op : boost::asio::coroutine
 } // boost
 
 
-template <class Stream>
+template <class Stream, class RowType>
 boost::mysql::detail::read_row_result boost::mysql::detail::read_row(
-    deserialize_row_fn deserializer,
+    resultset_encoding encoding,
     channel<Stream>& channel,
     const std::vector<field_metadata>& meta,
-	row& output,
+	RowType& output,
     bytestring& ok_packet_buffer,
     ok_packet& output_ok_packet,
     error_code& err,
@@ -151,7 +163,7 @@ boost::mysql::detail::read_row_result boost::mysql::detail::read_row(
         return read_row_result::error;
 
     return process_read_message(
-        deserializer,
+        encoding,
         channel.current_capabilities(),
         meta,
 		output,
@@ -162,16 +174,16 @@ boost::mysql::detail::read_row_result boost::mysql::detail::read_row(
     );
 }
 
-template <class Stream, class CompletionToken>
+template <class Stream, class RowType, class CompletionToken>
 BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
     CompletionToken,
     void(boost::mysql::error_code, boost::mysql::detail::read_row_result)
 )
 boost::mysql::detail::async_read_row(
-    deserialize_row_fn deserializer,
+    resultset_encoding encoding,
     channel<Stream>& chan,
     const std::vector<field_metadata>& meta,
-	row& output,
+	RowType& output,
     bytestring& ok_packet_buffer,
     ok_packet& output_ok_packet,
     CompletionToken&& token,
@@ -179,10 +191,10 @@ boost::mysql::detail::async_read_row(
 )
 {
     return boost::asio::async_compose<CompletionToken, void(error_code, read_row_result)> (
-        read_row_op<Stream>(
+        read_row_op<Stream, RowType>(
             chan,
             output_info,
-            deserializer,
+            encoding,
             meta,
 			output,
             ok_packet_buffer,
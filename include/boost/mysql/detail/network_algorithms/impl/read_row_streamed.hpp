@@ -0,0 +1,648 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_READ_ROW_STREAMED_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_READ_ROW_STREAMED_HPP
+
+#include <boost/mysql/detail/protocol/text_deserialization.hpp>
+#include <boost/mysql/detail/protocol/binary_deserialization.hpp>
+#include <boost/mysql/detail/protocol/null_bitmap_traits.hpp>
+#include <boost/asio/post.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Rows are read in pieces of at least this size, until the last field is reached
+constexpr std::size_t streamed_row_min_read_size = 512;
+
+// In the binary protocol, only length-encoded values can be streamed
+inline bool is_binary_streamable(const field_metadata& meta) noexcept
+{
+    switch (meta.protocol_type())
+    {
+    case protocol_field_type::tiny:
+    case protocol_field_type::short_:
+    case protocol_field_type::year:
+    case protocol_field_type::int24:
+    case protocol_field_type::long_:
+    case protocol_field_type::float_:
+    case protocol_field_type::longlong:
+    case protocol_field_type::double_:
+    case protocol_field_type::timestamp:
+    case protocol_field_type::datetime:
+    case protocol_field_type::date:
+    case protocol_field_type::time:
+        return false;
+    default:
+        return true;
+    }
+}
+
+inline errc deserialize_streamed_field_header(
+    deserialization_context& ctx,
+    value& output,
+    std::uint64_t& size
+)
+{
+    int_lenenc length;
+    errc err = deserialize(ctx, length);
+    if (err != errc::ok)
+        return err;
+    output = value(boost::string_view());
+    size = length.value;
+    return errc::ok;
+}
+
+// Deserializes all fields but the last one from a row message that may
+// have been partially read, and the length of the last one. Leaves ctx pointing
+// to the first byte of the last field's contents. Returns incomplete_message if
+// more bytes are required.
+inline error_code deserialize_text_row_prefix(
+    deserialization_context& ctx,
+    const std::vector<field_metadata>& meta,
+    std::vector<value>& output,
+    std::uint64_t& last_size
+)
+{
+    for (std::size_t i = 0; i < meta.size(); ++i)
+    {
+        if (!ctx.enough_size(1))
+            return make_error_code(errc::incomplete_message);
+        bool is_last = i == meta.size() - 1;
+        if (*ctx.first() == 0xfb) // NULL
+        {
+            ctx.advance(1);
+            output[i] = value(nullptr);
+        }
+        else if (is_last)
+        {
+            errc err = deserialize_streamed_field_header(ctx, output[i], last_size);
+            if (err != errc::ok)
+                return make_error_code(err);
+        }
+        else
+        {
+            string_lenenc value_str;
+            errc err = deserialize(ctx, value_str);
+            if (err != errc::ok)
+                return make_error_code(err);
+            err = deserialize_text_value(value_str.value, meta[i], output[i]);
+            if (err != errc::ok)
+                return make_error_code(err);
+        }
+    }
+    return error_code();
+}
+
+inline error_code deserialize_binary_row_prefix(
+    deserialization_context& ctx,
+    const std::vector<field_metadata>& meta,
+    std::vector<value>& output,
+    std::uint64_t& last_size
+)
+{
+    // Skip packet header. The caller will have checked we have this byte already for us
+    assert(ctx.enough_size(1));
+    ctx.advance(1);
+
+    // Null bitmap
+    null_bitmap_traits null_bitmap (binary_row_null_bitmap_offset, meta.size());
+    const std::uint8_t* null_bitmap_begin = ctx.first();
+    if (!ctx.enough_size(null_bitmap.byte_count()))
+        return make_error_code(errc::incomplete_message);
+    ctx.advance(null_bitmap.byte_count());
+
+    for (std::size_t i = 0; i < meta.size(); ++i)
+    {
+        bool is_last = i == meta.size() - 1;
+        if (null_bitmap.is_null(null_bitmap_begin, i))
+        {
+            output[i] = value(nullptr);
+        }
+        else if (is_last)
+        {
+            if (!is_binary_streamable(meta[i]))
+                return make_error_code(errc::field_not_streamable);
+            errc err = deserialize_streamed_field_header(ctx, output[i], last_size);
+            if (err != errc::ok)
+                return make_error_code(err);
+        }
+        else
+        {
+            std::size_t size = 0;
+            errc err = binary_value_size(ctx, meta[i], size); // checks we have enough bytes
+            if (err != errc::ok)
+                return make_error_code(err);
+            err = deserialize_binary_value(ctx, meta[i], output[i]);
+            if (err != errc::ok)
+                return make_error_code(err);
+        }
+    }
+    return error_code();
+}
+
+inline error_code deserialize_row_prefix(
+    resultset_encoding encoding,
+    deserialization_context& ctx,
+    const std::vector<field_metadata>& meta,
+    std::vector<value>& output,
+    std::uint64_t& last_size
+)
+{
+    assert(!meta.empty());
+    output.resize(meta.size());
+    last_size = 0;
+    return encoding == resultset_encoding::text ?
+        deserialize_text_row_prefix(ctx, meta, output, last_size) :
+        deserialize_binary_row_prefix(ctx, meta, output, last_size);
+}
+
+// Grows the row buffer to read the next piece of the row
+inline boost::asio::mutable_buffer prepare_streamed_row_read(
+    row& output,
+    streamed_field_state& state
+)
+{
+    bytestring& buff = output.buffer();
+    std::size_t old_size = buff.size();
+    state.read_size = (std::max)(streamed_row_min_read_size, old_size);
+    buff.resize(old_size + state.read_size);
+    return boost::asio::buffer(buff.data() + old_size, state.read_size);
+}
+
+inline void commit_streamed_row_read(
+    row& output,
+    const streamed_field_state& state,
+    std::size_t bytes_read
+)
+{
+    bytestring& buff = output.buffer();
+    buff.resize(buff.size() - state.read_size + bytes_read);
+}
+
+// Processes the bytes of a row read so far. Returns false if more bytes are required.
+// first_packet_size is the size of the message's first packet, as reported by the channel
+inline bool process_streamed_row(
+    resultset_encoding encoding,
+    capabilities current_capabilities,
+    const std::vector<field_metadata>& meta,
+    row& output,
+    bool message_done,
+    std::uint32_t first_packet_size,
+    bytestring& ok_packet_buffer,
+    ok_packet& output_ok_packet,
+    streamed_field_state& state,
+    read_row_result& result,
+    error_code& err,
+    error_info& info
+)
+{
+    bytestring& buff = output.buffer();
+    result = read_row_result::error;
+    if (buff.empty())
+    {
+        if (!message_done)
+            return false;
+        err = make_error_code(errc::incomplete_message);
+        return true;
+    }
+
+    // OK and error packets are small, so they are read entirely and processed as usual.
+    // A text row whose first field is 16MB or bigger also starts with 0xfe (the field's
+    // length prefix), but it spans several packets, while an OK packet can't
+    std::uint8_t msg_type = buff[0];
+    bool is_eof = msg_type == eof_packet_header && first_packet_size < MAX_PACKET_SIZE;
+    if (is_eof || msg_type == error_packet_header)
+    {
+        if (!message_done)
+            return false;
+        result = process_read_message(
+            encoding,
+            current_capabilities,
+            meta,
+            output,
+            ok_packet_buffer,
+            output_ok_packet,
+            err,
+            info
+        );
+        return true;
+    }
+
+    // An actual row. Try to deserialize everything but the streamed field
+    deserialization_context ctx (boost::asio::buffer(buff), current_capabilities);
+    std::uint64_t last_size = 0;
+    err = deserialize_row_prefix(encoding, ctx, meta, output.values(), last_size);
+    if (err == make_error_code(errc::incomplete_message) && !message_done)
+    {
+        err.clear();
+        return false;
+    }
+    if (err)
+        return true;
+
+    // Any bytes after that belong to the streamed field
+    std::size_t prefix_size = ctx.first() - buff.data();
+    state.buffered.assign(buff.begin() + prefix_size, buff.end());
+    state.buffered_offset = 0;
+    state.remaining = last_size;
+    buff.resize(prefix_size); // doesn't invalidate the values pointing into the buffer
+    if (state.buffered.size() > last_size)
+    {
+        err = make_error_code(errc::extra_bytes);
+        return true;
+    }
+    result = read_row_result::row;
+    return true;
+}
+
+inline bool has_streamed_buffered(const streamed_field_state& state) noexcept
+{
+    return state.buffered_offset < state.buffered.size();
+}
+
+// Serves field bytes read together with the row
+inline std::size_t consume_streamed_buffered(
+    streamed_field_state& state,
+    boost::asio::mutable_buffer buffer
+)
+{
+    std::size_t size = (std::min)(buffer.size(), state.buffered.size() - state.buffered_offset);
+    std::memcpy(buffer.data(), state.buffered.data() + state.buffered_offset, size);
+    state.buffered_offset += size;
+    state.remaining -= size;
+    return size;
+}
+
+// Where to read field bytes from the network into
+inline boost::asio::mutable_buffer streamed_read_buffer(
+    const streamed_field_state& state,
+    boost::asio::mutable_buffer buffer
+)
+{
+    return boost::asio::buffer(
+        buffer,
+        static_cast<std::size_t>((std::min)(static_cast<std::uint64_t>(buffer.size()), state.remaining))
+    );
+}
+
+// Once the field has been read, the message should have ended
+template <class Stream>
+void check_streamed_field_end(
+    channel<Stream>& chan,
+    streamed_field_state& state,
+    error_code& err
+)
+{
+    if (!chan.partial_read_done())
+    {
+        std::size_t extra = chan.read_partial(boost::asio::buffer(&state.end_check, 1), err);
+        if (!err && extra)
+            err = make_error_code(errc::extra_bytes);
+    }
+}
+
+template<class Stream>
+struct read_row_streamed_op : boost::asio::coroutine
+{
+    channel<Stream>& chan_;
+    error_info& output_info_;
+    resultset_encoding encoding_;
+    const std::vector<field_metadata>& meta_;
+    row& output_;
+    bytestring& ok_packet_buffer_;
+    ok_packet& output_ok_packet_;
+    streamed_field_state& state_;
+    read_row_result result_ {read_row_result::error};
+
+    read_row_streamed_op(
+        channel<Stream>& chan,
+        error_info& output_info,
+        resultset_encoding encoding,
+        const std::vector<field_metadata>& meta,
+        row& output,
+        bytestring& ok_packet_buffer,
+        ok_packet& output_ok_packet,
+        streamed_field_state& state
+    ) :
+        chan_(chan),
+        output_info_(output_info),
+        encoding_(encoding),
+        meta_(meta),
+        output_(output),
+        ok_packet_buffer_(ok_packet_buffer),
+        output_ok_packet_(output_ok_packet),
+        state_(state)
+    {
+    }
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        std::size_t bytes_transferred = 0
+    )
+    {
+        // Error checking
+        check_cancellation(self, err);
+        if (err)
+        {
+            self.complete(err, read_row_result::error);
+            return;
+        }
+
+        // Normal path
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            state_.reset();
+            output_.buffer().clear();
+            chan_.start_partial_read();
+
+            // Read until we get to the streamed field
+            do
+            {
+                BOOST_ASIO_CORO_YIELD chan_.async_read_partial(
+                    prepare_streamed_row_read(output_, state_),
+                    std::move(self)
+                );
+                commit_streamed_row_read(output_, state_, bytes_transferred);
+            } while (!process_streamed_row(
+                encoding_,
+                chan_.current_capabilities(),
+                meta_,
+                output_,
+                chan_.partial_read_done(),
+                chan_.partial_first_packet_size(),
+                ok_packet_buffer_,
+                output_ok_packet_,
+                state_,
+                result_,
+                err,
+                output_info_
+            ));
+
+            // If the field is empty, the message should end here
+            if (!err && result_ == read_row_result::row &&
+                state_.remaining == 0 && !chan_.partial_read_done())
+            {
+                BOOST_ASIO_CORO_YIELD chan_.async_read_partial(
+                    boost::asio::buffer(&state_.end_check, 1),
+                    std::move(self)
+                );
+                if (bytes_transferred)
+                    err = make_error_code(errc::extra_bytes);
+            }
+
+            self.complete(err, err ? read_row_result::error : result_);
+        }
+    }
+};
+
+template<class Stream>
+struct read_streamed_chunk_op : boost::asio::coroutine
+{
+    channel<Stream>& chan_;
+    streamed_field_state& state_;
+    boost::asio::mutable_buffer buffer_;
+    std::size_t size_ {0};
+    bool io_performed_ {false};
+
+    read_streamed_chunk_op(
+        channel<Stream>& chan,
+        streamed_field_state& state,
+        boost::asio::mutable_buffer buffer
+    ) :
+        chan_(chan),
+        state_(state),
+        buffer_(buffer)
+    {
+    }
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        std::size_t bytes_transferred = 0
+    )
+    {
+        // Error checking
+        check_cancellation(self, err);
+        if (err)
+        {
+            self.complete(err, 0);
+            return;
+        }
+
+        // Normal path
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if (state_.remaining != 0)
+            {
+                if (has_streamed_buffered(state_))
+                {
+                    size_ = consume_streamed_buffered(state_, buffer_);
+                }
+                else
+                {
+                    io_performed_ = true;
+                    BOOST_ASIO_CORO_YIELD chan_.async_read_partial(
+                        streamed_read_buffer(state_, buffer_),
+                        std::move(self)
+                    );
+                    if (bytes_transferred == 0)
+                    {
+                        self.complete(make_error_code(errc::incomplete_message), 0);
+                        BOOST_ASIO_CORO_YIELD break;
+                    }
+                    size_ = bytes_transferred;
+                    state_.remaining -= size_;
+                }
+
+                // Once the field has been read, the message should end
+                if (state_.remaining == 0 && !chan_.partial_read_done())
+                {
+                    io_performed_ = true;
+                    BOOST_ASIO_CORO_YIELD chan_.async_read_partial(
+                        boost::asio::buffer(&state_.end_check, 1),
+                        std::move(self)
+                    );
+                    if (bytes_transferred)
+                    {
+                        self.complete(make_error_code(errc::extra_bytes), 0);
+                        BOOST_ASIO_CORO_YIELD break;
+                    }
+                }
+            }
+
+            if (!io_performed_)
+            {
+                // ensure return as if by post
+                BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+            }
+            self.complete(error_code(), size_);
+        }
+    }
+};
+
+} // detail
+} // mysql
+} // boost
+
+template <class Stream>
+boost::mysql::detail::read_row_result boost::mysql::detail::read_row_streamed(
+    resultset_encoding encoding,
+    channel<Stream>& channel,
+    const std::vector<field_metadata>& meta,
+    row& output,
+    bytestring& ok_packet_buffer,
+    ok_packet& output_ok_packet,
+    streamed_field_state& state,
+    error_code& err,
+    error_info& info
+)
+{
+    state.reset();
+    output.buffer().clear();
+    channel.start_partial_read();
+    read_row_result result = read_row_result::error;
+
+    // Read until we get to the streamed field
+    do
+    {
+        std::size_t bytes_read = channel.read_partial(prepare_streamed_row_read(output, state), err);
+        if (err)
+            return read_row_result::error;
+        commit_streamed_row_read(output, state, bytes_read);
+    } while (!process_streamed_row(
+        encoding,
+        channel.current_capabilities(),
+        meta,
+        output,
+        channel.partial_read_done(),
+        channel.partial_first_packet_size(),
+        ok_packet_buffer,
+        output_ok_packet,
+        state,
+        result,
+        err,
+        info
+    ));
+
+    // If the field is empty, the message should end here
+    if (result == read_row_result::row && state.remaining == 0)
+    {
+        check_streamed_field_end(channel, state, err);
+        if (err)
+            return read_row_result::error;
+    }
+    return result;
+}
+
+template <class Stream, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, boost::mysql::detail::read_row_result)
+)
+boost::mysql::detail::async_read_row_streamed(
+    resultset_encoding encoding,
+    channel<Stream>& chan,
+    const std::vector<field_metadata>& meta,
+    row& output,
+    bytestring& ok_packet_buffer,
+    ok_packet& output_ok_packet,
+    streamed_field_state& state,
+    CompletionToken&& token,
+    error_info& output_info
+)
+{
+    return boost::asio::async_compose<
+        CompletionToken,
+        void(error_code, read_row_result)
+    >(
+        read_row_streamed_op<Stream>(
+            chan,
+            output_info,
+            encoding,
+            meta,
+            output,
+            ok_packet_buffer,
+            output_ok_packet,
+            state
+        ),
+        token,
+        chan
+    );
+}
+
+template <class Stream>
+std::size_t boost::mysql::detail::read_streamed_chunk(
+    channel<Stream>& channel,
+    streamed_field_state& state,
+    boost::asio::mutable_buffer buffer,
+    error_code& err
+)
+{
+    assert(buffer.size() > 0);
+    if (state.remaining == 0)
+        return 0;
+
+    std::size_t size = 0;
+    if (has_streamed_buffered(state))
+    {
+        size = consume_streamed_buffered(state, buffer);
+    }
+    else
+    {
+        size = channel.read_partial(streamed_read_buffer(state, buffer), err);
+        if (err)
+            return 0;
+        if (size == 0)
+        {
+            err = make_error_code(errc::incomplete_message);
+            return 0;
+        }
+        state.remaining -= size;
+    }
+
+    // Once the field has been read, the message should end
+    if (state.remaining == 0)
+    {
+        check_streamed_field_end(channel, state, err);
+        if (err)
+            return 0;
+    }
+    return size;
+}
+
+template <class Stream, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, std::size_t)
+)
+boost::mysql::detail::async_read_streamed_chunk(
+    channel<Stream>& chan,
+    streamed_field_state& state,
+    boost::asio::mutable_buffer buffer,
+    CompletionToken&& token
+)
+{
+    assert(buffer.size() > 0);
+    return boost::asio::async_compose<
+        CompletionToken,
+        void(error_code, std::size_t)
+    >(
+        read_streamed_chunk_op<Stream>(chan, state, buffer),
+        token,
+        chan
+    );
+}
+
+#endif
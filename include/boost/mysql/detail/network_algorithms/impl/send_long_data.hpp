@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_SEND_LONG_DATA_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_SEND_LONG_DATA_HPP
+
+#include <boost/mysql/detail/protocol/prepared_statement_messages.hpp>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+inline com_stmt_send_long_data_packet make_send_long_data_packet(
+    std::uint32_t statement_id,
+    std::uint16_t param_id,
+    boost::asio::const_buffer data
+)
+{
+    return com_stmt_send_long_data_packet {
+        statement_id,
+        param_id,
+        string_eof(boost::string_view(static_cast<const char*>(data.data()), data.size()))
+    };
+}
+
+} // detail
+} // mysql
+} // boost
+
+template <class Stream>
+void boost::mysql::detail::send_long_data(
+    channel<Stream>& chan,
+    std::uint32_t statement_id,
+    std::uint16_t param_id,
+    boost::asio::const_buffer data,
+    error_code& code,
+    error_info&
+)
+{
+    // Serialize the message. Only this chunk is held in memory
+    serialize_message(
+        make_send_long_data_packet(statement_id, param_id, data),
+        chan.current_capabilities(),
+        chan.shared_buffer()
+    );
+
+    // Send it. No response is sent back. Any error is reported by the next execution
+    chan.reset_sequence_number();
+    chan.write(boost::asio::buffer(chan.shared_buffer()), code);
+}
+
+template <class Stream, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::detail::async_send_long_data(
+    channel<Stream>& chan,
+    std::uint32_t statement_id,
+    std::uint16_t param_id,
+    boost::asio::const_buffer data,
+    CompletionToken&& token,
+    error_info&
+)
+{
+    // Serialize the message. Only this chunk is held in memory
+    serialize_message(
+        make_send_long_data_packet(statement_id, param_id, data),
+        chan.current_capabilities(),
+        chan.shared_buffer()
+    );
+
+    // Send it. No response is sent back. Any error is reported by the next execution
+    chan.reset_sequence_number();
+    return chan.async_write(
+        boost::asio::buffer(chan.shared_buffer()),
+        std::forward<CompletionToken>(token)
+    );
+}
+
+#endif /* INCLUDE_BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_IMPL_SEND_LONG_DATA_HPP_ */
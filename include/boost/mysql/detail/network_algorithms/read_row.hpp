@@ -25,25 +25,27 @@ enum class read_row_result
     eof
 };
 
-template <class Stream>
+// RowType may be row or any other type for which a deserialize_row
+// overload can be found (e.g. lazy_row)
+template <class Stream, class RowType>
 read_row_result read_row(
-    deserialize_row_fn deserializer,
+    resultset_encoding encoding,
     channel<Stream>& channel,
     const std::vector<field_metadata>& meta,
-	row& output,
+	RowType& output,
 	bytestring& ok_packet_buffer,
     ok_packet& output_ok_packet,
     error_code& err,
     error_info& info
 );
 
-template <class Stream, class CompletionToken>
+template <class Stream, class RowType, class CompletionToken>
 BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, read_row_result))
 async_read_row(
-    deserialize_row_fn deserializer,
+    resultset_encoding encoding,
     channel<Stream>& channel,
     const std::vector<field_metadata>& meta,
-	row& output,
+	RowType& output,
     bytestring& ok_packet_buffer,
 	ok_packet& output_ok_packet,
     CompletionToken&& token,
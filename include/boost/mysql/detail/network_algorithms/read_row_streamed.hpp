@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_READ_ROW_STREAMED_HPP
+#define BOOST_MYSQL_DETAIL_NETWORK_ALGORITHMS_READ_ROW_STREAMED_HPP
+
+#include <boost/mysql/detail/network_algorithms/read_row.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// State of the last field of a row being streamed
+struct streamed_field_state
+{
+    std::uint64_t remaining {0}; // bytes of the field not returned to the user yet
+    bytestring buffered;         // bytes of the field read together with the rest of the row
+    std::size_t buffered_offset {0};
+    std::size_t read_size {0};   // size of the last read performed while reading the row
+    std::uint8_t end_check {0};  // target of the read verifying that the message ended
+
+    void reset() noexcept
+    {
+        remaining = 0;
+        buffered.clear();
+        buffered_offset = 0;
+        read_size = 0;
+    }
+};
+
+// Reads a row, deserializing all fields but the last one, which must be a string.
+// output's last value is set to NULL or to an empty string. The last field's
+// contents are then read using read_streamed_chunk.
+template <class Stream>
+read_row_result read_row_streamed(
+    resultset_encoding encoding,
+    channel<Stream>& channel,
+    const std::vector<field_metadata>& meta,
+    row& output,
+    bytestring& ok_packet_buffer,
+    ok_packet& output_ok_packet,
+    streamed_field_state& state,
+    error_code& err,
+    error_info& info
+);
+
+template <class Stream, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, read_row_result))
+async_read_row_streamed(
+    resultset_encoding encoding,
+    channel<Stream>& channel,
+    const std::vector<field_metadata>& meta,
+    row& output,
+    bytestring& ok_packet_buffer,
+    ok_packet& output_ok_packet,
+    streamed_field_state& state,
+    CompletionToken&& token,
+    error_info& output_info
+);
+
+// Reads up to buffer.size() bytes of the field being streamed.
+// Returns zero once the entire field has been read.
+template <class Stream>
+std::size_t read_streamed_chunk(
+    channel<Stream>& channel,
+    streamed_field_state& state,
+    boost::asio::mutable_buffer buffer,
+    error_code& err
+);
+
+template <class Stream, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+async_read_streamed_chunk(
+    channel<Stream>& channel,
+    streamed_field_state& state,
+    boost::asio::mutable_buffer buffer,
+    CompletionToken&& token
+);
+
+} // detail
+} // mysql
+} // boost
+
+#include <boost/mysql/detail/network_algorithms/impl/read_row_streamed.hpp>
+
+#endif
@@ -9,6 +9,7 @@
 #define BOOST_MYSQL_DETAIL_PROTOCOL_BINARY_DESERIALIZATION_HPP
 
 #include <boost/mysql/detail/protocol/serialization.hpp>
+#include <boost/mysql/detail/protocol/field_ref.hpp>
 #include <boost/mysql/error.hpp>
 #include <boost/mysql/value.hpp>
 #include <boost/mysql/metadata.hpp>
@@ -30,6 +31,13 @@ inline error_code deserialize_binary_row(
     std::vector<value>& output
 );
 
+// Locates each field in the row, without deserializing them
+inline error_code index_binary_row(
+    deserialization_context& ctx,
+    const std::vector<field_metadata>& meta,
+    std::vector<field_ref>& output
+);
+
 } // detail
 } // mysql
 } // boost
@@ -67,7 +67,7 @@ public:
 * CLIENT_NO_SCHEMA: unset //  Don't allow database.table.column
 * CLIENT_COMPRESS: unset //  Compression protocol supported
 * CLIENT_ODBC: unset //  Special handling of ODBC behavior
-* CLIENT_LOCAL_FILES: unset //  Can use LOAD DATA LOCAL
+* CLIENT_LOCAL_FILES: optional //  Can use LOAD DATA LOCAL
 * CLIENT_IGNORE_SPACE: unset //  Ignore spaces before '('
 * CLIENT_PROTOCOL_41: mandatory //  New 4.1 protocol
 * CLIENT_INTERACTIVE: unset //  This is an interactive client
@@ -91,6 +91,7 @@ public:
 *
 * We pay attention to:
 * CLIENT_CONNECT_WITH_DB: optional //  Database (schema) name can be specified on connect in Handshake Response Packet
+* CLIENT_LOCAL_FILES: optional //  Can use LOAD DATA LOCAL (only if a local infile handler is set)
 * CLIENT_PROTOCOL_41: mandatory //  New 4.1 protocol
 * CLIENT_PLUGIN_AUTH: mandatory //  Client supports plugin authentication
 * CLIENT_PLUGIN_AUTH_LENENC_CLIENT_DATA: mandatory //  Enable authentication response packet to be larger than 255 bytes
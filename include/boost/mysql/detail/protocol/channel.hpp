@@ -8,16 +8,26 @@
 #ifndef BOOST_MYSQL_DETAIL_PROTOCOL_CHANNEL_HPP
 #define BOOST_MYSQL_DETAIL_PROTOCOL_CHANNEL_HPP
 
+#include <boost/mysql/collation.hpp>
 #include <boost/mysql/error.hpp>
+#include <boost/mysql/local_infile.hpp>
 #include <boost/mysql/detail/auxiliar/bytestring.hpp>
 #include <boost/mysql/detail/protocol/capabilities.hpp>
+#include <boost/mysql/detail/protocol/constants.hpp>
+#include <boost/mysql/detail/protocol/gathered_message.hpp>
+#include <boost/mysql/detail/protocol/ssl_session_cache.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/basic_waitable_timer.hpp>
 #include <boost/asio/ssl/stream.hpp>
 #include <boost/asio/ssl/context.hpp>
 #include <boost/asio/coroutine.hpp>
 #include <boost/optional/optional.hpp>
 #include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace boost {
 namespace mysql {
@@ -29,16 +39,87 @@ class channel
 {
     // TODO: static asserts for Stream concept
     boost::asio::ssl::context* external_ctx_ {nullptr};    // if one was externally provided
-    boost::optional<boost::asio::ssl::context> local_ctx_; // if one was not provided
+    std::string endpoint_key_; // identifies the server, to cache TLS sessions and RSA keys
+    boost::string_view auth_plugin_; // points to static storage
+    std::string scramble_;           // last challenge sent by the server
     boost::optional<boost::asio::ssl::stream<Stream&>> ssl_stream_;
     Stream stream_;
     std::uint8_t sequence_number_ {0};
     std::array<std::uint8_t, 4> header_buffer_ {}; // for async ops
     bytestring shared_buff_; // for async ops
     capabilities current_caps_;
+    bool is_mariadb_ {false};
+    std::uint32_t server_version_ {0}; // major * 10000 + minor * 100 + patch
+    std::uint32_t connection_id_ {0};
+    collation connection_collation_ {collation::utf8_general_ci};
+    std::uint16_t status_flags_ {0}; // last ones reported by the server
+    bool deferred_close_ {false};
+    bytestring pending_writes_;  // deferred requests, split into packets
+    bytestring flushing_writes_; // deferred requests being written
     error_info shared_info_; // for async ops
+    local_infile_handler local_infile_handler_;
+
+    // State for partial reads
+    std::uint32_t partial_packet_remaining_ {0}; // bytes of the current packet not read yet
+    bool partial_header_pending_ {false};        // the next thing to read is a packet header
+    bool partial_last_packet_ {false};           // the current packet is the last one in the message
+    bool partial_done_ {true};                   // the entire message has been read
+    bool partial_first_packet_ {false};          // the next header is the message's first one
+    std::uint32_t partial_first_packet_size_ {0};
+
+    // Timeouts, for async operations only. Every read, write or handshake
+    // arms the timer to expire at the operation's deadline. On expiry,
+    // close_fn_ closes the stream, making the outstanding I/O fail
+    using clock_type = std::chrono::steady_clock;
+    using timer_type = boost::asio::basic_waitable_timer<
+        clock_type,
+        boost::asio::wait_traits<clock_type>,
+        typename Stream::executor_type
+    >;
+
+    // The timer handler may still be queued when the I/O completes, and the
+    // channel may be destroyed before it runs. The handler holds a weak_ptr
+    // to this state, so it can tell whether the channel is still alive
+    struct timer_state
+    {
+        timer_type timer;
+        channel<Stream>* chan;        // set every time the timer is armed
+        std::uint64_t generation {0}; // identifies the I/O the timer was armed for
+        bool timed_out {false};
+
+        explicit timer_state(typename Stream::executor_type ex) : timer(std::move(ex)), chan(nullptr) {}
+    };
+
+    clock_type::duration timeout_ {clock_type::duration::zero()}; // zero means no timeout
+    clock_type::time_point deadline_ {};     // of the current operation
+    std::shared_ptr<timer_state> timer_;     // created on first use
+    void (*close_fn_)(channel<Stream>&) {nullptr};
+
+    bool has_deadline() const noexcept { return deadline_ != clock_type::time_point(); }
+    void arm_timer();
+    bool disarm_timer(); // returns true if the I/O was interrupted by the timer
+
+    void process_partial_header(std::uint32_t packet_size) noexcept
+    {
+        partial_packet_remaining_ = packet_size;
+        partial_last_packet_ = packet_size < MAX_PACKET_SIZE;
+        partial_header_pending_ = false;
+        if (partial_first_packet_)
+        {
+            partial_first_packet_size_ = packet_size;
+            partial_first_packet_ = false;
+        }
+    }
+
+    // Moves to the next packet, or finishes the message, if the current packet has been read
+    void process_partial_packet_end() noexcept
+    {
+        if (partial_last_packet_)
+            partial_done_ = true;
+        else
+            partial_header_pending_ = true;
+    }
 
-    bool process_sequence_number(std::uint8_t got);
     std::uint8_t next_sequence_number() { return sequence_number_++; }
 
     error_code process_header_read(std::uint32_t& size_to_read); // reads from header_buffer_
@@ -46,6 +127,15 @@ class channel
 
     void create_ssl_stream();
 
+    // Returns the deferred requests, to be written before the next command.
+    // The returned buffer remains valid until the next call
+    boost::asio::const_buffer take_pending_writes()
+    {
+        flushing_writes_.swap(pending_writes_);
+        pending_writes_.clear();
+        return boost::asio::buffer(flushing_writes_);
+    }
+
     template <class BufferSeq>
     std::size_t read_impl(BufferSeq&& buff, error_code& ec);
 
@@ -60,8 +150,22 @@ class channel
     BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
     async_write_impl(BufferSeq&& buff, CompletionToken&& token);
 
+    template <class BufferSeq, class CompletionToken>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+    async_read_untimed(BufferSeq&& buff, CompletionToken&& token);
+
+    template <class BufferSeq, class CompletionToken>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+    async_write_untimed(BufferSeq&& buff, CompletionToken&& token);
+
     struct read_op;
     struct write_op;
+    struct read_partial_op;
+    template <class Initiation> struct timed_op;
+    template <class BufferSeq> struct read_initiation;
+    template <class BufferSeq> struct write_initiation;
+    struct ssl_handshake_initiation;
+    template <class Endpoint> struct connect_initiation;
 public:
     channel() = default; // Simplify life if stream is default constructible, mainly for tests
 
@@ -76,6 +180,7 @@ public:
     {
         reset_sequence_number();
         ssl_stream_.reset();
+        pending_writes_.clear();
     }
 
     // Executor
@@ -89,6 +194,31 @@ public:
     BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
     async_read(bytestring& buffer, CompletionToken&& token);
 
+    // Reading a message in pieces, as it arrives, without storing it as a whole.
+    // Call start_partial_read() before reading the first piece of a message.
+    // Each read returns up to buffer.size() bytes, crossing packet boundaries
+    // as required. Reads return zero bytes once the entire message has been read.
+    // buffer must not be empty
+    void start_partial_read() noexcept
+    {
+        partial_packet_remaining_ = 0;
+        partial_header_pending_ = true;
+        partial_last_packet_ = false;
+        partial_done_ = false;
+        partial_first_packet_ = true;
+        partial_first_packet_size_ = 0;
+    }
+    bool partial_read_done() const noexcept { return partial_done_; }
+
+    // Size of the message's first packet. Valid once the first read has returned any bytes
+    std::uint32_t partial_first_packet_size() const noexcept { return partial_first_packet_size_; }
+
+    std::size_t read_partial(boost::asio::mutable_buffer buffer, error_code& code);
+
+    template <class CompletionToken>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+    async_read_partial(boost::asio::mutable_buffer buffer, CompletionToken&& token);
+
     // Writing
     void write(boost::asio::const_buffer buffer, error_code& code);
     void write(const bytestring& buffer, error_code& code)
@@ -107,9 +237,42 @@ public:
         return async_write(boost::asio::buffer(buffer), std::forward<CompletionToken>(token));
     }
 
+    // Writing a message referencing external memory, using gathered writes
+    void write(const gathered_message& message, error_code& code);
+
+    // Writing several messages already split into packets (see frame_message).
+    // Doesn't touch the sequence number. Deferred requests are written first.
+    // An empty buffer just flushes deferred requests
+    void write_raw(boost::asio::const_buffer buffer, error_code& code)
+    {
+        write_impl(
+            std::array<boost::asio::const_buffer, 2> { take_pending_writes(), buffer },
+            code
+        );
+    }
+
+    template <class CompletionToken>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+    async_write_raw(boost::asio::const_buffer buffer, CompletionToken&& token)
+    {
+        return async_write_impl(
+            std::array<boost::asio::const_buffer, 2> { take_pending_writes(), buffer },
+            std::forward<CompletionToken>(token)
+        );
+    }
+
+    // Deferred requests: messages that don't get a response, queued to be
+    // written together with the next command (any write starting with
+    // sequence number zero, or a raw write)
+    void defer_write(boost::asio::const_buffer message);
+    bool has_pending_writes() const noexcept { return !pending_writes_.empty(); }
+    bool deferred_close() const noexcept { return deferred_close_; }
+    void set_deferred_close(bool value) noexcept { deferred_close_ = value; }
+
     // SSL
     bool ssl_active() const noexcept { return ssl_stream_.has_value(); }
 
+
     void ssl_handshake(error_code& ec);
 
     template <class CompletionToken>
@@ -119,6 +282,26 @@ public:
     // Closing (only available for sockets)
     error_code close();
 
+    // Connecting the underlying socket, subject to timeouts (only available for sockets)
+    template <class Endpoint, class CompletionToken>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_connect(const Endpoint& endpoint, CompletionToken&& token);
+
+    // Timeouts. A zero timeout disables them. close_fn is invoked to interrupt
+    // the I/O in progress when the deadline expires, and must close the stream.
+    // start_deadline() must be called when each async operation is initiated
+    clock_type::duration timeout() const noexcept { return timeout_; }
+    void set_timeout(clock_type::duration value, void (*close_fn)(channel<Stream>&)) noexcept
+    {
+        timeout_ = value;
+        close_fn_ = close_fn;
+    }
+    void start_deadline()
+    {
+        deadline_ = timeout_ == clock_type::duration::zero() ?
+            clock_type::time_point() : clock_type::now() + timeout_;
+    }
+
     // Sequence numbers
     void reset_sequence_number(std::uint8_t value = 0) { sequence_number_ = value; }
     std::uint8_t sequence_number() const { return sequence_number_; }
@@ -131,12 +314,91 @@ public:
     capabilities current_capabilities() const noexcept { return current_caps_; }
     void set_current_capabilities(capabilities value) noexcept { current_caps_ = value; }
 
+    // Server flavor
+    bool is_mariadb() const noexcept { return is_mariadb_; }
+    void set_mariadb(bool value) noexcept { is_mariadb_ = value; }
+    std::uint32_t server_version() const noexcept { return server_version_; }
+    void set_server_version(std::uint32_t value) noexcept { server_version_ = value; }
+
+    // Server-side ID for this connection, sent in the server greeting
+    std::uint32_t connection_id() const noexcept { return connection_id_; }
+    void set_connection_id(std::uint32_t value) noexcept { connection_id_ = value; }
+
+    // Session state affecting how the server parses SQL text. Status flags
+    // are updated by the handshake and by statements not returning rows
+    collation connection_collation() const noexcept { return connection_collation_; }
+    void set_connection_collation(collation value) noexcept { connection_collation_ = value; }
+    bool backslash_escapes() const noexcept { return !(status_flags_ & SERVER_STATUS_NO_BACKSLASH_ESCAPES); }
+    void set_status_flags(std::uint16_t value) noexcept { status_flags_ = value; }
+
+    // Identifies the server we're connecting to, so TLS sessions (only with the
+    // default SSL context) and RSA public keys can be reused by later connections to it
+    const std::string& endpoint_key() const noexcept { return endpoint_key_; }
+    void set_endpoint_key(std::string key) { endpoint_key_ = std::move(key); }
+
+    // The authentication plugin and challenge used by the last successful
+    // authentication, required to authenticate again using COM_CHANGE_USER
+    boost::string_view auth_plugin() const noexcept { return auth_plugin_; }
+    const std::string& scramble() const noexcept { return scramble_; }
+    void set_auth_state(boost::string_view plugin, const std::string& scramble)
+    {
+        auth_plugin_ = plugin;
+        scramble_ = scramble;
+    }
+
+    // LOAD DATA LOCAL INFILE
+    const local_infile_handler& get_local_infile_handler() const noexcept { return local_infile_handler_; }
+    void set_local_infile_handler(local_infile_handler handler) { local_infile_handler_ = std::move(handler); }
+
     // Internal buffer & error_info to help async ops
     const bytestring& shared_buffer() const noexcept { return shared_buff_; }
     bytestring& shared_buffer() noexcept { return shared_buff_; }
     error_info& shared_info() noexcept { return shared_info_; }
 };
 
+// Parses a packet header, checking that its sequence number matches seqnum,
+// which is then incremented. packet_size is set to the size of the packet body
+inline error_code process_packet_header(
+    boost::asio::const_buffer header,
+    std::uint8_t& seqnum,
+    std::uint32_t& packet_size
+);
+
+// The inverse of frame_message: extracts a message, possibly spanning several
+// packets, from the beginning of input, which contains data as received from
+// the server. Sequence numbers are checked and updated as channel::read would.
+// Returns the number of bytes consumed, or zero if input doesn't contain
+// the entire message yet or on error
+inline std::size_t deframe_message(
+    boost::asio::const_buffer input,
+    std::uint8_t& seqnum,
+    bytestring& message,
+    error_code& err
+);
+
+// Appends a message to output, split into packets with their headers, as
+// channel::write would send it. Sequence numbers start at seqnum.
+// Returns the sequence number following the last packet.
+inline std::uint8_t frame_message(
+    boost::asio::const_buffer message,
+    std::uint8_t seqnum,
+    bytestring& output
+);
+
+// Splits a gathered message into packets, as channel::write would send it.
+// Packet headers and the message's owned bytes are copied into storage, and
+// output is populated with buffers pointing to storage and to the message's
+// external memory. Adjacent bytes in storage are coalesced into a single buffer,
+// so only external memory causes extra buffers. This matters for SSL streams,
+// which write each buffer separately. Sequence numbers start at seqnum.
+// Returns the sequence number following the last packet.
+inline std::uint8_t frame_gathered_message(
+    const gathered_message& message,
+    std::uint8_t seqnum,
+    bytestring& storage,
+    std::vector<boost::asio::const_buffer>& output
+);
+
 // Helper class to get move semantics right for some I/O object types
 template <class Stream>
 struct null_channel_deleter
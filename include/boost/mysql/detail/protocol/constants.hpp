@@ -45,6 +45,12 @@ enum class protocol_field_type : std::uint8_t
     geometry = 0xff    // GEOMETRY
 };
 
+// The encoding used by the rows in a resultset
+enum class resultset_encoding
+{
+    text,   // text queries
+    binary  // prepared statements
+};
 
 constexpr std::size_t MAX_PACKET_SIZE = 0xffffff;
 
@@ -72,6 +78,7 @@ constexpr std::uint8_t ok_packet_header = 0x00;
 constexpr std::uint8_t eof_packet_header = 0xfe;
 constexpr std::uint8_t auth_switch_request_header = 0xfe;
 constexpr std::uint8_t auth_more_data_header = 0x01;
+constexpr std::uint8_t local_infile_request_header = 0xfb;
 constexpr boost::string_view fast_auth_complete_challenge = make_string_view("\3");
 
 // Column flags
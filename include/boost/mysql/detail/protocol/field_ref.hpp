@@ -0,0 +1,32 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_PROTOCOL_FIELD_REF_HPP
+#define BOOST_MYSQL_DETAIL_PROTOCOL_FIELD_REF_HPP
+
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Location of a serialized field within a row message, relative to
+// the beginning of the message. For text rows, this is the field's
+// string, without the length prefix. For binary rows, this is the
+// entire serialized value, so it can be passed to deserialize_binary_value
+struct field_ref
+{
+    std::uint32_t offset;
+    std::uint32_t size;
+    bool is_null;
+};
+
+} // detail
+} // mysql
+} // boost
+
+#endif
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_PROTOCOL_GATHERED_MESSAGE_HPP
+#define BOOST_MYSQL_DETAIL_PROTOCOL_GATHERED_MESSAGE_HPP
+
+#include <boost/mysql/detail/auxiliar/bytestring.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// String values at least this big are referenced by gathered messages,
+// rather than copied
+constexpr std::size_t min_gathered_string_size = 0x1000;
+
+// A message made of bytes serialized into an owned buffer, interleaved
+// with references to external memory, which is sent without being copied.
+// Usage: reset() with the number of owned bytes, serialize into owned_data(),
+// calling add_external() at the points where external memory should be inserted,
+// and finish() once done.
+class gathered_message
+{
+    struct segment
+    {
+        const std::uint8_t* external; // nullptr for bytes in the owned buffer
+        std::size_t size;
+    };
+
+    bytestring owned_;
+    std::vector<segment> segments_;
+    std::size_t owned_added_ {0}; // owned bytes already added as segments
+    std::size_t size_ {0};
+
+    void add_segment(const std::uint8_t* external, std::size_t size)
+    {
+        if (size > 0)
+        {
+            segments_.push_back(segment{external, size});
+            size_ += size;
+        }
+    }
+
+    // Adds the owned bytes serialized since the last call as a segment
+    void add_owned(const std::uint8_t* owned_pos)
+    {
+        assert(owned_pos >= owned_.data() && owned_pos <= owned_.data() + owned_.size());
+        auto owned_end = static_cast<std::size_t>(owned_pos - owned_.data());
+        add_segment(nullptr, owned_end - owned_added_);
+        owned_added_ = owned_end;
+    }
+public:
+    void reset(std::size_t owned_size)
+    {
+        owned_.resize(owned_size);
+        segments_.clear();
+        owned_added_ = 0;
+        size_ = 0;
+    }
+
+    std::uint8_t* owned_data() noexcept { return owned_.data(); }
+
+    // owned_pos points to the end of the owned bytes serialized so far
+    void add_external(const std::uint8_t* owned_pos, const void* data, std::size_t size)
+    {
+        add_owned(owned_pos);
+        add_segment(static_cast<const std::uint8_t*>(data), size);
+    }
+
+    void finish(const std::uint8_t* owned_pos)
+    {
+        add_owned(owned_pos);
+        assert(owned_added_ == owned_.size());
+    }
+
+    // Total message size
+    std::size_t size() const noexcept { return size_; }
+
+    // Number of bytes in the owned buffer
+    std::size_t owned_size() const noexcept { return owned_.size(); }
+
+    // Calls fn(const_buffer, bool is_external) for each piece of the message, in order
+    template <class Fn>
+    void for_each_segment(Fn&& fn) const
+    {
+        const std::uint8_t* owned_pos = owned_.data();
+        for (const auto& seg: segments_)
+        {
+            if (seg.external)
+            {
+                fn(boost::asio::const_buffer(seg.external, seg.size), true);
+            }
+            else
+            {
+                fn(boost::asio::const_buffer(owned_pos, seg.size), false);
+                owned_pos += seg.size;
+            }
+        }
+    }
+
+    // Calls fn(const_buffer) for each piece of the message, in order
+    template <class Fn>
+    void for_each_buffer(Fn&& fn) const
+    {
+        for_each_segment([&fn](boost::asio::const_buffer buff, bool) { fn(buff); });
+    }
+};
+
+} // detail
+} // mysql
+} // boost
+
+#endif
@@ -89,6 +89,31 @@ struct serialization_traits<handshake_response_packet, serialization_tag::struct
             const handshake_response_packet& value) noexcept;
 };
 
+// change user (authenticate again over an established connection)
+struct com_change_user_packet
+{
+    string_null username;
+    string_lenenc auth_response; // int<1> length + data. Equivalent, as responses are < 251 bytes
+    string_null database;
+    std::uint16_t character_set;
+    string_null client_plugin_name; // we require CLIENT_PLUGIN_AUTH
+    // CLIENT_CONNECT_ATTRS: not implemented
+
+    static constexpr std::uint8_t command_id = 0x11;
+
+    template <class Self, class Callable>
+    static void apply(Self& self, Callable&& cb)
+    {
+        std::forward<Callable>(cb)(
+            self.username,
+            self.auth_response,
+            self.database,
+            self.character_set,
+            self.client_plugin_name
+        );
+    }
+};
+
 // SSL request
 struct ssl_request
 {
@@ -308,6 +308,60 @@ inline errc deserialize_binary_value_time(
 }
 
 
+// Computes the number of bytes the next value in ctx takes, without deserializing it
+inline errc binary_value_size(
+    const deserialization_context& ctx,
+    const field_metadata& meta,
+    std::size_t& output
+) noexcept
+{
+    switch (meta.protocol_type())
+    {
+    case protocol_field_type::tiny:
+        output = 1;
+        break;
+    case protocol_field_type::short_:
+    case protocol_field_type::year:
+        output = 2;
+        break;
+    case protocol_field_type::int24:
+    case protocol_field_type::long_:
+    case protocol_field_type::float_:
+        output = 4;
+        break;
+    case protocol_field_type::longlong:
+    case protocol_field_type::double_:
+        output = 8;
+        break;
+    case protocol_field_type::timestamp:
+    case protocol_field_type::datetime:
+    case protocol_field_type::date:
+    case protocol_field_type::time:
+        // Length byte followed by the actual value
+        if (!ctx.enough_size(1))
+            return errc::incomplete_message;
+        output = 1 + static_cast<std::size_t>(*ctx.first());
+        break;
+    default:
+    {
+        // Strings, BIT and anything else. A length-encoded string
+        deserialization_context length_ctx (ctx);
+        int_lenenc length;
+        auto err = deserialize(length_ctx, length);
+        if (err != errc::ok)
+            return err;
+        std::size_t header_size = length_ctx.first() - ctx.first();
+        if (length.value > length_ctx.size())
+            return errc::incomplete_message;
+        output = header_size + static_cast<std::size_t>(length.value);
+        break;
+    }
+    }
+    if (!ctx.enough_size(output))
+        return errc::incomplete_message;
+    return errc::ok;
+}
+
 } // detail
 } // mysql
 } // boost
@@ -408,4 +462,53 @@ inline boost::mysql::error_code boost::mysql::detail::deserialize_binary_row(
 }
 
 
+inline boost::mysql::error_code boost::mysql::detail::index_binary_row(
+    deserialization_context& ctx,
+    const std::vector<field_metadata>& meta,
+    std::vector<field_ref>& output
+)
+{
+    // Skip packet header. The caller will have checked we have this byte already for us
+    const std::uint8_t* message_begin = ctx.first();
+    assert(ctx.enough_size(1));
+    ctx.advance(1);
+
+    // Null bitmap
+    auto num_fields = meta.size();
+    output.resize(num_fields);
+    null_bitmap_traits null_bitmap (binary_row_null_bitmap_offset, num_fields);
+    const std::uint8_t* null_bitmap_begin = ctx.first();
+    if (!ctx.enough_size(null_bitmap.byte_count()))
+        return make_error_code(errc::incomplete_message);
+    ctx.advance(null_bitmap.byte_count());
+
+    // Locate values
+    for (std::vector<field_ref>::size_type i = 0; i < num_fields; ++i)
+    {
+        if (null_bitmap.is_null(null_bitmap_begin, i))
+        {
+            output[i] = field_ref {0, 0, true};
+        }
+        else
+        {
+            std::size_t size = 0;
+            auto err = binary_value_size(ctx, meta[i], size);
+            if (err != errc::ok)
+                return make_error_code(err);
+            output[i] = field_ref {
+                static_cast<std::uint32_t>(ctx.first() - message_begin),
+                static_cast<std::uint32_t>(size),
+                false
+            };
+            ctx.advance(size);
+        }
+    }
+
+    // Check for remaining bytes
+    if (!ctx.empty())
+        return make_error_code(errc::extra_bytes);
+
+    return error_code();
+}
+
 #endif /* INCLUDE_BOOST_MYSQL_DETAIL_PROTOCOL_IMPL_BINARY_DESERIALIZATION_IPP_ */
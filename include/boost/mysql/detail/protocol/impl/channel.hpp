@@ -11,9 +11,14 @@
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/asio/compose.hpp>
+#include <boost/asio/post.hpp>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <type_traits>
 #include <boost/mysql/detail/protocol/common_messages.hpp>
 #include <boost/mysql/detail/protocol/constants.hpp>
+#include <boost/mysql/detail/auxiliar/cancellation.hpp>
 #include <boost/mysql/detail/auxiliar/valgrind.hpp>
 
 namespace boost {
@@ -35,20 +40,163 @@ inline std::uint32_t compute_size_to_write(
 } // mysql
 } // boost
 
-template <class Stream>
-bool boost::mysql::detail::channel<Stream>::process_sequence_number(
-    std::uint8_t got
+inline boost::mysql::error_code boost::mysql::detail::process_packet_header(
+    boost::asio::const_buffer header,
+    std::uint8_t& seqnum,
+    std::uint32_t& packet_size
+)
+{
+    packet_header header_packet;
+    deserialization_context ctx (header, capabilities(0)); // unaffected by capabilities
+    errc err = deserialize(ctx, header_packet);
+    if (err != errc::ok)
+        return make_error_code(err);
+    if (header_packet.sequence_number != seqnum)
+        return make_error_code(errc::sequence_number_mismatch);
+    ++seqnum;
+    packet_size = header_packet.packet_size.value;
+    return error_code();
+}
+
+inline std::size_t boost::mysql::detail::deframe_message(
+    boost::asio::const_buffer input,
+    std::uint8_t& seqnum,
+    bytestring& message,
+    error_code& err
 )
 {
-    if (got == sequence_number_)
+    auto first = static_cast<const std::uint8_t*>(input.data());
+    std::size_t size = input.size();
+
+    // Check that we have the entire message, without consuming anything
+    std::size_t pos = 0;
+    std::uint8_t current_seqnum = seqnum;
+    std::size_t message_size = 0;
+    std::uint32_t packet_size = 0;
+    do
     {
-        ++sequence_number_;
-        return true;
-    }
-    else
+        if (size - pos < 4)
+            return 0;
+        err = process_packet_header(boost::asio::buffer(first + pos, 4), current_seqnum, packet_size);
+        if (err)
+            return 0;
+        if (size - pos - 4 < packet_size)
+            return 0;
+        pos += 4 + packet_size;
+        message_size += packet_size;
+    } while (packet_size == MAX_PACKET_SIZE);
+
+    // Copy the packet contents
+    message.resize(message_size);
+    std::size_t message_pos = 0;
+    std::size_t input_pos = 0;
+    while (input_pos != pos)
     {
-        return false;
+        packet_size = first[input_pos] | (first[input_pos + 1] << 8) | (first[input_pos + 2] << 16);
+        if (packet_size)
+            std::memcpy(message.data() + message_pos, first + input_pos + 4, packet_size);
+        message_pos += packet_size;
+        input_pos += 4 + packet_size;
     }
+    seqnum = current_seqnum;
+    return pos;
+}
+
+inline std::uint8_t boost::mysql::detail::frame_message(
+    boost::asio::const_buffer message,
+    std::uint8_t seqnum,
+    bytestring& output
+)
+{
+    auto first = static_cast<const std::uint8_t*>(message.data());
+    std::size_t bufsize = message.size();
+    std::size_t transferred_size = 0;
+    std::uint32_t size_to_write = 0;
+
+    // A packet of exactly MAX_PACKET_SIZE bytes must be followed by another one,
+    // even if it's empty
+    do
+    {
+        size_to_write = compute_size_to_write(bufsize, transferred_size);
+        output.push_back(static_cast<std::uint8_t>(size_to_write));
+        output.push_back(static_cast<std::uint8_t>(size_to_write >> 8));
+        output.push_back(static_cast<std::uint8_t>(size_to_write >> 16));
+        output.push_back(seqnum++);
+        output.insert(output.end(), first + transferred_size, first + transferred_size + size_to_write);
+        transferred_size += size_to_write;
+    } while (size_to_write == MAX_PACKET_SIZE);
+    return seqnum;
+}
+
+inline std::uint8_t boost::mysql::detail::frame_gathered_message(
+    const gathered_message& message,
+    std::uint8_t seqnum,
+    bytestring& storage,
+    std::vector<boost::asio::const_buffer>& output
+)
+{
+    // A packet of exactly MAX_PACKET_SIZE bytes must be followed by another one,
+    // even if it's empty. storage is not reallocated after we start referencing it
+    std::size_t bufsize = message.size();
+    std::size_t num_packets = bufsize / MAX_PACKET_SIZE + 1;
+    storage.clear();
+    storage.reserve(num_packets * 4 + message.owned_size());
+    output.clear();
+    std::size_t transferred_size = 0;
+    std::uint32_t packet_remaining = 0;
+
+    auto add_buffer = [&output](boost::asio::const_buffer buff) {
+        if (!output.empty() &&
+            static_cast<const std::uint8_t*>(output.back().data()) + output.back().size() == buff.data())
+        {
+            output.back() = boost::asio::const_buffer(output.back().data(), output.back().size() + buff.size());
+        }
+        else
+        {
+            output.push_back(buff);
+        }
+    };
+
+    auto add_owned = [&](const std::uint8_t* data, std::size_t size) {
+        assert(storage.size() + size <= storage.capacity());
+        const std::uint8_t* pos = storage.data() + storage.size();
+        storage.insert(storage.end(), data, data + size);
+        add_buffer(boost::asio::const_buffer(pos, size));
+    };
+
+    auto add_header = [&]() {
+        packet_remaining = compute_size_to_write(bufsize, transferred_size);
+        std::uint8_t header [4] {
+            static_cast<std::uint8_t>(packet_remaining),
+            static_cast<std::uint8_t>(packet_remaining >> 8),
+            static_cast<std::uint8_t>(packet_remaining >> 16),
+            seqnum++
+        };
+        add_owned(header, 4);
+        transferred_size += packet_remaining;
+        --num_packets;
+    };
+
+    add_header();
+    message.for_each_segment([&](boost::asio::const_buffer buff, bool is_external) {
+        while (buff.size() > 0)
+        {
+            if (packet_remaining == 0)
+                add_header();
+            std::size_t size = (std::min)(static_cast<std::size_t>(packet_remaining), buff.size());
+            if (is_external)
+                add_buffer(boost::asio::buffer(buff, size));
+            else
+                add_owned(static_cast<const std::uint8_t*>(buff.data()), size);
+            buff += size;
+            packet_remaining -= static_cast<std::uint32_t>(size);
+        }
+    });
+
+    // Trailing empty packet, if required
+    while (num_packets > 0)
+        add_header();
+    return seqnum;
 }
 
 template <class Stream>
@@ -56,19 +204,7 @@ boost::mysql::error_code boost::mysql::detail::channel<Stream>::process_header_r
     std::uint32_t& size_to_read
 )
 {
-    packet_header header;
-    deserialization_context ctx (boost::asio::buffer(header_buffer_), capabilities(0)); // unaffected by capabilities
-    errc err = deserialize(ctx, header);
-    if (err != errc::ok)
-    {
-        return make_error_code(err);
-    }
-    if (!process_sequence_number(header.sequence_number))
-    {
-        return make_error_code(errc::sequence_number_mismatch);
-    }
-    size_to_read = header.packet_size.value;
-    return error_code();
+    return process_packet_header(boost::asio::buffer(header_buffer_), sequence_number_, size_to_read);
 }
 
 template <class Stream>
@@ -120,7 +256,7 @@ std::size_t boost::mysql::detail::channel<Stream>::write_impl(
 template <class Stream>
 template <class BufferSeq, class CompletionToken>
 BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(boost::mysql::error_code, std::size_t))
-boost::mysql::detail::channel<Stream>::async_read_impl(
+boost::mysql::detail::channel<Stream>::async_read_untimed(
     BufferSeq&& buff,
     CompletionToken&& token
 )
@@ -148,7 +284,7 @@ boost::mysql::detail::channel<Stream>::async_read_impl(
 template <class Stream>
 template <class BufferSeq, class CompletionToken>
 BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(boost::mysql::error_code, std::size_t))
-boost::mysql::detail::channel<Stream>::async_write_impl(
+boost::mysql::detail::channel<Stream>::async_write_untimed(
     BufferSeq&& buff,
     CompletionToken&& token
 )
@@ -171,6 +307,166 @@ boost::mysql::detail::channel<Stream>::async_write_impl(
     }
 }
 
+template <class Stream>
+void boost::mysql::detail::channel<Stream>::arm_timer()
+{
+    if (!timer_)
+        timer_ = std::make_shared<timer_state>(stream_.get_executor());
+    timer_->chan = this;
+    timer_->timed_out = false;
+    timer_->timer.expires_at(deadline_);
+    std::uint64_t generation = ++timer_->generation;
+    std::weak_ptr<timer_state> weak_state (timer_);
+    timer_->timer.async_wait([weak_state, generation](error_code err) {
+        // The channel may have been destroyed while this handler was queued.
+        // The I/O may have completed after the timer expired, but before
+        // this handler ran. The generation tells us whether it's still pending
+        auto state = weak_state.lock();
+        if (state && !err && generation == state->generation)
+        {
+            state->timed_out = true;
+            state->chan->close_fn_(*state->chan);
+        }
+    });
+}
+
+template <class Stream>
+bool boost::mysql::detail::channel<Stream>::disarm_timer()
+{
+    ++timer_->generation;
+    timer_->timer.cancel();
+    return timer_->timed_out;
+}
+
+// Runs the I/O launched by Initiation with the timer armed.
+// I/O interrupted by the timer completes with errc::timeout
+template <class Stream>
+template <class Initiation>
+struct boost::mysql::detail::channel<Stream>::timed_op
+{
+    channel<Stream>& chan_;
+    Initiation initiation_;
+
+    template <class Self>
+    void operator()(Self& self)
+    {
+        chan_.arm_timer();
+        initiation_(chan_, std::move(self));
+    }
+
+    template <class Self, class... Args>
+    void operator()(Self& self, error_code code, Args... args)
+    {
+        if (chan_.disarm_timer())
+            code = make_error_code(errc::timeout);
+        self.complete(code, args...);
+    }
+};
+
+template <class Stream>
+template <class BufferSeq>
+struct boost::mysql::detail::channel<Stream>::read_initiation
+{
+    BufferSeq buff_;
+
+    template <class Handler>
+    void operator()(channel<Stream>& chan, Handler&& handler)
+    {
+        chan.async_read_untimed(buff_, std::forward<Handler>(handler));
+    }
+};
+
+template <class Stream>
+template <class BufferSeq>
+struct boost::mysql::detail::channel<Stream>::write_initiation
+{
+    BufferSeq buff_;
+
+    template <class Handler>
+    void operator()(channel<Stream>& chan, Handler&& handler)
+    {
+        chan.async_write_untimed(buff_, std::forward<Handler>(handler));
+    }
+};
+
+template <class Stream>
+struct boost::mysql::detail::channel<Stream>::ssl_handshake_initiation
+{
+    template <class Handler>
+    void operator()(channel<Stream>& chan, Handler&& handler)
+    {
+        chan.ssl_stream_->async_handshake(
+            boost::asio::ssl::stream_base::client,
+            std::forward<Handler>(handler)
+        );
+    }
+};
+
+template <class Stream>
+template <class Endpoint>
+struct boost::mysql::detail::channel<Stream>::connect_initiation
+{
+    Endpoint endpoint_;
+
+    template <class Handler>
+    void operator()(channel<Stream>& chan, Handler&& handler)
+    {
+        chan.stream_.async_connect(endpoint_, std::forward<Handler>(handler));
+    }
+};
+
+template <class Stream>
+template <class BufferSeq, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(boost::mysql::error_code, std::size_t))
+boost::mysql::detail::channel<Stream>::async_read_impl(
+    BufferSeq&& buff,
+    CompletionToken&& token
+)
+{
+    if (has_deadline())
+    {
+        using initiation_type = read_initiation<typename std::decay<BufferSeq>::type>;
+        return boost::asio::async_compose<CompletionToken, void(error_code, std::size_t)>(
+            timed_op<initiation_type>{*this, initiation_type{std::forward<BufferSeq>(buff)}},
+            token,
+            *this
+        );
+    }
+    else
+    {
+        return async_read_untimed(
+            std::forward<BufferSeq>(buff),
+            std::forward<CompletionToken>(token)
+        );
+    }
+}
+
+template <class Stream>
+template <class BufferSeq, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(boost::mysql::error_code, std::size_t))
+boost::mysql::detail::channel<Stream>::async_write_impl(
+    BufferSeq&& buff,
+    CompletionToken&& token
+)
+{
+    if (has_deadline())
+    {
+        using initiation_type = write_initiation<typename std::decay<BufferSeq>::type>;
+        return boost::asio::async_compose<CompletionToken, void(error_code, std::size_t)>(
+            timed_op<initiation_type>{*this, initiation_type{std::forward<BufferSeq>(buff)}},
+            token,
+            *this
+        );
+    }
+    else
+    {
+        return async_write_untimed(
+            std::forward<BufferSeq>(buff),
+            std::forward<CompletionToken>(token)
+        );
+    }
+}
+
 template <class Stream>
 void boost::mysql::detail::channel<Stream>::read(
     bytestring& buffer,
@@ -208,6 +504,152 @@ void boost::mysql::detail::channel<Stream>::read(
     } while (size_to_read == MAX_PACKET_SIZE);
 }
 
+template <class Stream>
+std::size_t boost::mysql::detail::channel<Stream>::read_partial(
+    boost::asio::mutable_buffer buffer,
+    error_code& code
+)
+{
+    assert(buffer.size() > 0);
+    code.clear();
+    auto header_buff = boost::asio::buffer(header_buffer_);
+
+    while (!partial_done_)
+    {
+        if (partial_header_pending_)
+        {
+            read_impl(header_buff, code);
+            valgrind_make_mem_defined(header_buff);
+            if (code)
+                return 0;
+
+            std::uint32_t size_to_read = 0;
+            code = process_header_read(size_to_read);
+            if (code)
+                return 0;
+            process_partial_header(size_to_read);
+        }
+
+        if (partial_packet_remaining_ == 0)
+        {
+            process_partial_packet_end();
+            continue;
+        }
+
+        auto read_buffer = boost::asio::buffer(
+            buffer,
+            (std::min)(static_cast<std::size_t>(partial_packet_remaining_), buffer.size())
+        );
+        std::size_t bytes_read = read_impl(read_buffer, code);
+        valgrind_make_mem_defined(read_buffer);
+        if (code)
+            return 0;
+        partial_packet_remaining_ -= static_cast<std::uint32_t>(bytes_read);
+        return bytes_read;
+    }
+
+    return 0;
+}
+
+template<class Stream>
+struct boost::mysql::detail::channel<Stream>::read_partial_op
+    : boost::asio::coroutine
+{
+    channel<Stream>& chan_;
+    boost::asio::mutable_buffer buffer_;
+
+    read_partial_op(
+        channel<Stream>& chan,
+        boost::asio::mutable_buffer buffer
+    ) :
+        chan_(chan),
+        buffer_(buffer)
+    {
+    }
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code code = {},
+        std::size_t bytes_transferred=0
+    )
+    {
+        // Error checking
+        check_cancellation(self, code);
+        if (code)
+        {
+            self.complete(code, 0);
+            return;
+        }
+
+        // Non-error path
+        std::uint32_t size_to_read = 0;
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            while (!chan_.partial_done_)
+            {
+                if (chan_.partial_header_pending_)
+                {
+                    BOOST_ASIO_CORO_YIELD chan_.async_read_impl(
+                        boost::asio::buffer(chan_.header_buffer_),
+                        std::move(self)
+                    );
+                    valgrind_make_mem_defined(boost::asio::buffer(chan_.header_buffer_));
+
+                    code = chan_.process_header_read(size_to_read);
+                    if (code)
+                    {
+                        self.complete(code, 0);
+                        BOOST_ASIO_CORO_YIELD break;
+                    }
+                    chan_.process_partial_header(size_to_read);
+                }
+
+                if (chan_.partial_packet_remaining_ == 0)
+                {
+                    chan_.process_partial_packet_end();
+                    continue;
+                }
+
+                BOOST_ASIO_CORO_YIELD chan_.async_read_impl(
+                    boost::asio::buffer(
+                        buffer_,
+                        (std::min)(static_cast<std::size_t>(chan_.partial_packet_remaining_), buffer_.size())
+                    ),
+                    std::move(self)
+                );
+                valgrind_make_mem_defined(boost::asio::buffer(buffer_, bytes_transferred));
+                chan_.partial_packet_remaining_ -= static_cast<std::uint32_t>(bytes_transferred);
+                self.complete(error_code(), bytes_transferred);
+                BOOST_ASIO_CORO_YIELD break;
+            }
+
+            // The message had already been read. Ensure return as if by post
+            BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+            self.complete(error_code(), 0);
+        }
+    }
+};
+
+template <class Stream>
+template <class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, std::size_t)
+)
+boost::mysql::detail::channel<Stream>::async_read_partial(
+    boost::asio::mutable_buffer buffer,
+    CompletionToken&& token
+)
+{
+    assert(buffer.size() > 0);
+    return boost::asio::async_compose<CompletionToken, void(error_code, std::size_t)>(
+        read_partial_op(*this, buffer),
+        token,
+        *this
+    );
+}
+
 template <class Stream>
 void boost::mysql::detail::channel<Stream>::write(
     boost::asio::const_buffer buffer,
@@ -218,6 +660,11 @@ void boost::mysql::detail::channel<Stream>::write(
     auto bufsize = buffer.size();
     auto first = static_cast<const std::uint8_t*>(buffer.data());
 
+    // Deferred requests go together with the first packet of a command
+    boost::asio::const_buffer pending;
+    if (sequence_number_ == 0)
+        pending = take_pending_writes();
+
     // If the packet is empty, we should still write the header, saying
     // we are sending an empty packet.
     do
@@ -225,7 +672,8 @@ void boost::mysql::detail::channel<Stream>::write(
         auto size_to_write = compute_size_to_write(bufsize, transferred_size);
         process_header_write(size_to_write);
         write_impl(
-            std::array<boost::asio::const_buffer, 2> {
+            std::array<boost::asio::const_buffer, 3> {
+                pending,
                 boost::asio::buffer(header_buffer_),
                 boost::asio::buffer(first + transferred_size, size_to_write)
             },
@@ -233,10 +681,36 @@ void boost::mysql::detail::channel<Stream>::write(
         );
         if (code)
             return;
+        pending = boost::asio::const_buffer();
         transferred_size += size_to_write;
     } while (transferred_size < bufsize);
 }
 
+template <class Stream>
+void boost::mysql::detail::channel<Stream>::write(
+    const gathered_message& message,
+    error_code& code
+)
+{
+    bytestring storage;
+    std::vector<boost::asio::const_buffer> buffers;
+    boost::asio::const_buffer pending;
+    if (sequence_number_ == 0)
+        pending = take_pending_writes();
+    sequence_number_ = frame_gathered_message(message, sequence_number_, storage, buffers);
+    if (pending.size() > 0)
+        buffers.insert(buffers.begin(), pending);
+    write_impl(buffers, code);
+}
+
+template <class Stream>
+void boost::mysql::detail::channel<Stream>::defer_write(
+    boost::asio::const_buffer message
+)
+{
+    frame_message(message, 0, pending_writes_);
+}
+
 template<class Stream>
 struct boost::mysql::detail::channel<Stream>::read_op
     : boost::asio::coroutine
@@ -262,6 +736,7 @@ struct boost::mysql::detail::channel<Stream>::read_op
     )
     {
         // Error checking
+        check_cancellation(self, code);
         if (code)
         {
             self.complete(code);
@@ -330,6 +805,7 @@ struct boost::mysql::detail::channel<Stream>::write_op
 {
     channel<Stream>& chan_;
     boost::asio::const_buffer buffer_;
+    boost::asio::const_buffer pending_; // deferred requests, written with the first packet
     std::size_t total_transferred_size_ = 0;
 
     write_op(
@@ -339,6 +815,8 @@ struct boost::mysql::detail::channel<Stream>::write_op
         chan_(chan),
         buffer_(buffer)
     {
+        if (chan.sequence_number_ == 0)
+            pending_ = chan.take_pending_writes();
     }
 
     template<class Self>
@@ -349,6 +827,7 @@ struct boost::mysql::detail::channel<Stream>::write_op
     )
     {
         // Error handling
+        check_cancellation(self, code);
         if (code)
         {
             self.complete(code);
@@ -366,14 +845,16 @@ struct boost::mysql::detail::channel<Stream>::write_op
                 chan_.process_header_write(size_to_write);
 
                 BOOST_ASIO_CORO_YIELD chan_.async_write_impl(
-                    std::array<boost::asio::const_buffer, 2> {
+                    std::array<boost::asio::const_buffer, 3> {
+                        pending_,
                         boost::asio::buffer(chan_.header_buffer_),
                         boost::asio::buffer(buffer_ + total_transferred_size_, size_to_write)
                     },
                     std::move(self)
                 );
 
-                total_transferred_size_ += (bytes_transferred - 4); // header size
+                total_transferred_size_ += (bytes_transferred - 4 - pending_.size()); // header size
+                pending_ = boost::asio::const_buffer();
 
             } while (total_transferred_size_ < buffer_.size());
 
@@ -403,19 +884,17 @@ boost::mysql::detail::channel<Stream>::async_write(
 template <typename Stream>
 void boost::mysql::detail::channel<Stream>::create_ssl_stream()
 {
-    // Determine the context to use
-    boost::asio::ssl::context* ctx = external_ctx_;
-    if (!ctx)
+    if (external_ctx_)
     {
-        if (!local_ctx_)
-        {
-            local_ctx_.emplace(boost::asio::ssl::context::tls_client);
-        }
-        ctx = &*local_ctx_;
+        ssl_stream_.emplace(stream_, *external_ctx_);
+    }
+    else
+    {
+        // The default context is shared, which enables session resumption
+        auto& default_ctx = default_ssl_context::instance();
+        ssl_stream_.emplace(stream_, default_ctx.context());
+        default_ctx.prepare(ssl_stream_->native_handle(), endpoint_key_);
     }
-
-    // Actually create the stream
-    ssl_stream_.emplace(stream_, *ctx);
 }
 
 template <class Stream>
@@ -438,10 +917,21 @@ boost::mysql::detail::channel<Stream>::async_ssl_handshake(
 )
 {
     create_ssl_stream();
-    return ssl_stream_->async_handshake(
-        boost::asio::ssl::stream_base::client,
-        std::forward<CompletionToken>(token)
-    );
+    if (has_deadline())
+    {
+        return boost::asio::async_compose<CompletionToken, void(error_code)>(
+            timed_op<ssl_handshake_initiation>{*this, ssl_handshake_initiation{}},
+            token,
+            *this
+        );
+    }
+    else
+    {
+        return ssl_stream_->async_handshake(
+            boost::asio::ssl::stream_base::client,
+            std::forward<CompletionToken>(token)
+        );
+    }
 }
 
 template <class Stream>
@@ -453,5 +943,30 @@ boost::mysql::error_code boost::mysql::detail::channel<Stream>::close()
     return err;
 }
 
+template <class Stream>
+template <class Endpoint, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::detail::channel<Stream>::async_connect(
+    const Endpoint& endpoint,
+    CompletionToken&& token
+)
+{
+    if (has_deadline())
+    {
+        return boost::asio::async_compose<CompletionToken, void(error_code)>(
+            timed_op<connect_initiation<Endpoint>>{*this, connect_initiation<Endpoint>{endpoint}},
+            token,
+            *this
+        );
+    }
+    else
+    {
+        return stream_.async_connect(endpoint, std::forward<CompletionToken>(token));
+    }
+}
+
 
 #endif
@@ -44,6 +44,71 @@ inline bool is_unsigned(
     return input.is<std::uint64_t>();
 }
 
+// Serializes everything in an execute message but the parameter values
+template <class ValueForwardIterator>
+void serialize_stmt_execute_head(
+    serialization_context& ctx,
+    const com_stmt_execute_packet<ValueForwardIterator>& input
+) noexcept
+{
+    constexpr std::uint8_t command_id = com_stmt_execute_packet<ValueForwardIterator>::command_id;
+    serialize(
+        ctx,
+        command_id,
+        input.statement_id,
+        input.flags,
+        input.iteration_count
+    );
+
+    // Number of parameters
+    auto num_params = std::distance(input.params_begin, input.params_end);
+    assert(num_params >= 0 && num_params <= 255);
+
+    // NULL bitmap (already size zero if num_params == 0)
+    null_bitmap_traits traits (stmt_execute_null_bitmap_offset, num_params);
+    std::size_t i = 0;
+    std::memset(ctx.first(), 0, traits.byte_count()); // Initialize to zeroes
+    for (auto it = input.params_begin; it != input.params_end; ++it, ++i)
+    {
+        if (it->is_null() && !input.is_long_data(i))
+        {
+            traits.set_null(ctx.first(), i);
+        }
+    }
+    ctx.advance(traits.byte_count());
+
+    // new parameters bind flag
+    serialize(ctx, input.new_params_bind_flag);
+
+    // value metadata
+    // (the server requires long data parameters to have a string or blob type)
+    com_stmt_execute_param_meta_packet meta;
+    i = 0;
+    for (auto it = input.params_begin; it != input.params_end; ++it, ++i)
+    {
+        if (input.is_long_data(i))
+        {
+            meta.type = protocol_field_type::blob;
+            meta.unsigned_flag = 0;
+        }
+        else
+        {
+            meta.type = get_protocol_field_type(*it);
+            meta.unsigned_flag = is_unsigned(*it) ? 0x80 : 0;
+        }
+        serialize(ctx, meta);
+    }
+}
+
+// Number of bytes of a value that a gathered message references, rather than copies
+inline std::size_t get_gathered_size(
+    const value& input
+) noexcept
+{
+    auto str = input.get_optional<boost::string_view>();
+    return str && str->size() >= min_gathered_string_size ? str->size() : 0;
+}
+
 } // detail
 } // mysql
 } // boost
@@ -85,9 +150,11 @@ boost::mysql::detail::serialization_traits<
     res += null_bitmap_traits(stmt_execute_null_bitmap_offset, num_params).byte_count();
     res += get_size(ctx, value.new_params_bind_flag);
     res += get_size(ctx, com_stmt_execute_param_meta_packet{}) * num_params;
-    for (auto it = value.params_begin; it != value.params_end; ++it)
+    std::size_t i = 0;
+    for (auto it = value.params_begin; it != value.params_end; ++it, ++i)
     {
-        res += get_size(ctx, *it);
+        if (!value.is_long_data(i))
+            res += get_size(ctx, *it);
     }
     return res;
 }
@@ -102,49 +169,56 @@ boost::mysql::detail::serialization_traits<
     const com_stmt_execute_packet<ValueForwardIterator>& input
 ) noexcept
 {
-    constexpr std::uint8_t command_id = com_stmt_execute_packet<ValueForwardIterator>::command_id;
-    serialize(
-        ctx,
-        command_id,
-        input.statement_id,
-        input.flags,
-        input.iteration_count
-    );
+    serialize_stmt_execute_head(ctx, input);
 
-    // Number of parameters
-    auto num_params = std::distance(input.params_begin, input.params_end);
-    assert(num_params >= 0 && num_params <= 255);
-
-    // NULL bitmap (already size zero if num_params == 0)
-    null_bitmap_traits traits (stmt_execute_null_bitmap_offset, num_params);
+    // actual values. Long data values were already sent
     std::size_t i = 0;
-    std::memset(ctx.first(), 0, traits.byte_count()); // Initialize to zeroes
     for (auto it = input.params_begin; it != input.params_end; ++it, ++i)
     {
-        if (it->is_null())
-        {
-            traits.set_null(ctx.first(), i);
-        }
+        if (!input.is_long_data(i))
+            serialize(ctx, *it);
     }
-    ctx.advance(traits.byte_count());
-
-    // new parameters bind flag
-    serialize(ctx, input.new_params_bind_flag);
+}
 
-    // value metadata
-    com_stmt_execute_param_meta_packet meta;
-    for (auto it = input.params_begin; it != input.params_end; ++it)
+template <class ValueForwardIterator>
+void boost::mysql::detail::serialize_stmt_execute_gathered(
+    const com_stmt_execute_packet<ValueForwardIterator>& input,
+    capabilities caps,
+    gathered_message& output
+)
+{
+    // Compute the size of everything but the contents of big strings
+    serialization_context ctx (caps);
+    std::size_t owned_size = get_size(ctx, input);
+    std::size_t i = 0;
+    for (auto it = input.params_begin; it != input.params_end; ++it, ++i)
     {
-        meta.type = get_protocol_field_type(*it);
-        meta.unsigned_flag = is_unsigned(*it) ? 0x80 : 0;
-        serialize(ctx, meta);
+        if (!input.is_long_data(i))
+            owned_size -= get_gathered_size(*it);
     }
 
-    // actual values
-    for (auto it = input.params_begin; it != input.params_end; ++it)
+    // Serialize, adding big string contents as external buffers
+    output.reset(owned_size);
+    ctx.set_first(output.owned_data());
+    serialize_stmt_execute_head(ctx, input);
+    i = 0;
+    for (auto it = input.params_begin; it != input.params_end; ++it, ++i)
     {
-        serialize(ctx, *it);
+        if (input.is_long_data(i))
+            continue;
+        const value& v = *it;
+        if (get_gathered_size(v) > 0)
+        {
+            auto str = v.get<boost::string_view>();
+            serialize(ctx, int_lenenc(str.size()));
+            output.add_external(ctx.first(), str.data(), str.size());
+        }
+        else
+        {
+            serialize(ctx, v);
+        }
     }
+    output.finish(ctx.first());
 }
 
 
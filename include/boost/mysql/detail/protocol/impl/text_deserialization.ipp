@@ -381,6 +381,40 @@ boost::mysql::error_code boost::mysql::detail::deserialize_text_row(
     return error_code();
 }
 
+inline boost::mysql::error_code boost::mysql::detail::index_text_row(
+    deserialization_context& ctx,
+    const std::vector<field_metadata>& fields,
+    std::vector<field_ref>& output
+)
+{
+    const std::uint8_t* message_begin = ctx.first();
+    output.resize(fields.size());
+    for (std::vector<field_ref>::size_type i = 0; i < fields.size(); ++i)
+    {
+        if (is_next_field_null(ctx))
+        {
+            ctx.advance(1);
+            output[i] = field_ref {0, 0, true};
+        }
+        else
+        {
+            string_lenenc value_str;
+            errc err = deserialize(ctx, value_str);
+            if (err != errc::ok)
+                return make_error_code(err);
+            auto offset = reinterpret_cast<const std::uint8_t*>(value_str.value.data()) - message_begin;
+            output[i] = field_ref {
+                static_cast<std::uint32_t>(offset),
+                static_cast<std::uint32_t>(value_str.value.size()),
+                false
+            };
+        }
+    }
+    if (!ctx.empty())
+        return make_error_code(errc::extra_bytes);
+    return error_code();
+}
+
 #ifdef BOOST_MSVC
 #pragma warning( pop )
 #endif
@@ -10,7 +10,9 @@
 
 #include <boost/mysql/detail/protocol/serialization.hpp>
 #include <boost/mysql/detail/protocol/constants.hpp>
+#include <boost/mysql/detail/protocol/gathered_message.hpp>
 #include <boost/mysql/value.hpp>
+#include <vector>
 
 namespace boost {
 namespace mysql {
@@ -74,9 +76,19 @@ struct com_stmt_execute_packet
     std::uint8_t new_params_bind_flag;
     ValueForwardIterator params_begin;
     ValueForwardIterator params_end;
+    // Parameters whose value was sent using COM_STMT_SEND_LONG_DATA.
+    // Their values are not sent again. May be nullptr
+    const std::vector<bool>* long_data_params;
 
     static constexpr std::uint8_t command_id = 0x17;
 
+    bool is_long_data(std::size_t param_index) const noexcept
+    {
+        return long_data_params &&
+            param_index < long_data_params->size() &&
+            (*long_data_params)[param_index];
+    }
+
     template <class Self, class Callable>
     static void apply(Self& self, Callable&& cb)
     {
@@ -116,6 +128,35 @@ struct com_stmt_execute_param_meta_packet
     }
 };
 
+// send long data
+struct com_stmt_send_long_data_packet
+{
+    std::uint32_t statement_id;
+    std::uint16_t param_id;
+    string_eof data;
+
+    static constexpr std::uint8_t command_id = 0x18;
+
+    template <class Self, class Callable>
+    static void apply(Self& self, Callable&& cb)
+    {
+        std::forward<Callable>(cb)(
+            self.statement_id,
+            self.param_id,
+            self.data
+        );
+    }
+};
+
+// Serializes an execute message, referencing big string parameters
+// instead of copying them. These must be kept alive until the message is sent
+template <class ValueForwardIterator>
+void serialize_stmt_execute_gathered(
+    const com_stmt_execute_packet<ValueForwardIterator>& input,
+    capabilities caps,
+    gathered_message& output
+);
+
 // close
 struct com_stmt_close_packet
 {
@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_PROTOCOL_SSL_SESSION_CACHE_HPP
+#define BOOST_MYSQL_DETAIL_PROTOCOL_SSL_SESSION_CACHE_HPP
+
+#include <boost/asio/ssl/context.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Client-side TLS session cache, keyed by server endpoint. Thread-safe
+class ssl_session_cache
+{
+    std::mutex mtx_;
+    std::unordered_map<std::string, SSL_SESSION*> sessions_;
+public:
+    ssl_session_cache() = default;
+    ssl_session_cache(const ssl_session_cache&) = delete;
+    ssl_session_cache& operator=(const ssl_session_cache&) = delete;
+    ~ssl_session_cache()
+    {
+        for (const auto& entry: sessions_)
+            SSL_SESSION_free(entry.second);
+    }
+
+    // Takes ownership of session, replacing any previous one for key
+    void put(const std::string& key, SSL_SESSION* session)
+    {
+        std::lock_guard<std::mutex> guard (mtx_);
+        SSL_SESSION*& entry = sessions_[key];
+        if (entry)
+            SSL_SESSION_free(entry);
+        entry = session;
+    }
+
+    // Makes ssl attempt to resume the session cached for key, if any.
+    // Returns whether there was such a session
+    bool resume(const std::string& key, SSL* ssl)
+    {
+        std::lock_guard<std::mutex> guard (mtx_);
+        auto it = sessions_.find(key);
+        return it != sessions_.end() && SSL_set_session(ssl, it->second) == 1;
+    }
+
+    std::size_t size()
+    {
+        std::lock_guard<std::mutex> guard (mtx_);
+        return sessions_.size();
+    }
+};
+
+// The SSL context used by connections not given one explicitly. Shared among
+// all of them, so sessions negotiated by a connection can be resumed by any other
+// one connecting to the same endpoint (e.g. when reconnecting after a failover).
+class default_ssl_context
+{
+    boost::asio::ssl::context ctx_ {boost::asio::ssl::context::tls_client};
+    ssl_session_cache sessions_;
+    int key_index_; // SSL ex_data index holding the endpoint key
+
+    // Called by OpenSSL when the server sends a new session (with TLS 1.3,
+    // this happens after the handshake). Returns 1 if we took ownership
+    static int on_new_session(SSL* ssl, SSL_SESSION* session)
+    {
+        auto& self = instance();
+        auto key = static_cast<const std::string*>(SSL_get_ex_data(ssl, self.key_index_));
+        if (!key)
+            return 0;
+        self.sessions_.put(*key, session);
+        return 1;
+    }
+
+    default_ssl_context() :
+        key_index_(SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr))
+    {
+        SSL_CTX_set_session_cache_mode(
+            ctx_.native_handle(),
+            SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE
+        );
+        SSL_CTX_sess_set_new_cb(ctx_.native_handle(), &on_new_session);
+    }
+public:
+    static default_ssl_context& instance()
+    {
+        static default_ssl_context res;
+        return res;
+    }
+
+    boost::asio::ssl::context& context() noexcept { return ctx_; }
+    ssl_session_cache& sessions() noexcept { return sessions_; }
+
+    // Sets up ssl to resume and store sessions for endpoint key, if any.
+    // key must be alive until ssl is freed
+    void prepare(SSL* ssl, const std::string& key)
+    {
+        if (key.empty())
+            return;
+        SSL_set_ex_data(ssl, key_index_, const_cast<std::string*>(&key));
+        sessions_.resume(key, ssl);
+    }
+};
+
+} // detail
+} // mysql
+} // boost
+
+#endif
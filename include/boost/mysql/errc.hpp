@@ -1525,6 +1525,14 @@ enum class errc : int
     unknown_auth_plugin = 65541, ///< Client error. The user employs an authentication plugin not known to this library
     auth_plugin_requires_ssl = 65542, ///< Client error. The authentication plugin requires the connection to use SSL
     wrong_num_params = 65543, ///< Client error. The number of parameters passed to the prepared statement does not match the number of actual parameters
+    local_infile_disabled = 65544, ///< Client error. The server requested the contents of a local file, but no local infile handler was set
+    unrepresentable_value = 65545, ///< Client error. A value can't be represented as a SQL literal (e.g. NaN or infinity floating point values)
+    field_not_streamable = 65546, ///< Client error. The field requested to be streamed is not a string (only string, blob and similar fields can be streamed)
+    invalid_format_string = 65547, ///< Client error. The format string passed to format_sql is malformed, or its number of placeholders doesn't match the number of arguments
+    invalid_public_key = 65548, ///< Client error. The server RSA public key used to encrypt the password is invalid, or too small for the password length
+    cleartext_password_unavailable = 65549, ///< Client error. The server requested the password in full, but only password hashes were provided
+    timeout = 65550, ///< Client error. The operation didn't complete before the connection timeout elapsed, and the connection was closed
+    unsafe_charset = 65551, ///< Client error. SQL can't be composed client-side for the connection character set, as its strings can't be escaped safely (e.g. gbk or sjis)
 };
 
 /**
@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_EXPERIMENTAL_CONNECTION_ENGINE_HPP
+#define BOOST_MYSQL_EXPERIMENTAL_CONNECTION_ENGINE_HPP
+
+#include <boost/mysql/connection_params.hpp>
+#include <boost/mysql/error.hpp>
+#include <boost/mysql/metadata.hpp>
+#include <boost/mysql/row.hpp>
+#include <boost/mysql/detail/network_algorithms/handshake.hpp>
+#include <boost/mysql/detail/network_algorithms/execute_generic.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/utility/string_view.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+namespace experimental {
+
+/**
+ * \brief (Experimental) A MySQL client protocol implementation that performs no I/O (sans-I/O).
+ * \details This class implements a subset of the protocol implemented by [reflink connection],
+ * but doesn't read from or write to any stream. Instead, the user is responsible
+ * for transferring bytes between the engine and the server, which allows
+ * driving connections from event loops other than Asio's (e.g. a custom reactor).
+ *
+ * This class is experimental: its interface may change in future releases
+ * without notice. It shares message framing and protocol processing with
+ * [reflink connection], but [reflink connection] is not implemented on top of it.
+ *
+ * The engine is driven by calling [reflink2 experimental__connection_engine.next_event connection_engine::next_event] repeatedly,
+ * and acting according to the returned [reflink2 experimental__connection_engine.event connection_engine::event]:
+ *
+ * - `event::write`: write [reflink2 experimental__connection_engine.output connection_engine::output] to the server, then call
+ *   [reflink2 experimental__connection_engine.consume_output connection_engine::consume_output] with the number of bytes written.
+ * - `event::need_input`: read data from the server into the buffer returned by
+ *   [reflink2 experimental__connection_engine.prepare_input connection_engine::prepare_input], then call [reflink2 experimental__connection_engine.commit_input connection_engine::commit_input]
+ *   with the number of bytes read.
+ * - `event::fields` and `event::row`: metadata and rows for the current query.
+ * - `event::done` and `event::error`: the current operation has finished.
+ *
+ * Constructing the engine starts a handshake. Once it completes, operations can be
+ * started with [reflink2 experimental__connection_engine.start_query connection_engine::start_query] and [reflink2 experimental__connection_engine.start_quit connection_engine::start_quit],
+ * as long as [reflink2 experimental__connection_engine.ready connection_engine::ready] returns `true`.
+ *
+ * TLS is not supported: [refmem ssl_mode enable] behaves like [refmem ssl_mode disable],
+ * and [refmem ssl_mode require] makes the handshake fail with
+ * [link mysql.ref.boost__mysql__errc `errc::server_unsupported`] if the server
+ * supports TLS. Prepared statements and `LOAD DATA LOCAL INFILE` are not supported, either.
+ */
+class connection_engine
+{
+public:
+    /// The events reported by [reflink2 experimental__connection_engine.next_event connection_engine::next_event].
+    enum class event
+    {
+        /// More data must be read from the server.
+        need_input,
+
+        /// [reflink2 experimental__connection_engine.output connection_engine::output] must be written to the server.
+        write,
+
+        /// The current query returned a resultset, and its metadata is available in [reflink2 experimental__connection_engine.fields connection_engine::fields].
+        fields,
+
+        /// A row of the current query is available in [reflink2 experimental__connection_engine.current_row connection_engine::current_row].
+        row,
+
+        /// The current operation completed successfully.
+        done,
+
+        /// The current operation failed. See [reflink2 experimental__connection_engine.last_error connection_engine::last_error].
+        error
+    };
+
+    /**
+     * \brief Constructor. Starts a handshake, using `params`.
+     * \details The strings pointed to by params should be kept alive
+     * until the handshake completes, as no copy is made.
+     */
+    explicit inline connection_engine(const connection_params& params);
+
+    /**
+     * \brief Advances the engine as much as possible with the input received so far.
+     * \details Returns the action required to make progress, or the result of the current operation.
+     * Calling this function when there is no operation in progress returns `event::done`,
+     * or `event::error` if the connection can no longer be used.
+     */
+    inline event next_event();
+
+    /// Returns whether an operation can be started.
+    bool ready() const noexcept { return state_ == state::idle; }
+
+    /// The server-side ID of this connection (see [refmem connection connection_id]). Valid after the handshake.
+    std::uint32_t connection_id() const noexcept { return handshake_.connection_id(); }
+
+    /**
+     * \brief Starts executing a text query.
+     * \details Resultsets with fields report `event::fields`, then `event::row` for each row.
+     * Precondition: `ready() == true`.
+     */
+    inline void start_query(boost::string_view query_string);
+
+    /**
+     * \brief Starts notifying the server that the client wants to end the session.
+     * \details The user is responsible for closing the underlying transport afterwards.
+     * Precondition: `ready() == true`.
+     */
+    inline void start_quit();
+
+    /// Returns a buffer of `size` bytes, where data read from the server should be placed.
+    inline boost::asio::mutable_buffer prepare_input(std::size_t size);
+
+    /// Marks `size` bytes of the last buffer returned by [reflink2 experimental__connection_engine.prepare_input connection_engine::prepare_input] as read.
+    inline void commit_input(std::size_t size);
+
+    /// Copies `data`, read from the server, into the engine.
+    inline void feed(boost::asio::const_buffer data);
+
+    /// Returns the data that should be written to the server.
+    boost::asio::const_buffer output() const noexcept
+    {
+        return boost::asio::buffer(output_.data() + output_pos_, output_.size() - output_pos_);
+    }
+
+    /// Marks the first `size` bytes of [reflink2 experimental__connection_engine.output connection_engine::output] as written.
+    inline void consume_output(std::size_t size);
+
+    /// The fields of the current resultset. Valid after `event::fields`, until the next operation starts.
+    const std::vector<field_metadata>& fields() const noexcept { return metadata_.fields(); }
+
+    /// The row just read. Valid after `event::row`, until [reflink2 experimental__connection_engine.next_event connection_engine::next_event] is called again.
+    const row& current_row() const noexcept { return row_; }
+
+    /// The number of rows affected by the last query. Valid after `event::done`.
+    std::uint64_t affected_rows() const noexcept { return ok_packet_.affected_rows.value; }
+
+    /// The last insert ID produced by the last query. Valid after `event::done`.
+    std::uint64_t last_insert_id() const noexcept { return ok_packet_.last_insert_id.value; }
+
+    /// The number of warnings produced by the last query. Valid after `event::done`.
+    unsigned warning_count() const noexcept { return ok_packet_.warnings; }
+
+    /// Additional information about the last query. Valid after `event::done`.
+    boost::string_view info() const noexcept { return ok_packet_.info.value; }
+
+    /// The error that made the last operation fail. Valid after `event::error`.
+    error_code last_error() const noexcept { return err_; }
+
+    /// Additional information about the last error. Valid after `event::error`.
+    const error_info& last_error_info() const noexcept { return info_; }
+private:
+    enum class state
+    {
+        greeting,       // waiting for the server greeting
+        auth,           // waiting for an auth response
+        idle,           // ready for another operation
+        query_response, // waiting for the first packet of a query response
+        query_fields,   // reading field definitions
+        query_rows,     // reading rows
+        quit,           // waiting for the quit request to be written
+        closed,         // after quit or an unrecoverable error
+    };
+
+    state state_ {state::greeting};
+    detail::handshake_processor handshake_;
+    detail::capabilities caps_;
+    detail::execute_processor query_;
+    std::size_t remaining_fields_ {0};
+
+    // Input, as received from the server, and the current message, without packet headers
+    detail::bytestring input_;
+    std::size_t input_pos_ {0}; // consumed bytes
+    std::size_t input_end_ {0}; // committed bytes
+    detail::bytestring message_;
+    std::uint8_t seqnum_ {0};
+
+    // Data to be written to the server
+    detail::bytestring output_;
+    std::size_t output_pos_ {0};
+
+    // Results
+    detail::resultset_metadata metadata_;
+    row row_;
+    detail::bytestring ok_buffer_;
+    detail::ok_packet ok_packet_ {};
+    error_code err_;
+    error_info info_;
+
+    inline static connection_params engine_params(connection_params params) noexcept;
+    inline bool read_message(error_code& err);
+    inline void write_message(boost::asio::const_buffer message);
+    inline bool fail(error_code err, bool recoverable);
+    inline bool process_message(event& ev);
+    inline bool process_greeting(event& ev);
+    inline bool process_auth(event& ev);
+    inline bool process_query_response(event& ev);
+    inline bool process_field(event& ev);
+    inline bool process_row(event& ev);
+};
+
+} // experimental
+} // mysql
+} // boost
+
+#include <boost/mysql/experimental/impl/connection_engine.ipp>
+
+#endif
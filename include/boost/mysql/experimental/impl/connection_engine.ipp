@@ -0,0 +1,334 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_EXPERIMENTAL_IMPL_CONNECTION_ENGINE_IPP
+#define BOOST_MYSQL_EXPERIMENTAL_IMPL_CONNECTION_ENGINE_IPP
+
+#include <boost/mysql/detail/network_algorithms/read_row.hpp>
+#include <boost/mysql/detail/protocol/query_messages.hpp>
+#include <cassert>
+#include <cstring>
+
+inline boost::mysql::connection_params boost::mysql::experimental::connection_engine::engine_params(
+    connection_params params
+) noexcept
+{
+    // No TLS. If it's required, the handshake processor will fail
+    if (params.ssl() == ssl_mode::enable)
+        params.set_ssl(ssl_mode::disable);
+    return params;
+}
+
+inline boost::mysql::experimental::connection_engine::connection_engine(
+    const connection_params& params
+) :
+    handshake_(engine_params(params), false),
+    query_(detail::resultset_encoding::text, detail::capabilities())
+{
+}
+
+// Extracts a message from the input, possibly spanning several packets.
+// Returns false if more input is required
+inline bool boost::mysql::experimental::connection_engine::read_message(
+    error_code& err
+)
+{
+    std::size_t consumed = detail::deframe_message(
+        boost::asio::buffer(input_.data() + input_pos_, input_end_ - input_pos_),
+        seqnum_,
+        message_,
+        err
+    );
+    input_pos_ += consumed;
+    return consumed != 0;
+}
+
+inline void boost::mysql::experimental::connection_engine::write_message(
+    boost::asio::const_buffer message
+)
+{
+    seqnum_ = detail::frame_message(message, seqnum_, output_);
+}
+
+// Records an error. Errors reported by the server (as opposed to
+// protocol violations) leave the connection usable
+inline bool boost::mysql::experimental::connection_engine::fail(
+    error_code err,
+    bool recoverable
+)
+{
+    err_ = err;
+    state_ = recoverable ? state::idle : state::closed;
+    return true;
+}
+
+inline boost::mysql::experimental::connection_engine::event
+boost::mysql::experimental::connection_engine::next_event()
+{
+    for (;;)
+    {
+        // Pending writes are completed before reading anything
+        if (output_pos_ != output_.size())
+            return event::write;
+
+        switch (state_)
+        {
+        case state::idle:
+            return err_ ? event::error : event::done;
+        case state::closed:
+            return err_ ? event::error : event::done;
+        case state::quit:
+            state_ = state::closed;
+            return event::done;
+        default:
+            break;
+        }
+
+        // All other states require a message
+        error_code err;
+        if (!read_message(err))
+        {
+            if (err)
+            {
+                fail(err, false);
+                return event::error;
+            }
+            return event::need_input;
+        }
+
+        event ev = event::done;
+        if (process_message(ev))
+            return ev;
+    }
+}
+
+// Returns true if ev should be reported to the user
+inline bool boost::mysql::experimental::connection_engine::process_message(
+    event& ev
+)
+{
+    switch (state_)
+    {
+    case state::greeting: return process_greeting(ev);
+    case state::auth: return process_auth(ev);
+    case state::query_response: return process_query_response(ev);
+    case state::query_fields: return process_field(ev);
+    case state::query_rows: return process_row(ev);
+    default: assert(false); return false;
+    }
+}
+
+inline bool boost::mysql::experimental::connection_engine::process_greeting(
+    event& ev
+)
+{
+    ev = event::error;
+    auto err = handshake_.process_handshake(message_, info_);
+    if (err)
+        return fail(err, false);
+    if (handshake_.use_ssl())
+        return fail(make_error_code(errc::server_unsupported), false);
+    caps_ = handshake_.negotiated_capabilities();
+    handshake_.compose_handshake_response(message_);
+    write_message(boost::asio::buffer(message_));
+    state_ = state::auth;
+    return false;
+}
+
+inline bool boost::mysql::experimental::connection_engine::process_auth(
+    event& ev
+)
+{
+    detail::auth_result result = detail::auth_result::invalid;
+    auto err = handshake_.process_handshake_server_response(message_, result, info_);
+    if (err)
+    {
+        ev = event::error;
+        return fail(err, false);
+    }
+    if (result == detail::auth_result::complete)
+    {
+        state_ = state::idle;
+        ev = event::done;
+        return true;
+    }
+    if (result == detail::auth_result::send_more_data)
+    {
+        write_message(boost::asio::buffer(message_));
+    }
+    return false;
+}
+
+inline void boost::mysql::experimental::connection_engine::start_query(
+    boost::string_view query_string
+)
+{
+    assert(ready());
+    err_.clear();
+    info_.clear();
+    query_ = detail::execute_processor(detail::resultset_encoding::text, caps_);
+    metadata_ = detail::resultset_metadata();
+    seqnum_ = 0;
+    detail::serialize_message(detail::com_query_packet{detail::string_eof(query_string)}, caps_, message_);
+    write_message(boost::asio::buffer(message_));
+    state_ = state::query_response;
+}
+
+inline bool boost::mysql::experimental::connection_engine::process_query_response(
+    event& ev
+)
+{
+    // Errors reported by the server, including local infile errors (in an OK packet)
+    bool is_server_error = !message_.empty() &&
+        (message_[0] == detail::error_packet_header || message_[0] == detail::ok_packet_header);
+    std::swap(message_, query_.get_buffer());
+    error_code err;
+    query_.process_response(err, info_);
+    if (err)
+    {
+        ev = event::error;
+        return fail(err, is_server_error);
+    }
+
+    if (query_.local_infile_requested())
+    {
+        // We don't advertise support for it, so this shouldn't happen.
+        // Send an empty file, and report an error on completion
+        query_.read_local_infile_chunk(local_infile_handler());
+        write_message(boost::asio::buffer(query_.get_buffer()));
+        return false;
+    }
+    else if (query_.field_count() == 0)
+    {
+        // OK packet. It points into the processor buffer
+        ok_packet_ = query_.get_ok_packet();
+        std::swap(ok_buffer_, query_.get_buffer());
+        state_ = state::idle;
+        ev = event::done;
+        return true;
+    }
+    else
+    {
+        remaining_fields_ = query_.field_count();
+        state_ = state::query_fields;
+        return false;
+    }
+}
+
+inline bool boost::mysql::experimental::connection_engine::process_field(
+    event& ev
+)
+{
+    std::swap(message_, query_.get_buffer());
+    auto err = query_.process_field_definition();
+    if (err)
+    {
+        ev = event::error;
+        return fail(err, false);
+    }
+    if (--remaining_fields_ == 0)
+    {
+        metadata_ = std::move(query_).release_metadata();
+        state_ = state::query_rows;
+        ev = event::fields;
+        return true;
+    }
+    return false;
+}
+
+inline bool boost::mysql::experimental::connection_engine::process_row(
+    event& ev
+)
+{
+    bool is_error_packet = !message_.empty() && message_[0] == detail::error_packet_header;
+    std::swap(message_, row_.buffer());
+    error_code err;
+    auto result = detail::process_read_message(
+        detail::resultset_encoding::text,
+        caps_,
+        metadata_.fields(),
+        row_,
+        ok_buffer_,
+        ok_packet_,
+        err,
+        info_
+    );
+    if (result == detail::read_row_result::error)
+    {
+        ev = event::error;
+        return fail(err, is_error_packet);
+    }
+    else if (result == detail::read_row_result::eof)
+    {
+        state_ = state::idle;
+        ev = event::done;
+    }
+    else
+    {
+        ev = event::row;
+    }
+    return true;
+}
+
+inline void boost::mysql::experimental::connection_engine::start_quit()
+{
+    assert(ready());
+    err_.clear();
+    info_.clear();
+    seqnum_ = 0;
+    detail::serialize_message(detail::quit_packet(), caps_, message_);
+    write_message(boost::asio::buffer(message_));
+    state_ = state::quit;
+}
+
+inline boost::asio::mutable_buffer boost::mysql::experimental::connection_engine::prepare_input(
+    std::size_t size
+)
+{
+    // Discard consumed input, so the buffer doesn't grow indefinitely
+    if (input_pos_ != 0)
+    {
+        input_.erase(input_.begin(), input_.begin() + input_pos_);
+        input_end_ -= input_pos_;
+        input_pos_ = 0;
+    }
+    input_.resize(input_end_ + size);
+    return boost::asio::buffer(input_.data() + input_end_, size);
+}
+
+inline void boost::mysql::experimental::connection_engine::commit_input(
+    std::size_t size
+)
+{
+    assert(input_end_ + size <= input_.size());
+    input_end_ += size;
+}
+
+inline void boost::mysql::experimental::connection_engine::feed(
+    boost::asio::const_buffer data
+)
+{
+    auto buff = prepare_input(data.size());
+    if (data.size())
+        std::memcpy(buff.data(), data.data(), data.size());
+    commit_input(data.size());
+}
+
+inline void boost::mysql::experimental::connection_engine::consume_output(
+    std::size_t size
+)
+{
+    assert(output_pos_ + size <= output_.size());
+    output_pos_ += size;
+    if (output_pos_ == output_.size())
+    {
+        output_.clear();
+        output_pos_ = 0;
+    }
+}
+
+#endif
@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_FORMAT_OPTIONS_HPP
+#define BOOST_MYSQL_FORMAT_OPTIONS_HPP
+
+#include <boost/mysql/collation.hpp>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief Describes how the server parses SQL text, as required to compose SQL client-side.
+ * \details Used by [reflink format_sql]. Contains the connection's collation,
+ * which determines its character set, and whether backslashes are escape characters
+ * within strings (true unless the `NO_BACKSLASH_ESCAPES` SQL mode is active).
+ *
+ * You can obtain the options matching a connection's current state
+ * using [refmem connection format_opts].
+ */
+class format_options
+{
+    collation connection_collation_;
+    bool backslash_escapes_;
+public:
+    /// Constructor.
+    constexpr format_options(
+        collation connection_col = collation::utf8_general_ci,
+        bool backslash_escapes = true
+    ) noexcept :
+        connection_collation_(connection_col),
+        backslash_escapes_(backslash_escapes)
+    {
+    }
+
+    /// Retrieves the connection collation.
+    constexpr collation connection_collation() const noexcept { return connection_collation_; }
+
+    /// Sets the connection collation.
+    void set_connection_collation(collation value) noexcept { connection_collation_ = value; }
+
+    /// Retrieves whether backslashes are escape characters within strings.
+    constexpr bool backslash_escapes() const noexcept { return backslash_escapes_; }
+
+    /// Sets whether backslashes are escape characters within strings.
+    void set_backslash_escapes(bool value) noexcept { backslash_escapes_ = value; }
+};
+
+} // mysql
+} // boost
+
+#endif
@@ -0,0 +1,113 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_FORMAT_SQL_HPP
+#define BOOST_MYSQL_FORMAT_SQL_HPP
+
+#include <boost/mysql/error.hpp>
+#include <boost/mysql/format_options.hpp>
+#include <boost/mysql/value.hpp>
+#include <boost/mysql/detail/auxiliar/value_type_traits.hpp>
+#include <boost/utility/string_view.hpp>
+#include <string>
+
+namespace boost {
+namespace mysql {
+
+// Forward declaration
+template <class Stream>
+class connection;
+
+/**
+ * \brief Composes a SQL query client-side (error code version).
+ * \details Replaces each `{}` placeholder in `format` by the next value
+ * in `args`, converted to a SQL literal. Use `{{` and `}}` to insert literal
+ * braces. The result is written into `output`, which is cleared first; you can
+ * reuse the same string across calls to avoid allocations.
+ *
+ * Strings are quoted and escaped according to `opts`, which must match the
+ * connection the query will be run on. If backslashes are escape characters
+ * ([refmem format_options backslash_escapes]), backslashes, quotes, NUL and
+ * Ctrl+Z characters are escaped using backslashes. Otherwise
+ * (the `NO_BACKSLASH_ESCAPES` SQL mode is active), quotes are doubled.
+ * This allows running parameterized queries in a single round-trip
+ * using [refmem connection query], without preparing a statement.
+ *
+ * ValueCollection should meet the [reflink ValueCollection] requirements.
+ * Fails with `errc::invalid_format_string` if `format` contains unmatched braces or
+ * the number of placeholders is different from the number of arguments,
+ * with `errc::unrepresentable_value` if any argument is a floating point
+ * NaN or infinity, and with `errc::unsafe_charset` if the connection uses
+ * a character set whose strings can't be escaped safely (big5, sjis, gbk,
+ * cp932 and gb18030).
+ */
+template <
+    class ValueCollection,
+    class EnableIf = detail::enable_if_value_collection<ValueCollection>
+>
+void format_sql(
+    const format_options& opts,
+    boost::string_view format,
+    const ValueCollection& args,
+    std::string& output,
+    error_code& err
+);
+
+/**
+ * \brief Composes a SQL query client-side (exceptions version).
+ * \details See the error code version for more info.
+ */
+template <
+    class ValueCollection,
+    class EnableIf = detail::enable_if_value_collection<ValueCollection>
+>
+std::string format_sql(
+    const format_options& opts,
+    boost::string_view format,
+    const ValueCollection& args
+);
+
+/**
+ * \brief Composes a SQL query to be run on a connection, client-side (error code version).
+ * \details Equivalent to passing [refmem connection format_opts] as
+ * the format options. See the [reflink format_options] version for more info.
+ */
+template <
+    class Stream,
+    class ValueCollection,
+    class EnableIf = detail::enable_if_value_collection<ValueCollection>
+>
+void format_sql(
+    const connection<Stream>& conn,
+    boost::string_view format,
+    const ValueCollection& args,
+    std::string& output,
+    error_code& err
+);
+
+/**
+ * \brief Composes a SQL query to be run on a connection, client-side (exceptions version).
+ * \details Equivalent to passing [refmem connection format_opts] as
+ * the format options. See the [reflink format_options] version for more info.
+ */
+template <
+    class Stream,
+    class ValueCollection,
+    class EnableIf = detail::enable_if_value_collection<ValueCollection>
+>
+std::string format_sql(
+    const connection<Stream>& conn,
+    boost::string_view format,
+    const ValueCollection& args
+);
+
+} // mysql
+} // boost
+
+#include <boost/mysql/impl/format_sql.hpp>
+
+#endif
@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_HEDGED_QUERY_HPP
+#define BOOST_MYSQL_HEDGED_QUERY_HPP
+
+#include <boost/mysql/connection_params.hpp>
+#include <boost/mysql/error.hpp>
+#include <boost/mysql/row.hpp>
+#include <boost/mysql/socket_connection.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/utility/string_view.hpp>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief Runs a read-only query against two replicas, using the first response
+ *        (async with [reflink error_info] version).
+ * \details Runs `query_string` on `primary`. If it hasn't completed after `delay`,
+ * runs it on `secondary` too, and uses the results of the first connection that
+ * completes. The rows of the resultset are read into `output`. This cuts tail latency
+ * when `delay` is set to a high percentile (e.g. p95) of the query latency, at the cost
+ * of running the query twice for the slowest requests. Only use it for idempotent queries.
+ *
+ * If the primary fails before `delay` elapses, the query is run on the secondary straight away.
+ * Once a connection succeeds, the operation completes, and the query the other one is running
+ * is cancelled in the background using [refmem socket_connection async_cancel_running_query],
+ * authenticating with `cancel_params`. The cancelled query's results, if any, are discarded.
+ *
+ * The handler signature for this operation is `void(boost::mysql::error_code, std::size_t)`.
+ * The second argument is the index of the connection whose results were used (0 for
+ * `primary`, 1 for `secondary`). If both connections fail, the primary's error is reported.
+ *
+ * `drain_handler` is a function object with signature
+ * `void(boost::mysql::error_code query_err, boost::mysql::error_code cancel_err)`. It is invoked,
+ * through the operation's executor, once both connections are idle, always after the completion
+ * handler. Don't start other operations on either connection before then. `query_err` is the error the
+ * query completed with on the connection whose results were not used (the secondary, if
+ * both failed). It's usually [link mysql.ref.boost__mysql__errc `errc::query_interrupted`] for
+ * cancelled queries, and empty if the query was not run there. Any other error may mean that
+ * the connection must be re-established. `cancel_err` is the error issuing the `KILL QUERY`
+ * statement, empty if it succeeded or was not required. If it failed, the query ran to completion.
+ *
+ * If terminal cancellation is requested through the completion handler's cancellation slot
+ * (Boost 1.77 or later), the other query is not started, the running ones are interrupted and
+ * the operation completes with `boost::asio::error::operation_aborted`, unless a connection
+ * succeeded in the meantime. The interrupted connections are left in an unspecified state and
+ * should be closed. Partial and total cancellation are not supported.
+ *
+ * Both connections must use the same executor, which must be a strand if several threads
+ * run it. `output` and `output_info` should be kept alive by the caller until the operation
+ * completes, and the strings pointed to by `cancel_params` until the drain handler is invoked.
+ * `query_string` is copied.
+ */
+template <
+    class SocketStream,
+    class DrainHandler,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, std::size_t))
+    CompletionToken
+    BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(typename SocketStream::executor_type)
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+async_hedged_query(
+    socket_connection<SocketStream>& primary,
+    socket_connection<SocketStream>& secondary,
+    boost::string_view query_string,
+    std::chrono::steady_clock::duration delay,
+    const connection_params& cancel_params,
+    std::vector<row>& output,
+    error_info& output_info,
+    DrainHandler&& drain_handler,
+    CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(typename SocketStream::executor_type)
+);
+
+/**
+ * \brief Runs a read-only query against two replicas, using the first response
+ *        (async without [reflink error_info] version).
+ * \details See the [reflink error_info] version for more info.
+ */
+template <
+    class SocketStream,
+    class DrainHandler,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, std::size_t))
+    CompletionToken
+    BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(typename SocketStream::executor_type)
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+async_hedged_query(
+    socket_connection<SocketStream>& primary,
+    socket_connection<SocketStream>& secondary,
+    boost::string_view query_string,
+    std::chrono::steady_clock::duration delay,
+    const connection_params& cancel_params,
+    std::vector<row>& output,
+    DrainHandler&& drain_handler,
+    CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(typename SocketStream::executor_type)
+);
+
+} // mysql
+} // boost
+
+#include <boost/mysql/impl/hedged_query.hpp>
+
+#endif
@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_COLUMN_BATCH_HPP
+#define BOOST_MYSQL_IMPL_COLUMN_BATCH_HPP
+
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/compose.hpp>
+#include <cassert>
+#include <memory>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+template <class Stream>
+struct read_columns_op : boost::asio::coroutine
+{
+    resultset<Stream>& resultset_;
+    column_batch& output_;
+    error_info& output_info_;
+    std::unique_ptr<row> current_row_; // heap allocated, as the op gets moved
+
+    read_columns_op(
+        resultset<Stream>& obj,
+        column_batch& output,
+        error_info& output_info
+    ) :
+        resultset_(obj),
+        output_(output),
+        output_info_(output_info),
+        current_row_(new row())
+    {
+    }
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        bool row_read = false
+    )
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            output_.reset(resultset_.fields());
+
+            // Reading a complete resultset completes as if by post
+            while (true)
+            {
+                BOOST_ASIO_CORO_YIELD resultset_.async_read_one_generic(
+                    *current_row_,
+                    output_info_,
+                    std::move(self)
+                );
+                if (!err && row_read)
+                    err = output_.append_row(current_row_->values());
+                if (err || !row_read)
+                {
+                    self.complete(err);
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+            }
+        }
+    }
+};
+
+} // detail
+} // mysql
+} // boost
+
+template <class Stream>
+void boost::mysql::read_columns(
+    resultset<Stream>& result,
+    column_batch& output,
+    error_code& err,
+    error_info& info
+)
+{
+    assert(result.valid());
+
+    detail::clear_errors(err, info);
+
+    output.reset(result.fields());
+    row current;
+    while (result.read_one(current, err, info))
+    {
+        err = output.append_row(current.values());
+        if (err)
+            return;
+    }
+}
+
+template <class Stream>
+void boost::mysql::read_columns(
+    resultset<Stream>& result,
+    column_batch& output
+)
+{
+    detail::error_block blk;
+    read_columns(result, output, blk.err, blk.info);
+    blk.check();
+}
+
+template <
+    class Stream,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(boost::mysql::error_code)) CompletionToken
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::async_read_columns(
+    resultset<Stream>& result,
+    column_batch& output,
+    CompletionToken&& token
+)
+{
+    return async_read_columns(result, output, result.shared_info(), std::forward<CompletionToken>(token));
+}
+
+template <
+    class Stream,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(boost::mysql::error_code)) CompletionToken
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::async_read_columns(
+    resultset<Stream>& result,
+    column_batch& output,
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    result.start_async_operation(output_info);
+    return boost::asio::async_compose<CompletionToken, void(error_code)>(
+        detail::read_columns_op<Stream>(result, output, output_info),
+        token,
+        result
+    );
+}
+
+#endif
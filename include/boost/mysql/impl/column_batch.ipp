@@ -0,0 +1,219 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_COLUMN_BATCH_IPP
+#define BOOST_MYSQL_IMPL_COLUMN_BATCH_IPP
+
+#include <boost/mysql/detail/protocol/constants.hpp>
+#include <cassert>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+inline column_type compute_column_type(
+    const field_metadata& meta
+) noexcept
+{
+    switch (meta.protocol_type())
+    {
+    case protocol_field_type::tiny:
+    case protocol_field_type::short_:
+    case protocol_field_type::int24:
+    case protocol_field_type::long_:
+    case protocol_field_type::longlong:
+        return meta.is_unsigned() ? column_type::uint64 : column_type::int64;
+    case protocol_field_type::year:
+    case protocol_field_type::bit:
+        return column_type::uint64;
+    case protocol_field_type::float_:
+    case protocol_field_type::double_:
+        return column_type::double_;
+    case protocol_field_type::date:
+        return column_type::date;
+    case protocol_field_type::datetime:
+    case protocol_field_type::timestamp:
+        return column_type::datetime;
+    case protocol_field_type::time:
+        return column_type::time;
+    default:
+        return column_type::string;
+    }
+}
+
+inline bool is_binary_field(
+    const field_metadata& meta
+) noexcept
+{
+    switch (meta.type())
+    {
+    case field_type::binary:
+    case field_type::varbinary:
+    case field_type::blob:
+    case field_type::geometry:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // detail
+} // mysql
+} // boost
+
+inline void boost::mysql::column::push_validity(
+    bool is_valid
+)
+{
+    if (size_ % 8 == 0)
+        validity_.push_back(0);
+    if (is_valid)
+        validity_.back() |= static_cast<std::uint8_t>(1 << (size_ % 8));
+    else
+        ++null_count_;
+    ++size_;
+}
+
+inline void boost::mysql::column::reset(
+    const field_metadata& meta
+)
+{
+    name_.assign(meta.field_name().data(), meta.field_name().size());
+    type_ = detail::compute_column_type(meta);
+    binary_ = type_ == column_type::string && detail::is_binary_field(meta);
+    size_ = 0;
+    null_count_ = 0;
+    validity_.clear();
+    int64_data_.clear();
+    uint64_data_.clear();
+    double_data_.clear();
+    date_data_.clear();
+    offsets_.assign(1, 0);
+    string_data_.clear();
+}
+
+inline boost::mysql::error_code boost::mysql::column::push_back(
+    const value& v
+)
+{
+    bool is_null = v.is_null();
+    switch (type_)
+    {
+    case column_type::int64:
+    {
+        auto val = v.get_optional<std::int64_t>();
+        if (!is_null && !val)
+            return make_error_code(errc::protocol_value_error);
+        int64_data_.push_back(val.value_or(0));
+        break;
+    }
+    case column_type::uint64:
+    {
+        auto val = v.get_optional<std::uint64_t>();
+        if (!is_null && !val)
+            return make_error_code(errc::protocol_value_error);
+        uint64_data_.push_back(val.value_or(0));
+        break;
+    }
+    case column_type::double_:
+    {
+        auto val = v.get_optional<double>(); // float converts to double
+        if (!is_null && !val)
+            return make_error_code(errc::protocol_value_error);
+        double_data_.push_back(val.value_or(0.0));
+        break;
+    }
+    case column_type::date:
+    {
+        auto val = v.get_optional<date>();
+        if (!is_null && !val)
+            return make_error_code(errc::protocol_value_error);
+        date_data_.push_back(val ? val->time_since_epoch().count() : 0);
+        break;
+    }
+    case column_type::datetime:
+    {
+        auto val = v.get_optional<datetime>();
+        if (!is_null && !val)
+            return make_error_code(errc::protocol_value_error);
+        int64_data_.push_back(val ? val->time_since_epoch().count() : 0);
+        break;
+    }
+    case column_type::time:
+    {
+        auto val = v.get_optional<time>();
+        if (!is_null && !val)
+            return make_error_code(errc::protocol_value_error);
+        int64_data_.push_back(val ? val->count() : 0);
+        break;
+    }
+    case column_type::string:
+    {
+        auto val = v.get_optional<boost::string_view>();
+        if (!is_null && !val)
+            return make_error_code(errc::protocol_value_error);
+        if (val)
+            string_data_.insert(string_data_.end(), val->begin(), val->end());
+        offsets_.push_back(static_cast<std::int64_t>(string_data_.size()));
+        break;
+    }
+    }
+    push_validity(!is_null);
+    return error_code();
+}
+
+inline boost::mysql::value boost::mysql::column::at(
+    std::size_t i
+) const noexcept
+{
+    assert(i < size_);
+    if (is_null(i))
+        return value(nullptr);
+    switch (type_)
+    {
+    case column_type::int64: return value(int64_data_[i]);
+    case column_type::uint64: return value(uint64_data_[i]);
+    case column_type::double_: return value(double_data_[i]);
+    case column_type::date: return value(date(days(date_data_[i])));
+    case column_type::datetime: return value(datetime(std::chrono::microseconds(int64_data_[i])));
+    case column_type::time: return value(time(int64_data_[i]));
+    default: return value(boost::string_view(
+        string_data_.data() + offsets_[i],
+        static_cast<std::size_t>(offsets_[i + 1] - offsets_[i])
+    ));
+    }
+}
+
+inline void boost::mysql::column_batch::reset(
+    const std::vector<field_metadata>& fields
+)
+{
+    columns_.resize(fields.size());
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        columns_[i].reset(fields[i]);
+    }
+    num_rows_ = 0;
+}
+
+inline boost::mysql::error_code boost::mysql::column_batch::append_row(
+    const std::vector<value>& values
+)
+{
+    assert(values.size() == columns_.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        auto err = columns_[i].push_back(values[i]);
+        if (err)
+            return err;
+    }
+    ++num_rows_;
+    return error_code();
+}
+
+
+#endif
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_COMPACT_ROW_IPP
+#define BOOST_MYSQL_IMPL_COMPACT_ROW_IPP
+
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Converts a value into a cell, copying string data into the buffer
+struct compact_cell_visitor
+{
+    compact_cell& cell;
+    bytestring& buffer;
+
+    compact_cell_visitor(compact_cell& cell, bytestring& buffer): cell(cell), buffer(buffer) {}
+
+    void operator()(null_t) const noexcept { cell.type = compact_cell::kind::null; }
+    void operator()(std::int64_t v) const noexcept
+    {
+        cell.type = compact_cell::kind::int64;
+        cell.data.int64 = v;
+    }
+    void operator()(std::uint64_t v) const noexcept
+    {
+        cell.type = compact_cell::kind::uint64;
+        cell.data.uint64 = v;
+    }
+    void operator()(boost::string_view v) const noexcept
+    {
+        assert(buffer.size() + v.size() <= (std::numeric_limits<std::uint32_t>::max)());
+        assert(buffer.capacity() >= buffer.size() + v.size()); // no reallocations
+        cell.type = compact_cell::kind::string;
+        cell.data.string.offset = static_cast<std::uint32_t>(buffer.size());
+        cell.data.string.size = static_cast<std::uint32_t>(v.size());
+        buffer.insert(buffer.end(), v.begin(), v.end());
+    }
+    void operator()(float v) const noexcept
+    {
+        cell.type = compact_cell::kind::float_;
+        cell.data.float_ = v;
+    }
+    void operator()(double v) const noexcept
+    {
+        cell.type = compact_cell::kind::double_;
+        cell.data.double_ = v;
+    }
+    void operator()(date v) const noexcept
+    {
+        cell.type = compact_cell::kind::date;
+        cell.data.days = v.time_since_epoch().count();
+    }
+    void operator()(datetime v) const noexcept
+    {
+        cell.type = compact_cell::kind::datetime;
+        cell.data.micros = v.time_since_epoch().count();
+    }
+    void operator()(time v) const noexcept
+    {
+        cell.type = compact_cell::kind::time;
+        cell.data.micros = v.count();
+    }
+};
+
+inline value compact_cell_to_value(
+    const compact_cell& cell,
+    const bytestring& buffer
+) noexcept
+{
+    switch (cell.type)
+    {
+    case compact_cell::kind::int64: return value(cell.data.int64);
+    case compact_cell::kind::uint64: return value(cell.data.uint64);
+    case compact_cell::kind::string:
+        return value(boost::string_view(
+            reinterpret_cast<const char*>(buffer.data()) + cell.data.string.offset,
+            cell.data.string.size
+        ));
+    case compact_cell::kind::float_: return value(cell.data.float_);
+    case compact_cell::kind::double_: return value(cell.data.double_);
+    case compact_cell::kind::date: return value(date(days(cell.data.days)));
+    case compact_cell::kind::datetime: return value(datetime(time(cell.data.micros)));
+    case compact_cell::kind::time: return value(time(cell.data.micros));
+    default: return value();
+    }
+}
+
+} // detail
+} // mysql
+} // boost
+
+inline boost::mysql::compact_row::compact_row(
+    const std::vector<value>& values
+)
+{
+    // Reserve so that the buffer is allocated exactly once
+    std::size_t string_size = 0;
+    for (const auto& v: values)
+    {
+        if (v.is<boost::string_view>())
+            string_size += v.get<boost::string_view>().size();
+    }
+    if (string_size > (std::numeric_limits<std::uint32_t>::max)())
+        throw std::length_error("compact_row: string data too long");
+    buffer_.reserve(string_size);
+    cells_.resize(values.size());
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        boost::variant2::visit(
+            detail::compact_cell_visitor(cells_[i], buffer_),
+            values[i].to_variant()
+        );
+    }
+}
+
+inline boost::mysql::value boost::mysql::compact_row::operator[](
+    std::size_t i
+) const noexcept
+{
+    assert(i < cells_.size());
+    return detail::compact_cell_to_value(cells_[i], buffer_);
+}
+
+inline boost::mysql::value boost::mysql::compact_row::at(
+    std::size_t i
+) const
+{
+    if (i >= cells_.size())
+        throw std::out_of_range("compact_row::at");
+    return (*this)[i];
+}
+
+inline std::vector<boost::mysql::value> boost::mysql::compact_row::values() const
+{
+    std::vector<value> res;
+    res.reserve(cells_.size());
+    for (const auto& cell: cells_)
+        res.push_back(detail::compact_cell_to_value(cell, buffer_));
+    return res;
+}
+
+inline bool boost::mysql::operator==(
+    const compact_row& lhs,
+    const compact_row& rhs
+) noexcept
+{
+    if (lhs.size() != rhs.size())
+        return false;
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (lhs[i] != rhs[i])
+            return false;
+    }
+    return true;
+}
+
+inline std::ostream& boost::mysql::operator<<(
+    std::ostream& os,
+    const compact_row& r
+)
+{
+    os << '{';
+    for (std::size_t i = 0; i < r.size(); ++i)
+    {
+        if (i != 0)
+            os << ", ";
+        os << r[i];
+    }
+    return os << '}';
+}
+
+#endif
@@ -10,8 +10,11 @@
 
 #include <boost/mysql/detail/network_algorithms/handshake.hpp>
 #include <boost/mysql/detail/network_algorithms/execute_query.hpp>
+#include <boost/mysql/detail/network_algorithms/bulk_insert.hpp>
+#include <boost/mysql/detail/network_algorithms/execute_once.hpp>
 #include <boost/mysql/detail/network_algorithms/prepare_statement.hpp>
 #include <boost/mysql/detail/network_algorithms/quit_connection.hpp>
+#include <boost/mysql/detail/network_algorithms/flush_deferred.hpp>
 #include <boost/asio/buffer.hpp>
 
 template <class Stream>
@@ -48,6 +51,7 @@ boost::mysql::connection<Stream>::async_handshake(
 )
 {
     output_info.clear();
+    get_channel().start_deadline();
     return detail::async_handshake(
         get_channel(),
         params,
@@ -56,6 +60,50 @@ boost::mysql::connection<Stream>::async_handshake(
     );
 }
 
+// Change user
+template <class Stream>
+void boost::mysql::connection<Stream>::change_user(
+    const connection_params& params,
+    error_code& code,
+    error_info& info
+)
+{
+    detail::clear_errors(code, info);
+    detail::change_user(get_channel(), params, code, info);
+}
+
+template <class Stream>
+void boost::mysql::connection<Stream>::change_user(
+    const connection_params& params
+)
+{
+    detail::error_block blk;
+    change_user(params, blk.err, blk.info);
+    blk.check();
+}
+
+template <class Stream>
+template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(boost::mysql::error_code)) CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::connection<Stream>::async_change_user(
+    const connection_params& params,
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    output_info.clear();
+    get_channel().start_deadline();
+    return detail::async_change_user(
+        get_channel(),
+        params,
+        std::forward<CompletionToken>(token),
+        output_info
+    );
+}
+
 // Query
 template <class Stream>
 boost::mysql::resultset<Stream> boost::mysql::connection<Stream>::query(
@@ -96,6 +144,7 @@ boost::mysql::connection<Stream>::async_query(
 )
 {
     output_info.clear();
+    get_channel().start_deadline();
     return detail::async_execute_query(
         get_channel(),
         query_string,
@@ -104,6 +153,107 @@ boost::mysql::connection<Stream>::async_query(
     );
 }
 
+template <class Stream>
+template <class RowForwardIterator>
+std::uint64_t boost::mysql::connection<Stream>::bulk_insert(
+    const bulk_insert_params<RowForwardIterator>& params,
+    error_code& err,
+    error_info& info
+)
+{
+    detail::clear_errors(err, info);
+    return detail::bulk_insert(get_channel(), params, err, info);
+}
+
+template <class Stream>
+template <class RowForwardIterator>
+std::uint64_t boost::mysql::connection<Stream>::bulk_insert(
+    const bulk_insert_params<RowForwardIterator>& params
+)
+{
+    detail::error_block blk;
+    auto res = detail::bulk_insert(get_channel(), params, blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template <class Stream>
+template <class RowForwardIterator, BOOST_ASIO_COMPLETION_TOKEN_FOR(
+    void(boost::mysql::error_code, std::uint64_t)) CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, std::uint64_t)
+)
+boost::mysql::connection<Stream>::async_bulk_insert(
+    const bulk_insert_params<RowForwardIterator>& params,
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    output_info.clear();
+    get_channel().start_deadline();
+    return detail::async_bulk_insert(
+        get_channel(),
+        params,
+        std::forward<CompletionToken>(token),
+        output_info
+    );
+}
+
+template <class Stream>
+template <class ValueCollection, class EnableIf>
+boost::mysql::resultset<Stream> boost::mysql::connection<Stream>::execute_once(
+    boost::string_view statement,
+    const ValueCollection& params,
+    error_code& err,
+    error_info& info
+)
+{
+    resultset<Stream> res;
+    detail::clear_errors(err, info);
+    detail::execute_once(get_channel(), statement, std::begin(params), std::end(params), res, err, info);
+    return res;
+}
+
+template <class Stream>
+template <class ValueCollection, class EnableIf>
+boost::mysql::resultset<Stream> boost::mysql::connection<Stream>::execute_once(
+    boost::string_view statement,
+    const ValueCollection& params
+)
+{
+    detail::error_block blk;
+    auto res = execute_once(statement, params, blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template <class Stream>
+template <class ValueCollection, BOOST_ASIO_COMPLETION_TOKEN_FOR(
+    void(boost::mysql::error_code, boost::mysql::resultset<Stream>)) CompletionToken, class EnableIf>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, boost::mysql::resultset<Stream>)
+)
+boost::mysql::connection<Stream>::async_execute_once(
+    boost::string_view statement,
+    const ValueCollection& params,
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    output_info.clear();
+    get_channel().start_deadline();
+    return detail::async_execute_once(
+        get_channel(),
+        statement,
+        std::begin(params),
+        std::end(params),
+        std::forward<CompletionToken>(token),
+        output_info
+    );
+}
+
 template <class Stream>
 boost::mysql::prepared_statement<Stream> boost::mysql::connection<Stream>::prepare_statement(
     boost::string_view statement,
@@ -143,6 +293,7 @@ boost::mysql::connection<Stream>::async_prepare_statement(
 )
 {
     output_info.clear();
+    get_channel().start_deadline();
     return detail::async_prepare_statement(
         get_channel(),
         statement,
@@ -151,6 +302,44 @@ boost::mysql::connection<Stream>::async_prepare_statement(
     );
 }
 
+template <class Stream>
+void boost::mysql::connection<Stream>::flush_deferred_closes(
+    error_code& err,
+    error_info& info
+)
+{
+    detail::clear_errors(err, info);
+    detail::flush_deferred(get_channel(), err, info);
+}
+
+template <class Stream>
+void boost::mysql::connection<Stream>::flush_deferred_closes()
+{
+    detail::error_block blk;
+    detail::flush_deferred(get_channel(), blk.err, blk.info);
+    blk.check();
+}
+
+template <class Stream>
+template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(boost::mysql::error_code)) CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::connection<Stream>::async_flush_deferred_closes(
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    output_info.clear();
+    get_channel().start_deadline();
+    return detail::async_flush_deferred(
+        get_channel(),
+        std::forward<CompletionToken>(token),
+        output_info
+    );
+}
+
 template <class Stream>
 void boost::mysql::connection<Stream>::quit(
     error_code& err,
@@ -181,6 +370,7 @@ boost::mysql::connection<Stream>::async_quit(
 )
 {
     output_info.clear();
+    get_channel().start_deadline();
     return detail::async_quit_connection(
         get_channel(),
         std::forward<CompletionToken>(token),
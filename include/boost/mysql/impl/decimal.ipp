@@ -0,0 +1,471 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_DECIMAL_IPP
+#define BOOST_MYSQL_IMPL_DECIMAL_IPP
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Magnitudes are stored as little-endian arrays of 32-bit limbs. Arithmetic
+// is only performed with 32-bit multipliers and divisors, which is all we need
+// to convert from and to base 10 in chunks of 9 digits.
+constexpr std::uint32_t decimal_chunk_divisor = 1000000000; // 10^9
+constexpr unsigned decimal_chunk_digits = 9;
+
+inline std::uint32_t decimal_pow10_u32(unsigned exponent) noexcept
+{
+    static constexpr std::uint32_t table [] = {
+        1u, 10u, 100u, 1000u, 10000u, 100000u,
+        1000000u, 10000000u, 100000000u, 1000000000u
+    };
+    assert(exponent <= decimal_chunk_digits);
+    return table[exponent];
+}
+
+inline double decimal_pow10_double(unsigned exponent) noexcept
+{
+    static constexpr double table [] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+        1e20, 1e21, 1e22, 1e23, 1e24, 1e25, 1e26, 1e27, 1e28, 1e29,
+        1e30, 1e31, 1e32, 1e33, 1e34, 1e35, 1e36, 1e37, 1e38
+    };
+    assert(exponent <= decimal::max_scale);
+    return table[exponent];
+}
+
+// v = v * mul + add. Returns the carry out of the most significant limb
+template <std::size_t N>
+std::uint32_t decimal_mul_add(
+    std::array<std::uint32_t, N>& v,
+    std::uint32_t mul,
+    std::uint32_t add
+) noexcept
+{
+    std::uint64_t carry = add;
+    for (auto& limb: v)
+    {
+        std::uint64_t x = static_cast<std::uint64_t>(limb) * mul + carry;
+        limb = static_cast<std::uint32_t>(x);
+        carry = x >> 32;
+    }
+    return static_cast<std::uint32_t>(carry);
+}
+
+// v = v / div. Returns the remainder
+template <std::size_t N>
+std::uint32_t decimal_divmod(
+    std::array<std::uint32_t, N>& v,
+    std::uint32_t div
+) noexcept
+{
+    std::uint64_t rem = 0;
+    for (std::size_t i = N; i-- > 0;)
+    {
+        std::uint64_t x = (rem << 32) | v[i];
+        v[i] = static_cast<std::uint32_t>(x / div);
+        rem = x % div;
+    }
+    return static_cast<std::uint32_t>(rem);
+}
+
+// v = v * 10^exponent. Returns false on overflow
+template <std::size_t N>
+bool decimal_mul_pow10(
+    std::array<std::uint32_t, N>& v,
+    unsigned exponent
+) noexcept
+{
+    while (exponent > 0)
+    {
+        unsigned chunk = (std::min)(exponent, decimal_chunk_digits);
+        if (decimal_mul_add(v, decimal_pow10_u32(chunk), 0) != 0)
+            return false;
+        exponent -= chunk;
+    }
+    return true;
+}
+
+template <std::size_t N>
+bool decimal_is_zero(
+    const std::array<std::uint32_t, N>& v
+) noexcept
+{
+    for (auto limb: v)
+    {
+        if (limb)
+            return false;
+    }
+    return true;
+}
+
+// Returns <0, 0 or >0, like strcmp
+template <std::size_t N>
+int decimal_compare(
+    const std::array<std::uint32_t, N>& lhs,
+    const std::array<std::uint32_t, N>& rhs
+) noexcept
+{
+    for (std::size_t i = N; i-- > 0;)
+    {
+        if (lhs[i] != rhs[i])
+            return lhs[i] < rhs[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// Any magnitude must be strictly less than this
+inline const decimal::magnitude_type& decimal_max_magnitude() noexcept
+{
+    // 10^38 = 0x4b3b4ca85a86c47a098a224000000000
+    static constexpr decimal::magnitude_type res {{ 0x00000000u, 0x098a2240u, 0x5a86c47au, 0x4b3b4ca8u }};
+    return res;
+}
+
+inline decimal::magnitude_type decimal_magnitude_from_u64(
+    std::uint64_t v
+) noexcept
+{
+    return decimal::magnitude_type {{
+        static_cast<std::uint32_t>(v),
+        static_cast<std::uint32_t>(v >> 32),
+        0u,
+        0u
+    }};
+}
+
+inline bool decimal_fits_u64(
+    const decimal::magnitude_type& v
+) noexcept
+{
+    return v[2] == 0 && v[3] == 0;
+}
+
+inline std::uint64_t decimal_low_u64(
+    const decimal::magnitude_type& v
+) noexcept
+{
+    return (static_cast<std::uint64_t>(v[1]) << 32) | v[0];
+}
+
+inline int decimal_compare(
+    const decimal& lhs,
+    const decimal& rhs
+) noexcept
+{
+    // Zero is never negative, so differing signs means differing numbers
+    if (lhs.is_negative() != rhs.is_negative())
+        return lhs.is_negative() ? -1 : 1;
+
+    // Bring both magnitudes to the same scale. 10^38 * 10^38 < 2^256
+    using wide_type = std::array<std::uint32_t, 8>;
+    wide_type lhs_wide {{}};
+    wide_type rhs_wide {{}};
+    std::copy(lhs.magnitude().begin(), lhs.magnitude().end(), lhs_wide.begin());
+    std::copy(rhs.magnitude().begin(), rhs.magnitude().end(), rhs_wide.begin());
+    if (lhs.scale() < rhs.scale())
+        decimal_mul_pow10(lhs_wide, rhs.scale() - lhs.scale());
+    else if (rhs.scale() < lhs.scale())
+        decimal_mul_pow10(rhs_wide, lhs.scale() - rhs.scale());
+
+    int res = decimal_compare(lhs_wide, rhs_wide);
+    return lhs.is_negative() ? -res : res;
+}
+
+} // detail
+} // mysql
+} // boost
+
+inline boost::mysql::decimal::decimal(
+    std::int64_t unscaled_value,
+    unsigned scale
+) noexcept :
+    magnitude_(detail::decimal_magnitude_from_u64(
+        unscaled_value < 0 ?
+            0u - static_cast<std::uint64_t>(unscaled_value) :
+            static_cast<std::uint64_t>(unscaled_value)
+    )),
+    negative_(unscaled_value < 0),
+    scale_(static_cast<std::uint8_t>(scale))
+{
+    assert(scale <= max_scale);
+}
+
+inline bool boost::mysql::decimal::is_zero() const noexcept
+{
+    return detail::decimal_is_zero(magnitude_);
+}
+
+inline boost::optional<std::int64_t> boost::mysql::decimal::unscaled_value() const noexcept
+{
+    if (!detail::decimal_fits_u64(magnitude_))
+        return {};
+    std::uint64_t mag = detail::decimal_low_u64(magnitude_);
+    constexpr auto max_positive = static_cast<std::uint64_t>((std::numeric_limits<std::int64_t>::max)());
+    if (negative_)
+    {
+        if (mag > max_positive + 1)
+            return {};
+        return mag == max_positive + 1 ?
+            (std::numeric_limits<std::int64_t>::min)() :
+            -static_cast<std::int64_t>(mag);
+    }
+    else
+    {
+        if (mag > max_positive)
+            return {};
+        return static_cast<std::int64_t>(mag);
+    }
+}
+
+#ifdef BOOST_HAS_INT128
+inline boost::int128_type boost::mysql::decimal::unscaled_value_int128() const noexcept
+{
+    // Magnitudes are less than 10^38 < 2^127, so this never overflows
+    boost::uint128_type mag = 0;
+    for (std::size_t i = magnitude_.size(); i-- > 0;)
+        mag = (mag << 32) | magnitude_[i];
+    auto res = static_cast<boost::int128_type>(mag);
+    return negative_ ? -res : res;
+}
+#endif
+
+inline bool boost::mysql::decimal::rescale(
+    unsigned new_scale
+) noexcept
+{
+    if (new_scale > max_scale)
+        return false;
+    magnitude_type mag = magnitude_;
+    if (new_scale > scale_)
+    {
+        if (!detail::decimal_mul_pow10(mag, new_scale - scale_) ||
+            detail::decimal_compare(mag, detail::decimal_max_magnitude()) >= 0)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        // Only allowed if the dropped digits are all zeros
+        unsigned exponent = scale_ - new_scale;
+        while (exponent > 0)
+        {
+            unsigned chunk = (std::min)(exponent, detail::decimal_chunk_digits);
+            if (detail::decimal_divmod(mag, detail::decimal_pow10_u32(chunk)) != 0)
+                return false;
+            exponent -= chunk;
+        }
+    }
+    magnitude_ = mag;
+    scale_ = static_cast<std::uint8_t>(new_scale);
+    return true;
+}
+
+inline double boost::mysql::decimal::to_double() const noexcept
+{
+    double mag;
+    if (detail::decimal_fits_u64(magnitude_))
+    {
+        mag = static_cast<double>(detail::decimal_low_u64(magnitude_));
+    }
+    else
+    {
+        mag = 0.0;
+        for (std::size_t i = magnitude_.size(); i-- > 0;)
+            mag = mag * 4294967296.0 + magnitude_[i];
+    }
+    double res = mag / detail::decimal_pow10_double(scale_);
+    return negative_ ? -res : res;
+}
+
+inline std::size_t boost::mysql::decimal::to_chars(
+    char* output
+) const noexcept
+{
+    // Generate digits in reverse order. The wide path generates
+    // full chunks, which may add some extra leading zeros
+    char digits [max_precision + detail::decimal_chunk_digits + 1];
+    std::size_t num_digits = 0;
+    if (detail::decimal_fits_u64(magnitude_))
+    {
+        std::uint64_t mag = detail::decimal_low_u64(magnitude_);
+        do
+        {
+            digits[num_digits++] = static_cast<char>('0' + mag % 10);
+            mag /= 10;
+        } while (mag);
+    }
+    else
+    {
+        magnitude_type mag = magnitude_;
+        while (!detail::decimal_is_zero(mag))
+        {
+            std::uint32_t chunk = detail::decimal_divmod(mag, detail::decimal_chunk_divisor);
+            for (unsigned i = 0; i < detail::decimal_chunk_digits; ++i)
+            {
+                digits[num_digits++] = static_cast<char>('0' + chunk % 10);
+                chunk /= 10;
+            }
+        }
+        while (num_digits > 1 && digits[num_digits - 1] == '0')
+            --num_digits;
+    }
+
+    // There must be at least one integral digit
+    while (num_digits < scale_ + 1u)
+        digits[num_digits++] = '0';
+
+    char* it = output;
+    if (negative_)
+        *it++ = '-';
+    for (std::size_t i = num_digits; i-- > scale_;)
+        *it++ = digits[i];
+    if (scale_)
+    {
+        *it++ = '.';
+        for (std::size_t i = scale_; i-- > 0;)
+            *it++ = digits[i];
+    }
+    return static_cast<std::size_t>(it - output);
+}
+
+inline std::string boost::mysql::decimal::to_string() const
+{
+    char buff [max_string_size];
+    std::size_t size = to_chars(buff);
+    return std::string(buff, size);
+}
+
+inline bool boost::mysql::operator==(
+    const decimal& lhs,
+    const decimal& rhs
+) noexcept
+{
+    return detail::decimal_compare(lhs, rhs) == 0;
+}
+
+inline bool boost::mysql::operator<(
+    const decimal& lhs,
+    const decimal& rhs
+) noexcept
+{
+    return detail::decimal_compare(lhs, rhs) < 0;
+}
+
+inline std::ostream& boost::mysql::operator<<(
+    std::ostream& os,
+    const decimal& v
+)
+{
+    char buff [decimal::max_string_size];
+    std::size_t size = v.to_chars(buff);
+    return os.write(buff, static_cast<std::streamsize>(size));
+}
+
+inline boost::optional<boost::mysql::decimal> boost::mysql::parse_decimal(
+    boost::string_view from
+) noexcept
+{
+    const char* it = from.data();
+    const char* end = it + from.size();
+
+    // Sign
+    bool negative = false;
+    if (it != end && (*it == '-' || *it == '+'))
+    {
+        negative = *it == '-';
+        ++it;
+    }
+
+    // Digits are accumulated in chunks of 9, which fit in a 32-bit integer,
+    // and then added to the magnitude
+    decimal::magnitude_type mag {{}};
+    std::uint32_t chunk = 0;
+    unsigned chunk_size = 0;
+    unsigned significant_digits = 0;
+    unsigned integral_digits = 0;
+    unsigned scale = 0;
+    bool seen_point = false;
+    for (; it != end; ++it)
+    {
+        char c = *it;
+        if (c == '.')
+        {
+            if (seen_point || integral_digits == 0)
+                return {};
+            seen_point = true;
+            continue;
+        }
+        if (c < '0' || c > '9')
+            return {};
+        if (seen_point)
+            ++scale;
+        else
+            ++integral_digits;
+
+        // Leading zeros don't contribute to the magnitude
+        if (significant_digits == 0 && c == '0')
+            continue;
+        if (++significant_digits > decimal::max_precision)
+            return {};
+        chunk = chunk * 10 + static_cast<std::uint32_t>(c - '0');
+        if (++chunk_size == detail::decimal_chunk_digits)
+        {
+            detail::decimal_mul_add(mag, detail::decimal_chunk_divisor, chunk);
+            chunk = 0;
+            chunk_size = 0;
+        }
+    }
+    if (integral_digits == 0 || (seen_point && scale == 0) || scale > decimal::max_scale)
+        return {};
+    if (chunk_size)
+        detail::decimal_mul_add(mag, detail::decimal_pow10_u32(chunk_size), chunk);
+    return decimal(mag, negative, scale);
+}
+
+inline boost::optional<boost::mysql::decimal> boost::mysql::parse_decimal(
+    boost::string_view from,
+    unsigned scale
+) noexcept
+{
+    auto res = parse_decimal(from);
+    if (!res || !res->rescale(scale))
+        return {};
+    return res;
+}
+
+inline boost::optional<boost::mysql::decimal> boost::mysql::get_decimal(
+    const value& v,
+    const field_metadata& meta
+) noexcept
+{
+    boost::optional<decimal> res;
+    if (v.is<boost::string_view>())
+    {
+        return parse_decimal(v.get<boost::string_view>(), meta.decimals());
+    }
+    else if (v.is<std::int64_t>())
+    {
+        res = decimal(v.get<std::int64_t>(), 0);
+    }
+    else if (v.is<std::uint64_t>())
+    {
+        res = decimal(detail::decimal_magnitude_from_u64(v.get<std::uint64_t>()), false, 0);
+    }
+    if (!res || !res->rescale(meta.decimals()))
+        return {};
+    return res;
+}
+
+#endif
@@ -1523,6 +1523,14 @@ constexpr error_entry all_errors [] = {
     { errc::unknown_auth_plugin, "The user employs an authentication plugin not known to this library" },
     { errc::auth_plugin_requires_ssl, "The authentication plugin requires the connection to use SSL" },
     { errc::wrong_num_params, "The number of parameters passed to the prepared statement does not match the number of actual parameters" },
+    { errc::local_infile_disabled, "The server requested the contents of a local file, but no local infile handler was set" },
+    { errc::unrepresentable_value, "A value can't be represented as a SQL literal (e.g. NaN or infinity floating point values)" },
+    { errc::field_not_streamable, "The field requested to be streamed is not a string (only string, blob and similar fields can be streamed)" },
+    { errc::invalid_format_string, "The format string passed to format_sql is malformed, or its number of placeholders doesn't match the number of arguments" },
+    { errc::invalid_public_key, "The server RSA public key used to encrypt the password is invalid, or too small for the password length" },
+    { errc::cleartext_password_unavailable, "The server requested the password in full, but only password hashes were provided" },
+    { errc::timeout, "The operation didn't complete before the connection timeout elapsed, and the connection was closed" },
+    { errc::unsafe_charset, "SQL can't be composed client-side for the connection character set, as its strings can't be escaped safely (e.g. gbk or sjis)" },
 };
 
 } // detail
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_FORMAT_SQL_HPP
+#define BOOST_MYSQL_IMPL_FORMAT_SQL_HPP
+
+#include <boost/mysql/detail/auxiliar/sql_literal.hpp>
+#include <algorithm>
+#include <iterator>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+inline bool is_sql_format_brace(char c) noexcept { return c == '{' || c == '}'; }
+
+template <class ValueForwardIterator>
+errc format_sql_impl(
+    const format_options& opts,
+    boost::string_view format,
+    ValueForwardIterator args_first,
+    ValueForwardIterator args_last,
+    std::string& output
+)
+{
+    errc err = check_format_options(opts);
+    if (err != errc::ok)
+        return err;
+    const char* first = format.data();
+    const char* last = first + format.size();
+    while (first != last)
+    {
+        // Copy everything up to the next brace
+        const char* brace = std::find_if(first, last, &is_sql_format_brace);
+        append_sql(output, first, static_cast<std::size_t>(brace - first));
+        if (brace == last)
+            break;
+        if (brace + 1 == last)
+            return errc::invalid_format_string;
+
+        if (brace[1] == brace[0])
+        {
+            // Escaped brace ({{ or }})
+            append_sql(output, brace[0]);
+        }
+        else if (brace[0] == '{' && brace[1] == '}')
+        {
+            // Placeholder
+            if (args_first == args_last)
+                return errc::invalid_format_string;
+            err = serialize_sql_literal(*args_first, opts.backslash_escapes(), output);
+            if (err != errc::ok)
+                return err;
+            ++args_first;
+        }
+        else
+        {
+            return errc::invalid_format_string;
+        }
+        first = brace + 2;
+    }
+    return args_first == args_last ? errc::ok : errc::invalid_format_string;
+}
+
+} // detail
+} // mysql
+} // boost
+
+template <class ValueCollection, class EnableIf>
+void boost::mysql::format_sql(
+    const format_options& opts,
+    boost::string_view format,
+    const ValueCollection& args,
+    std::string& output,
+    error_code& err
+)
+{
+    err.clear();
+    output.clear();
+    output.reserve(format.size());
+    errc code = detail::format_sql_impl(opts, format, std::begin(args), std::end(args), output);
+    if (code != errc::ok)
+        err = make_error_code(code);
+}
+
+template <class ValueCollection, class EnableIf>
+std::string boost::mysql::format_sql(
+    const format_options& opts,
+    boost::string_view format,
+    const ValueCollection& args
+)
+{
+    detail::error_block blk;
+    std::string res;
+    format_sql(opts, format, args, res, blk.err);
+    blk.check();
+    return res;
+}
+
+template <class Stream, class ValueCollection, class EnableIf>
+void boost::mysql::format_sql(
+    const connection<Stream>& conn,
+    boost::string_view format,
+    const ValueCollection& args,
+    std::string& output,
+    error_code& err
+)
+{
+    format_sql(conn.format_opts(), format, args, output, err);
+}
+
+template <class Stream, class ValueCollection, class EnableIf>
+std::string boost::mysql::format_sql(
+    const connection<Stream>& conn,
+    boost::string_view format,
+    const ValueCollection& args
+)
+{
+    return format_sql(conn.format_opts(), format, args);
+}
+
+#endif
@@ -0,0 +1,422 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_HEDGED_QUERY_HPP
+#define BOOST_MYSQL_IMPL_HEDGED_QUERY_HPP
+
+#include <boost/mysql/detail/auxiliar/cancellation.hpp>
+#include <boost/asio/basic_waitable_timer.hpp>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/post.hpp>
+#ifdef BOOST_MYSQL_HAS_CANCELLATION_SLOTS
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#endif
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Shared by the handlers of all the operations involved. Self is the
+// composed operation, which is completed as soon as a connection succeeds
+// (or both fail). The losing connection is then drained in the background,
+// and DrainHandler is invoked once nothing is outstanding
+template <class SocketStream, class Self, class DrainHandler>
+class hedged_query_state : public std::enable_shared_from_this<hedged_query_state<SocketStream, Self, DrainHandler>>
+{
+    using timer_type = boost::asio::basic_waitable_timer<
+        std::chrono::steady_clock,
+        boost::asio::wait_traits<std::chrono::steady_clock>,
+        typename SocketStream::executor_type
+    >;
+    using executor_type = decltype(std::declval<Self&>().get_executor());
+    static constexpr std::size_t no_winner = 2;
+
+    Self self_;
+    DrainHandler drain_handler_;
+    executor_type executor_; // Self's, still valid once it has completed
+    std::array<socket_connection<SocketStream>*, 2> conns_;
+    std::string query_;
+    connection_params cancel_params_;
+    std::vector<row>& output_;
+    error_info* output_info_; // may be null
+    timer_type timer_;
+
+    // Per connection state
+    std::array<resultset<SocketStream>, 2> results_;
+    std::array<std::vector<row>, 2> rows_;
+    std::array<error_code, 2> errs_;
+    std::array<error_info, 2> infos_;
+    std::array<bool, 2> started_ {{false, false}};
+    std::array<bool, 2> finished_ {{false, false}};
+#ifdef BOOST_MYSQL_HAS_CANCELLATION_SLOTS
+    std::array<boost::asio::cancellation_signal, 2> signals_;
+#endif
+
+    error_code cancel_err_;
+    error_info cancel_info_;
+    unsigned outstanding_ {0}; // queries, timer wait and cancellation
+    std::size_t winner_ {no_winner};
+    bool completed_ {false};
+    bool cancelled_ {false}; // terminal cancellation requested on the composed operation
+
+    // Runs handlers in the composed operation's executor
+    template <class Handler>
+    auto bind_intermediate(Handler&& handler) -> decltype(boost::asio::bind_executor(
+        std::declval<const executor_type&>(),
+        std::forward<Handler>(handler)
+    ))
+    {
+        return boost::asio::bind_executor(executor_, std::forward<Handler>(handler));
+    }
+
+    // Like bind_intermediate, but lets on_cancel() interrupt the query running on connection i
+#ifdef BOOST_MYSQL_HAS_CANCELLATION_SLOTS
+    template <class Handler>
+    boost::asio::cancellation_slot_binder<
+        boost::asio::executor_binder<typename std::decay<Handler>::type, executor_type>,
+        boost::asio::cancellation_slot
+    >
+    bind_query(std::size_t i, Handler&& handler)
+    {
+        return boost::asio::bind_cancellation_slot(
+            signals_[i].slot(),
+            bind_intermediate(std::forward<Handler>(handler))
+        );
+    }
+#else
+    template <class Handler>
+    boost::asio::executor_binder<typename std::decay<Handler>::type, executor_type>
+    bind_query(std::size_t, Handler&& handler)
+    {
+        return bind_intermediate(std::forward<Handler>(handler));
+    }
+#endif
+
+    void start_query(std::size_t i)
+    {
+        auto self = this->shared_from_this();
+        started_[i] = true;
+        ++outstanding_;
+        conns_[i]->async_query(query_, infos_[i], bind_query(i,
+            [self, i](error_code err, resultset<SocketStream> result) {
+                self->on_query(i, err, std::move(result));
+            }
+        ));
+    }
+
+    void on_query(std::size_t i, error_code err, resultset<SocketStream>&& result)
+    {
+        if (err)
+        {
+            on_finished(i, err);
+            return;
+        }
+        auto self = this->shared_from_this();
+        results_[i] = std::move(result);
+        results_[i].async_read_all(infos_[i], bind_query(i,
+            [self, i](error_code err, std::vector<row> rows) {
+                self->rows_[i] = std::move(rows);
+                self->on_finished(i, err);
+            }
+        ));
+    }
+
+    void on_timer(error_code err)
+    {
+        --outstanding_;
+        if (!err && !completed_ && !cancelled_ && !started_[1])
+            start_query(1);
+        maybe_drained();
+    }
+
+    void on_finished(std::size_t i, error_code err)
+    {
+        --outstanding_;
+        errs_[i] = err;
+        finished_[i] = true;
+        std::size_t other = 1 - i;
+        if (!completed_)
+        {
+            if (!err)
+            {
+                winner_ = i;
+                timer_.cancel();
+                if (started_[other] && !finished_[other])
+                    cancel_query(other);
+                complete();
+            }
+            else if (cancelled_)
+            {
+                // Don't start the other query. Wait for it if it's running
+                if (finished_[other] || !started_[other])
+                    complete();
+            }
+            else if (!started_[other])
+            {
+                // Failed before hedging. Don't wait for the delay to try the other one
+                timer_.cancel();
+                start_query(other);
+            }
+            else if (finished_[other])
+            {
+                // Both failed
+                timer_.cancel();
+                complete();
+            }
+        }
+        maybe_drained();
+    }
+
+    // The query will complete with an error (or its results), which are discarded
+    void cancel_query(std::size_t i)
+    {
+        auto self = this->shared_from_this();
+        ++outstanding_;
+        conns_[i]->async_cancel_running_query(cancel_params_, cancel_info_, bind_intermediate(
+            [self](error_code err) {
+                --self->outstanding_;
+                self->cancel_err_ = err;
+                self->maybe_drained();
+            }
+        ));
+    }
+
+#ifdef BOOST_MYSQL_HAS_CANCELLATION_SLOTS
+    // Interrupts the running queries, leaving their connections in an unspecified state
+    void on_cancel()
+    {
+        if (completed_ || cancelled_)
+            return;
+        cancelled_ = true;
+        timer_.cancel();
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            if (started_[i] && !finished_[i])
+                signals_[i].emit(boost::asio::cancellation_type::terminal);
+        }
+    }
+#endif
+
+    void complete()
+    {
+        completed_ = true;
+#ifdef BOOST_MYSQL_HAS_CANCELLATION_SLOTS
+        auto slot = self_.get_cancellation_state().slot();
+        if (slot.is_connected())
+            slot.clear();
+#endif
+        if (winner_ == no_winner)
+        {
+            if (output_info_)
+                *output_info_ = std::move(infos_[0]);
+            self_.complete(cancelled_ ? error_code(boost::asio::error::operation_aborted) : errs_[0], 0);
+        }
+        else
+        {
+            output_ = std::move(rows_[winner_]);
+            if (output_info_)
+                *output_info_ = std::move(infos_[winner_]);
+            self_.complete(error_code(), winner_);
+        }
+    }
+
+    // Reports the outcome of the connection whose results were not used, once idle
+    void maybe_drained()
+    {
+        if (!completed_ || outstanding_ != 0)
+            return;
+        std::size_t loser = winner_ == no_winner ? 1 : 1 - winner_;
+        boost::asio::post(executor_, std::bind(std::move(drain_handler_), errs_[loser], cancel_err_));
+    }
+public:
+    hedged_query_state(
+        Self&& self,
+        DrainHandler&& drain_handler,
+        socket_connection<SocketStream>& primary,
+        socket_connection<SocketStream>& secondary,
+        boost::string_view query_string,
+        const connection_params& cancel_params,
+        std::vector<row>& output,
+        error_info* output_info
+    ) :
+        self_(std::move(self)),
+        drain_handler_(std::move(drain_handler)),
+        executor_(self_.get_executor()),
+        conns_ {{&primary, &secondary}},
+        query_(query_string.data(), query_string.size()),
+        cancel_params_(cancel_params),
+        output_(output),
+        output_info_(output_info),
+        timer_(primary.get_executor())
+    {
+    }
+
+    void start(std::chrono::steady_clock::duration delay)
+    {
+        auto self = this->shared_from_this();
+#ifdef BOOST_MYSQL_HAS_CANCELLATION_SLOTS
+        // Our queries don't run through self_, so cancellation must be forwarded by hand
+        auto slot = self_.get_cancellation_state().slot();
+        if (slot.is_connected())
+        {
+            std::weak_ptr<hedged_query_state> weak_self = self;
+            slot.assign([weak_self](boost::asio::cancellation_type) {
+                if (auto state = weak_self.lock())
+                    state->on_cancel();
+            });
+        }
+#endif
+        start_query(0);
+        ++outstanding_;
+        timer_.expires_after(delay);
+        timer_.async_wait(bind_intermediate([self](error_code err) { self->on_timer(err); }));
+    }
+};
+
+template <class SocketStream, class DrainHandler>
+struct hedged_query_op
+{
+    socket_connection<SocketStream>& primary_;
+    socket_connection<SocketStream>& secondary_;
+    boost::string_view query_string_;
+    std::chrono::steady_clock::duration delay_;
+    const connection_params& cancel_params_;
+    std::vector<row>& output_;
+    error_info* output_info_;
+    DrainHandler drain_handler_;
+
+    template <class Self>
+    void operator()(Self& self)
+    {
+        auto state = std::make_shared<hedged_query_state<SocketStream, Self, DrainHandler>>(
+            std::move(self),
+            std::move(drain_handler_),
+            primary_,
+            secondary_,
+            query_string_,
+            cancel_params_,
+            output_,
+            output_info_
+        );
+        state->start(delay_);
+    }
+};
+
+template <class SocketStream, class DrainHandler, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+async_hedged_query_impl(
+    socket_connection<SocketStream>& primary,
+    socket_connection<SocketStream>& secondary,
+    boost::string_view query_string,
+    std::chrono::steady_clock::duration delay,
+    const connection_params& cancel_params,
+    std::vector<row>& output,
+    error_info* output_info,
+    DrainHandler&& drain_handler,
+    CompletionToken&& token
+)
+{
+    using drain_handler_type = typename std::decay<DrainHandler>::type;
+    return boost::asio::async_compose<CompletionToken, void(error_code, std::size_t)>(
+        hedged_query_op<SocketStream, drain_handler_type>{
+            primary,
+            secondary,
+            query_string,
+            delay,
+            cancel_params,
+            output,
+            output_info,
+            std::forward<DrainHandler>(drain_handler)
+        },
+        token,
+        primary,
+        secondary
+    );
+}
+
+} // detail
+} // mysql
+} // boost
+
+template <
+    class SocketStream,
+    class DrainHandler,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(boost::mysql::error_code, std::size_t)) CompletionToken
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, std::size_t)
+)
+boost::mysql::async_hedged_query(
+    socket_connection<SocketStream>& primary,
+    socket_connection<SocketStream>& secondary,
+    boost::string_view query_string,
+    std::chrono::steady_clock::duration delay,
+    const connection_params& cancel_params,
+    std::vector<row>& output,
+    error_info& output_info,
+    DrainHandler&& drain_handler,
+    CompletionToken&& token
+)
+{
+    output_info.clear();
+    return detail::async_hedged_query_impl(
+        primary,
+        secondary,
+        query_string,
+        delay,
+        cancel_params,
+        output,
+        &output_info,
+        std::forward<DrainHandler>(drain_handler),
+        std::forward<CompletionToken>(token)
+    );
+}
+
+template <
+    class SocketStream,
+    class DrainHandler,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(boost::mysql::error_code, std::size_t)) CompletionToken
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, std::size_t)
+)
+boost::mysql::async_hedged_query(
+    socket_connection<SocketStream>& primary,
+    socket_connection<SocketStream>& secondary,
+    boost::string_view query_string,
+    std::chrono::steady_clock::duration delay,
+    const connection_params& cancel_params,
+    std::vector<row>& output,
+    DrainHandler&& drain_handler,
+    CompletionToken&& token
+)
+{
+    // The connections' shared error_info can't be used, as they may be running
+    // other operations concurrently (e.g. cancellations)
+    return detail::async_hedged_query_impl(
+        primary,
+        secondary,
+        query_string,
+        delay,
+        cancel_params,
+        output,
+        nullptr,
+        std::forward<DrainHandler>(drain_handler),
+        std::forward<CompletionToken>(token)
+    );
+}
+
+#endif
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_LAZY_ROW_HPP
+#define BOOST_MYSQL_IMPL_LAZY_ROW_HPP
+
+template <class Stream>
+bool boost::mysql::read_one(
+    resultset<Stream>& result,
+    lazy_row& output,
+    error_code& err,
+    error_info& info
+)
+{
+    output.set_metadata(result.shared_fields());
+    return result.read_one_generic(output, err, info);
+}
+
+template <class Stream>
+bool boost::mysql::read_one(
+    resultset<Stream>& result,
+    lazy_row& output
+)
+{
+    detail::error_block blk;
+    bool res = read_one(result, output, blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template <
+    class Stream,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(boost::mysql::error_code, bool)) CompletionToken
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, bool)
+)
+boost::mysql::async_read_one(
+    resultset<Stream>& result,
+    lazy_row& output,
+    CompletionToken&& token
+)
+{
+    return async_read_one(result, output, result.shared_info(), std::forward<CompletionToken>(token));
+}
+
+template <
+    class Stream,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(boost::mysql::error_code, bool)) CompletionToken
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, bool)
+)
+boost::mysql::async_read_one(
+    resultset<Stream>& result,
+    lazy_row& output,
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    result.start_async_operation(output_info);
+    output.set_metadata(result.shared_fields());
+    return result.async_read_one_generic(output, output_info, std::forward<CompletionToken>(token));
+}
+
+#endif
@@ -0,0 +1,76 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_LAZY_ROW_IPP
+#define BOOST_MYSQL_IMPL_LAZY_ROW_IPP
+
+#include <boost/mysql/detail/protocol/text_deserialization.hpp>
+#include <boost/mysql/detail/protocol/binary_deserialization.hpp>
+#include <boost/system/system_error.hpp>
+#include <cassert>
+#include <stdexcept>
+
+inline boost::mysql::value boost::mysql::lazy_row::at(
+    std::size_t i,
+    error_code& err
+) const
+{
+    if (i >= fields_.size())
+        throw std::out_of_range("lazy_row::at: index out of range");
+    err.clear();
+    const auto& field = fields_[i];
+    if (field.is_null)
+        return value();
+    assert(meta_);
+
+    value res;
+    const std::uint8_t* first = buffer_.data() + field.offset;
+    errc code;
+    if (encoding_ == detail::resultset_encoding::text)
+    {
+        boost::string_view from (reinterpret_cast<const char*>(first), field.size);
+        code = detail::deserialize_text_value(from, (*meta_)[i], res);
+    }
+    else
+    {
+        detail::deserialization_context ctx (first, first + field.size, detail::capabilities());
+        code = detail::deserialize_binary_value(ctx, (*meta_)[i], res);
+    }
+    if (code != errc::ok)
+    {
+        err = make_error_code(code);
+        return value();
+    }
+    return res;
+}
+
+inline boost::mysql::value boost::mysql::lazy_row::at(
+    std::size_t i
+) const
+{
+    error_code err;
+    value res = at(i, err);
+    if (err)
+        throw boost::system::system_error(err);
+    return res;
+}
+
+inline boost::mysql::error_code boost::mysql::lazy_row::index(
+    detail::deserialization_context& ctx,
+    const std::vector<field_metadata>& meta,
+    detail::resultset_encoding encoding
+)
+{
+    assert(ctx.first() == buffer_.data());
+    assert(meta_.get() == &meta);
+    encoding_ = encoding;
+    return encoding == detail::resultset_encoding::text ?
+        detail::index_text_row(ctx, meta, fields_) :
+        detail::index_binary_row(ctx, meta, fields_);
+}
+
+#endif
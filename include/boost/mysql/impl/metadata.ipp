@@ -8,6 +8,8 @@
 #ifndef BOOST_MYSQL_IMPL_METADATA_IPP
 #define BOOST_MYSQL_IMPL_METADATA_IPP
 
+#include <cassert>
+
 namespace boost {
 namespace mysql {
 namespace detail {
@@ -77,10 +79,117 @@ inline field_type compute_field_type(
     }
 }
 
+inline char ascii_to_lower(char c) noexcept
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// FNV-1a, ignoring case
+inline std::uint32_t hash_field_name(
+    boost::string_view name
+) noexcept
+{
+    std::uint32_t res = 2166136261u;
+    for (char c: name)
+    {
+        res ^= static_cast<unsigned char>(ascii_to_lower(c));
+        res *= 16777619u;
+    }
+    return res;
+}
+
+inline bool field_names_equal(
+    boost::string_view lhs,
+    boost::string_view rhs,
+    case_sensitivity cs
+) noexcept
+{
+    if (cs == case_sensitivity::case_sensitive)
+        return lhs == rhs;
+    if (lhs.size() != rhs.size())
+        return false;
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (ascii_to_lower(lhs[i]) != ascii_to_lower(rhs[i]))
+            return false;
+    }
+    return true;
+}
+
 } // detail
 } // mysql
 } // boost
 
+// All fields are inserted, even if their names are duplicated. Fields with
+// the same name (ignoring case) have the same hash, so they are placed
+// along the probe sequence in field order, and lookups find the first one
+inline void boost::mysql::detail::field_name_index::build(
+    const std::vector<field_metadata>& fields
+)
+{
+    // Power of two size, with a load factor of at most 0.5
+    std::size_t num_slots = 2;
+    while (num_slots < fields.size() * 2)
+        num_slots *= 2;
+    slots_.assign(num_slots, 0);
+    std::size_t mask = num_slots - 1;
+
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        std::size_t pos = hash_field_name(fields[i].field_name()) & mask;
+        while (slots_[pos] != 0)
+            pos = (pos + 1) & mask;
+        slots_[pos] = static_cast<std::uint32_t>(i + 1);
+    }
+}
+
+inline boost::optional<std::size_t> boost::mysql::detail::field_name_index::find(
+    const std::vector<field_metadata>& fields,
+    boost::string_view name,
+    case_sensitivity cs
+) const noexcept
+{
+    assert(!slots_.empty());
+    std::size_t mask = slots_.size() - 1;
+    std::size_t pos = hash_field_name(name) & mask;
+    while (slots_[pos] != 0)
+    {
+        std::size_t index = slots_[pos] - 1;
+        if (field_names_equal(fields[index].field_name(), name, cs))
+            return index;
+        pos = (pos + 1) & mask;
+    }
+    return {};
+}
+
+inline boost::mysql::detail::resultset_metadata::resultset_metadata(
+    std::vector<bytestring>&& buffers,
+    std::vector<field_metadata>&& fields
+)
+{
+    storage_ = std::make_shared<resultset_metadata_storage>(std::move(buffers), std::move(fields));
+    fields_ = std::shared_ptr<const std::vector<field_metadata>>(storage_, &storage_->fields);
+}
+
+inline const std::vector<boost::mysql::field_metadata>&
+boost::mysql::detail::resultset_metadata::fields() const noexcept
+{
+    static const std::vector<field_metadata> empty;
+    return fields_ ? *fields_ : empty;
+}
+
+inline boost::optional<std::size_t> boost::mysql::detail::resultset_metadata::field_index(
+    boost::string_view name,
+    case_sensitivity cs
+) const
+{
+    if (!storage_)
+        return {};
+    resultset_metadata_storage& storage = *storage_;
+    std::call_once(storage.index_once, [&storage] { storage.index.build(storage.fields); });
+    return storage.index.find(storage.fields, name, cs);
+}
+
 inline boost::mysql::field_type boost::mysql::field_metadata::type() const noexcept
 {
     if (field_type_ == field_type::_not_computed)
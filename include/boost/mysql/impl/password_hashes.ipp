@@ -0,0 +1,34 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_PASSWORD_HASHES_IPP
+#define BOOST_MYSQL_IMPL_PASSWORD_HASHES_IPP
+
+#include <openssl/crypto.h>
+#include <openssl/sha.h>
+
+inline boost::mysql::password_hashes::password_hashes(
+    boost::string_view password
+) noexcept :
+    empty_(password.empty())
+{
+    auto data = reinterpret_cast<const unsigned char*>(password.data());
+    SHA1(data, password.size(), sha1_.data());
+    SHA1(sha1_.data(), sha1_.size(), double_sha1_.data());
+    SHA256(data, password.size(), sha256_.data());
+    SHA256(sha256_.data(), sha256_.size(), double_sha256_.data());
+}
+
+inline boost::mysql::password_hashes::~password_hashes()
+{
+    OPENSSL_cleanse(sha1_.data(), sha1_.size());
+    OPENSSL_cleanse(double_sha1_.data(), double_sha1_.size());
+    OPENSSL_cleanse(sha256_.data(), sha256_.size());
+    OPENSSL_cleanse(double_sha256_.data(), double_sha256_.size());
+}
+
+#endif
@@ -10,6 +10,8 @@
 
 #include <boost/mysql/detail/network_algorithms/execute_statement.hpp>
 #include <boost/mysql/detail/network_algorithms/close_statement.hpp>
+#include <boost/mysql/detail/network_algorithms/execute_many.hpp>
+#include <boost/mysql/detail/network_algorithms/send_long_data.hpp>
 #include <boost/mysql/detail/auxiliar/stringize.hpp>
 #include <boost/asio/bind_executor.hpp>
 
@@ -55,10 +57,14 @@ boost::mysql::resultset<Stream> boost::mysql::prepared_statement<Stream>::execut
             stmt_msg_.statement_id,
             params.first(),
             params.last(),
+            &long_data_params_,
             res,
             err,
             info
         );
+
+        // The server discards long data after each execution
+        long_data_params_.clear();
     }
 
     return res;
@@ -122,9 +128,14 @@ struct boost::mysql::prepared_statement<Stream>::async_execute_initiation
                 stmt.stmt_msg_.statement_id,
                 params_first,
                 params_last,
+                &stmt.long_data_params_,
                 std::forward<HandlerType>(handler),
                 info
             );
+
+            // The message has already been serialized.
+            // The server discards long data after each execution
+            stmt.long_data_params_.clear();
         }
     }
 };
@@ -144,6 +155,7 @@ boost::mysql::prepared_statement<Stream>::async_execute(
 {
     output_info.clear();
     assert(valid());
+    channel_->start_deadline();
 
     // Check we got passed the right number of params
     error_code err;
@@ -160,6 +172,128 @@ boost::mysql::prepared_statement<Stream>::async_execute(
     );
 }
 
+template <class Stream>
+template <class ParamSetCollection>
+std::uint64_t boost::mysql::prepared_statement<Stream>::execute_many(
+    const ParamSetCollection& param_sets,
+    error_code& err,
+    error_info& info
+)
+{
+    assert(valid());
+    detail::clear_errors(err, info);
+    auto res = detail::execute_many(*channel_, id(), num_params(), param_sets, &long_data_params_, err, info);
+    long_data_params_.clear();
+    return res;
+}
+
+template <class Stream>
+template <class ParamSetCollection>
+std::uint64_t boost::mysql::prepared_statement<Stream>::execute_many(
+    const ParamSetCollection& param_sets
+)
+{
+    assert(valid());
+    detail::error_block blk;
+    auto res = execute_many(param_sets, blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template <class Stream>
+template <class ParamSetCollection, BOOST_ASIO_COMPLETION_TOKEN_FOR(
+    void(boost::mysql::error_code, std::uint64_t)) CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, std::uint64_t)
+)
+boost::mysql::prepared_statement<Stream>::async_execute_many(
+    const ParamSetCollection& param_sets,
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    assert(valid());
+    output_info.clear();
+    channel_->start_deadline();
+
+    // The server discards long data after each execution.
+    // Long data flags are copied before async_execute_many returns
+    std::vector<bool> long_data_params;
+    long_data_params.swap(long_data_params_);
+
+    return detail::async_execute_many(
+        *channel_,
+        id(),
+        num_params(),
+        param_sets,
+        &long_data_params,
+        std::forward<CompletionToken>(token),
+        output_info
+    );
+}
+
+template <class Stream>
+void boost::mysql::prepared_statement<Stream>::send_long_data(
+    unsigned param_index,
+    boost::asio::const_buffer data,
+    error_code& code,
+    error_info& info
+)
+{
+    assert(valid());
+    assert(param_index < num_params());
+    detail::clear_errors(code, info);
+    mark_long_data(param_index);
+    detail::send_long_data(
+        *channel_,
+        id(),
+        static_cast<std::uint16_t>(param_index),
+        data,
+        code,
+        info
+    );
+}
+
+template <class Stream>
+void boost::mysql::prepared_statement<Stream>::send_long_data(
+    unsigned param_index,
+    boost::asio::const_buffer data
+)
+{
+    detail::error_block blk;
+    send_long_data(param_index, data, blk.err, blk.info);
+    blk.check();
+}
+
+template <class Stream>
+template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(boost::mysql::error_code)) CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::prepared_statement<Stream>::async_send_long_data(
+    unsigned param_index,
+    boost::asio::const_buffer data,
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    assert(valid());
+    assert(param_index < num_params());
+    output_info.clear();
+    channel_->start_deadline();
+    mark_long_data(param_index);
+    return detail::async_send_long_data(
+        *channel_,
+        id(),
+        static_cast<std::uint16_t>(param_index),
+        data,
+        std::forward<CompletionToken>(token),
+        output_info
+    );
+}
+
 template <class Stream>
 void boost::mysql::prepared_statement<Stream>::close(
     error_code& code,
@@ -193,6 +327,7 @@ boost::mysql::prepared_statement<Stream>::async_close(
 {
     assert(valid());
     output_info.clear();
+    channel_->start_deadline();
     return detail::async_close_statement(
         *channel_,
         id(),
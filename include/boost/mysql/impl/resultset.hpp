@@ -16,8 +16,9 @@
 #include <memory>
 
 template <class Stream>
-bool boost::mysql::resultset<Stream>::read_one(
-	row& output,
+template <class RowType>
+bool boost::mysql::resultset<Stream>::read_one_generic(
+	RowType& output,
     error_code& err,
     error_info& info
 )
@@ -32,7 +33,7 @@ bool boost::mysql::resultset<Stream>::read_one(
         return false;
     }
     auto result = detail::read_row(
-        deserializer_,
+        encoding_,
         *channel_,
         meta_.fields(),
         output,
@@ -45,6 +46,16 @@ bool boost::mysql::resultset<Stream>::read_one(
     return result == detail::read_row_result::row;
 }
 
+template <class Stream>
+bool boost::mysql::resultset<Stream>::read_one(
+	row& output,
+    error_code& err,
+    error_info& info
+)
+{
+    return read_one_generic(output, err, info);
+}
+
 template <class Stream>
 bool boost::mysql::resultset<Stream>::read_one(
 	row& output
@@ -112,16 +123,17 @@ std::vector<boost::mysql::row> boost::mysql::resultset<Stream>::read_all()
 }
 
 template<class Stream>
+template<class RowType>
 struct boost::mysql::resultset<Stream>::read_one_op
     : boost::asio::coroutine
 {
     resultset<Stream>& resultset_;
-    row& output_;
+    RowType& output_;
     error_info& output_info_;
 
     read_one_op(
         resultset<Stream>& obj,
-		row& output,
+		RowType& output,
         error_info& output_info
     ) :
         resultset_(obj),
@@ -148,7 +160,7 @@ struct boost::mysql::resultset<Stream>::read_one_op
                 BOOST_ASIO_CORO_YIELD break;
             }
             BOOST_ASIO_CORO_YIELD detail::async_read_row(
-                resultset_.deserializer_,
+                resultset_.encoding_,
                 *resultset_.channel_,
                 resultset_.meta_.fields(),
 				output_,
@@ -178,16 +190,198 @@ boost::mysql::resultset<Stream>::async_read_one(
     error_info& output_info,
     CompletionToken&& token
 )
+{
+    start_async_operation(output_info);
+    return async_read_one_generic(output, output_info, std::forward<CompletionToken>(token));
+}
+
+template <class Stream>
+template <class RowType, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, bool)
+)
+boost::mysql::resultset<Stream>::async_read_one_generic(
+	RowType& output,
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    assert(valid());
+    return boost::asio::async_compose<CompletionToken, void(error_code, bool)>(
+        read_one_op<RowType>(*this, output, output_info),
+        token,
+        *this
+    );
+}
+
+template <class Stream>
+bool boost::mysql::resultset<Stream>::read_one_streamed(
+    row& output,
+    error_code& err,
+    error_info& info
+)
+{
+    assert(valid());
+
+    detail::clear_errors(err, info);
+
+    if (complete())
+    {
+        output.clear();
+        return false;
+    }
+    auto result = detail::read_row_streamed(
+        encoding_,
+        *channel_,
+        meta_.fields(),
+        output,
+        ok_packet_buffer_,
+        ok_packet_,
+        streamed_,
+        err,
+        info
+    );
+    eof_received_ = result == detail::read_row_result::eof;
+    return result == detail::read_row_result::row;
+}
+
+template <class Stream>
+bool boost::mysql::resultset<Stream>::read_one_streamed(
+    row& output
+)
+{
+    detail::error_block blk;
+    bool res = read_one_streamed(output, blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template<class Stream>
+struct boost::mysql::resultset<Stream>::read_one_streamed_op
+    : boost::asio::coroutine
+{
+    resultset<Stream>& resultset_;
+    row& output_;
+    error_info& output_info_;
+
+    read_one_streamed_op(
+        resultset<Stream>& obj,
+        row& output,
+        error_info& output_info
+    ) :
+        resultset_(obj),
+        output_(output),
+        output_info_(output_info)
+    {
+    }
+
+    template<class Self>
+    void operator()(
+        Self& self,
+        error_code err = {},
+        detail::read_row_result result=detail::read_row_result::error
+    )
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if (resultset_.complete())
+            {
+                // ensure return as if by post
+                BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+                output_.clear();
+                self.complete(error_code(), false);
+                BOOST_ASIO_CORO_YIELD break;
+            }
+            BOOST_ASIO_CORO_YIELD detail::async_read_row_streamed(
+                resultset_.encoding_,
+                *resultset_.channel_,
+                resultset_.meta_.fields(),
+                output_,
+                resultset_.ok_packet_buffer_,
+                resultset_.ok_packet_,
+                resultset_.streamed_,
+                std::move(self),
+                output_info_
+            );
+            resultset_.eof_received_ = result == detail::read_row_result::eof;
+            self.complete(
+                err,
+                result == detail::read_row_result::row
+            );
+        }
+    }
+};
+
+template <class Stream>
+template <BOOST_ASIO_COMPLETION_TOKEN_FOR(
+    void(boost::mysql::error_code, bool)) CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, bool)
+)
+boost::mysql::resultset<Stream>::async_read_one_streamed(
+    row& output,
+    error_info& output_info,
+    CompletionToken&& token
+)
 {
     assert(valid());
     output_info.clear();
+    channel_->start_deadline();
     return boost::asio::async_compose<CompletionToken, void(error_code, bool)>(
-        read_one_op(*this, output, output_info),
+        read_one_streamed_op(*this, output, output_info),
         token,
         *this
     );
 }
 
+template <class Stream>
+std::size_t boost::mysql::resultset<Stream>::read_streamed_chunk(
+    boost::asio::mutable_buffer buffer,
+    error_code& err,
+    error_info& info
+)
+{
+    assert(valid());
+    detail::clear_errors(err, info);
+    return detail::read_streamed_chunk(*channel_, streamed_, buffer, err);
+}
+
+template <class Stream>
+std::size_t boost::mysql::resultset<Stream>::read_streamed_chunk(
+    boost::asio::mutable_buffer buffer
+)
+{
+    detail::error_block blk;
+    auto res = read_streamed_chunk(buffer, blk.err, blk.info);
+    blk.check();
+    return res;
+}
+
+template <class Stream>
+template <BOOST_ASIO_COMPLETION_TOKEN_FOR(
+    void(boost::mysql::error_code, std::size_t)) CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code, std::size_t)
+)
+boost::mysql::resultset<Stream>::async_read_streamed_chunk(
+    boost::asio::mutable_buffer buffer,
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    assert(valid());
+    output_info.clear();
+    channel_->start_deadline();
+    return detail::async_read_streamed_chunk(
+        *channel_,
+        streamed_,
+        buffer,
+        std::forward<CompletionToken>(token)
+    );
+}
 
 
 template<class Stream>
@@ -260,7 +454,7 @@ struct boost::mysql::resultset<Stream>::read_many_op
             {
                 impl.cont = true;
                 BOOST_ASIO_CORO_YIELD detail::async_read_row(
-                    impl.parent_resultset.deserializer_,
+                    impl.parent_resultset.encoding_,
                     *impl.parent_resultset.channel_,
                     impl.parent_resultset.meta_.fields(),
 					impl.current_row,
@@ -312,6 +506,7 @@ boost::mysql::resultset<Stream>::async_read_many(
 {
     assert(valid());
     output_info.clear();
+    channel_->start_deadline();
     return boost::asio::async_compose<
         CompletionToken,
         void(error_code, std::vector<row>)
@@ -341,5 +536,4 @@ boost::mysql::resultset<Stream>::async_read_all(
     );
 }
 
-
 #endif
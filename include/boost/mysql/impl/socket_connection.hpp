@@ -10,6 +10,10 @@
 
 #include <boost/mysql/detail/network_algorithms/close_connection.hpp>
 #include <boost/mysql/detail/network_algorithms/connect.hpp>
+#include <boost/mysql/detail/auxiliar/cancellation.hpp>
+#include <boost/mysql/detail/auxiliar/stringize.hpp>
+#include <boost/asio/post.hpp>
+#include <memory>
 
 template <class SocketStream>
 void boost::mysql::socket_connection<SocketStream>::connect(
@@ -20,6 +24,7 @@ void boost::mysql::socket_connection<SocketStream>::connect(
 )
 {
     detail::clear_errors(ec, info);
+    peer_endpoint_ = endpoint;
     detail::connect(this->get_channel(), endpoint, params, ec, info);
 }
 
@@ -30,6 +35,7 @@ void boost::mysql::socket_connection<SocketStream>::connect(
 )
 {
     detail::error_block blk;
+    peer_endpoint_ = endpoint;
     detail::connect(this->get_channel(), endpoint, params, blk.err, blk.info);
     blk.check();
 }
@@ -48,6 +54,8 @@ boost::mysql::socket_connection<SocketStream>::async_connect(
 )
 {
     output_info.clear();
+    peer_endpoint_ = endpoint;
+    this->get_channel().start_deadline();
     return detail::async_connect(
         this->get_channel(),
         endpoint,
@@ -57,6 +65,26 @@ boost::mysql::socket_connection<SocketStream>::async_connect(
     );
 }
 
+template <class SocketStream>
+void boost::mysql::socket_connection<SocketStream>::handshake(
+    const connection_params& params,
+    error_code& ec,
+    error_info& info
+)
+{
+    record_peer_endpoint();
+    connection<SocketStream>::handshake(params, ec, info);
+}
+
+template <class SocketStream>
+void boost::mysql::socket_connection<SocketStream>::handshake(
+    const connection_params& params
+)
+{
+    record_peer_endpoint();
+    connection<SocketStream>::handshake(params);
+}
+
 template <class SocketStream>
 void boost::mysql::socket_connection<SocketStream>::close(
     error_code& err,
@@ -87,6 +115,7 @@ boost::mysql::socket_connection<SocketStream>::async_close(
 )
 {
     output_info.clear();
+    this->get_channel().start_deadline();
     return detail::async_close_connection(
         this->get_channel(),
         std::forward<CompletionToken>(token),
@@ -94,4 +123,197 @@ boost::mysql::socket_connection<SocketStream>::async_close(
     );
 }
 
-#endif
\ No newline at end of file
+// Cancel running query
+template <class SocketStream>
+void boost::mysql::socket_connection<SocketStream>::cancel_running_query(
+    const connection_params& params,
+    error_code& err,
+    error_info& info
+)
+{
+    detail::clear_errors(err, info);
+    if (!peer_endpoint_)
+    {
+        err = make_error_code(boost::asio::error::not_connected);
+        return;
+    }
+    socket_connection<SocketStream> control (this->get_executor());
+    control.connect(*peer_endpoint_, params, err, info);
+    if (err)
+        return;
+    control.query(detail::stringize("KILL QUERY ", this->connection_id()), err, info);
+    error_code close_err;
+    error_info close_info;
+    control.close(close_err, close_info);
+}
+
+template <class SocketStream>
+void boost::mysql::socket_connection<SocketStream>::cancel_running_query(
+    const connection_params& params
+)
+{
+    detail::error_block blk;
+    cancel_running_query(params, blk.err, blk.info);
+    blk.check();
+}
+
+template <class SocketStream>
+void boost::mysql::socket_connection<SocketStream>::cancel_running_query(
+    socket_connection<SocketStream>& control,
+    error_code& err,
+    error_info& info
+)
+{
+    detail::clear_errors(err, info);
+    control.query(detail::stringize("KILL QUERY ", this->connection_id()), err, info);
+}
+
+template <class SocketStream>
+void boost::mysql::socket_connection<SocketStream>::cancel_running_query(
+    socket_connection<SocketStream>& control
+)
+{
+    detail::error_block blk;
+    cancel_running_query(control, blk.err, blk.info);
+    blk.check();
+}
+
+template <class SocketStream>
+struct boost::mysql::socket_connection<SocketStream>::cancel_running_query_op
+    : boost::asio::coroutine
+{
+    socket_connection<SocketStream>& conn_;
+    boost::optional<connection_params> params_; // set if we should open the control connection
+    socket_connection<SocketStream>* control_;   // supplied by the user or owned_control_
+    std::unique_ptr<socket_connection<SocketStream>> owned_control_;
+    error_info* output_info_; // if null, the control connection's one is used
+    std::string query_;
+    error_code err_;
+    error_info close_info_;
+
+    cancel_running_query_op(
+        socket_connection<SocketStream>& conn,
+        const connection_params* params,
+        socket_connection<SocketStream>* control,
+        error_info* output_info
+    ) :
+        conn_(conn),
+        params_(params ? boost::optional<connection_params>(*params) : boost::none),
+        control_(control),
+        output_info_(output_info)
+    {
+    }
+
+    error_info& info() noexcept { return output_info_ ? *output_info_ : control_->shared_info(); }
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err = {}
+    )
+    {
+        detail::check_cancellation(self, err);
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            if (params_)
+            {
+                if (!conn_.peer_endpoint_)
+                {
+                    BOOST_ASIO_CORO_YIELD boost::asio::post(std::move(self));
+                    self.complete(make_error_code(boost::asio::error::not_connected));
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+
+                // Connect the control connection
+                owned_control_.reset(new socket_connection<SocketStream>(conn_.get_executor()));
+                control_ = owned_control_.get();
+                control_->set_timeout(conn_.timeout());
+                BOOST_ASIO_CORO_YIELD control_->async_connect(*conn_.peer_endpoint_, *params_, info(), std::move(self));
+                if (err)
+                {
+                    self.complete(err);
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+            }
+
+            // Kill. The response is an OK packet
+            query_ = detail::stringize("KILL QUERY ", conn_.connection_id());
+            BOOST_ASIO_CORO_YIELD control_->async_query(query_, info(), std::move(self));
+            err_ = err;
+
+            // Close the control connection if we opened it, ignoring any errors
+            if (owned_control_)
+            {
+                BOOST_ASIO_CORO_YIELD control_->async_close(close_info_, std::move(self));
+            }
+            self.complete(err_);
+        }
+    }
+
+    template <class Self>
+    void operator()(
+        Self& self,
+        error_code err,
+        resultset<SocketStream>
+    )
+    {
+        (*this)(self, err);
+    }
+};
+
+template <class SocketStream>
+template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(boost::mysql::error_code)) CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::socket_connection<SocketStream>::async_cancel_running_query(
+    const connection_params& params,
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    output_info.clear();
+    return async_cancel_running_query_impl(params, &output_info, std::forward<CompletionToken>(token));
+}
+
+template <class SocketStream>
+template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(boost::mysql::error_code)) CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::socket_connection<SocketStream>::async_cancel_running_query(
+    socket_connection<SocketStream>& control,
+    error_info& output_info,
+    CompletionToken&& token
+)
+{
+    output_info.clear();
+    return boost::asio::async_compose<CompletionToken, void(error_code)>(
+        cancel_running_query_op(*this, nullptr, &control, &output_info),
+        token,
+        *this
+    );
+}
+
+template <class SocketStream>
+template <class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(
+    CompletionToken,
+    void(boost::mysql::error_code)
+)
+boost::mysql::socket_connection<SocketStream>::async_cancel_running_query_impl(
+    const connection_params& params,
+    error_info* output_info,
+    CompletionToken&& token
+)
+{
+    return boost::asio::async_compose<CompletionToken, void(error_code)>(
+        cancel_running_query_op(*this, &params, nullptr, output_info),
+        token,
+        *this
+    );
+}
+
+#endif
@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_LAZY_ROW_HPP
+#define BOOST_MYSQL_LAZY_ROW_HPP
+
+#include <boost/mysql/value.hpp>
+#include <boost/mysql/metadata.hpp>
+#include <boost/mysql/error.hpp>
+#include <boost/mysql/resultset.hpp>
+#include <boost/mysql/detail/auxiliar/bytestring.hpp>
+#include <boost/mysql/detail/protocol/constants.hpp>
+#include <boost/mysql/detail/protocol/deserialization_context.hpp>
+#include <boost/mysql/detail/protocol/field_ref.hpp>
+#include <memory>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief A row whose values are deserialized on access.
+ * \details Populated by [reflink read_one] and [reflink async_read_one]. When a [reflink lazy_row] is read,
+ * the message sent by the server is scanned once to locate each field, but
+ * no [reflink value] is deserialized. A field is only deserialized when it's
+ * accessed, using [refmem lazy_row at]. This is faster than reading a [reflink row]
+ * when only a few fields out of many are used.
+ *
+ * As fields are deserialized on every access, malformed values are reported by
+ * [refmem lazy_row at], rather than when the row is read.
+ *
+ * A [reflink lazy_row] shares ownership of the metadata of the [reflink resultset]
+ * it was read from, so its values can still be accessed after the resultset
+ * has been destroyed or moved. String [reflink value]s returned
+ * by [refmem lazy_row at] point into the row's internal buffer, and become invalid
+ * when the row is destroyed, assigned to, cleared or read into again.
+ *
+ * Default constructible, movable and copyable.
+ */
+class lazy_row
+{
+    detail::bytestring buffer_;
+    std::vector<detail::field_ref> fields_;
+    std::shared_ptr<const std::vector<field_metadata>> meta_;
+    detail::resultset_encoding encoding_ {detail::resultset_encoding::text};
+public:
+    /// Default constructor. Constructs an empty row.
+    lazy_row() = default;
+
+    /// Returns the number of fields in the row.
+    std::size_t size() const noexcept { return fields_.size(); }
+
+    /// Returns `true` if the row has no fields.
+    bool empty() const noexcept { return fields_.empty(); }
+
+    /**
+     * \brief Returns `true` if the i-th field is NULL.
+     * \details Doesn't deserialize the field. `i` must be less than [refmem lazy_row size].
+     *
+     * Note that some invalid `__DATE__` and `__DATETIME__` values are represented
+     * as NULL [reflink value]s (see [link mysql.types this section]), but are not NULL
+     * in the database. This function returns `false` for them.
+     */
+    bool is_null(std::size_t i) const noexcept { return fields_[i].is_null; }
+
+    /**
+     * \brief Deserializes the i-th field (error code version).
+     * \details If the field contains an invalid value, returns a NULL value and sets `err`.
+     * Throws `std::out_of_range` if `i` is not less than [refmem lazy_row size].
+     */
+    value at(std::size_t i, error_code& err) const;
+
+    /**
+     * \brief Deserializes the i-th field (exceptions version).
+     * \details If the field contains an invalid value, throws a `boost::system::system_error`.
+     * Throws `std::out_of_range` if `i` is not less than [refmem lazy_row size].
+     */
+    value at(std::size_t i) const;
+
+    /**
+     * \brief Clears the row object.
+     * \details After calling this function, [refmem lazy_row size] will return zero.
+     * Any string values obtained from this row will become invalid.
+     */
+    void clear() noexcept
+    {
+        buffer_.clear();
+        fields_.clear();
+        meta_ = nullptr;
+    }
+
+#ifndef BOOST_MYSQL_DOXYGEN
+    // Private, do not use. The metadata must be set before calling index()
+    detail::bytestring& buffer() noexcept { return buffer_; }
+    void set_metadata(const std::shared_ptr<const std::vector<field_metadata>>& meta)
+    {
+        if (meta_ != meta)
+            meta_ = meta;
+    }
+    error_code index(
+        detail::deserialization_context& ctx,
+        const std::vector<field_metadata>& meta,
+        detail::resultset_encoding encoding
+    );
+#endif
+};
+
+/**
+ * \brief Reads a single row without deserializing its values
+ *        (sync with error code version).
+ * \details Behaves like [refmem resultset read_one], but fields are
+ * only located, not deserialized. Values are deserialized when accessed
+ * through [refmem lazy_row at].
+ */
+template <class Stream>
+bool read_one(
+    resultset<Stream>& result,
+    lazy_row& output,
+    error_code& err,
+    error_info& info
+);
+
+/**
+ * \brief Reads a single row without deserializing its values
+ *        (sync with exceptions version).
+ * \details Behaves like [refmem resultset read_one], but fields are
+ * only located, not deserialized. Values are deserialized when accessed
+ * through [refmem lazy_row at].
+ */
+template <class Stream>
+bool read_one(
+    resultset<Stream>& result,
+    lazy_row& output
+);
+
+/**
+ * \brief Reads a single row without deserializing its values
+ *        (async without [reflink error_info] version).
+ * \details Behaves like [refmem resultset async_read_one], but fields are
+ * only located, not deserialized. Values are deserialized when accessed
+ * through [refmem lazy_row at].
+ *
+ * The handler signature for this operation is
+ * `void(boost::mysql::error_code, bool)`.
+ */
+template <
+    class Stream,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, bool))
+    CompletionToken
+    BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(typename resultset<Stream>::executor_type)
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, bool))
+async_read_one(
+    resultset<Stream>& result,
+    lazy_row& output,
+    CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(typename resultset<Stream>::executor_type)
+);
+
+/**
+ * \brief Reads a single row without deserializing its values
+ *        (async with [reflink error_info] version).
+ * \details Behaves like [refmem resultset async_read_one], but fields are
+ * only located, not deserialized. Values are deserialized when accessed
+ * through [refmem lazy_row at].
+ *
+ * The handler signature for this operation is
+ * `void(boost::mysql::error_code, bool)`.
+ */
+template <
+    class Stream,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, bool))
+    CompletionToken
+    BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(typename resultset<Stream>::executor_type)
+>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, bool))
+async_read_one(
+    resultset<Stream>& result,
+    lazy_row& output,
+    error_info& output_info,
+    CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(typename resultset<Stream>::executor_type)
+);
+
+namespace detail {
+
+// Found by detail::read_row using ADL
+inline error_code deserialize_row(
+    resultset_encoding encoding,
+    deserialization_context& ctx,
+    const std::vector<field_metadata>& meta,
+    lazy_row& output
+)
+{
+    return output.index(ctx, meta, encoding);
+}
+
+} // detail
+
+} // mysql
+} // boost
+
+#include <boost/mysql/impl/lazy_row.ipp>
+#include <boost/mysql/impl/lazy_row.hpp>
+
+#endif
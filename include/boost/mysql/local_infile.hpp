@@ -0,0 +1,47 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_LOCAL_INFILE_HPP
+#define BOOST_MYSQL_LOCAL_INFILE_HPP
+
+#include <boost/mysql/error.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/utility/string_view.hpp>
+#include <cstddef>
+#include <functional>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief Provides the file contents for `LOAD DATA LOCAL INFILE` statements.
+ * \details Install one using [refmem connection set_local_infile_handler].
+ * When the server processes a `LOAD DATA LOCAL INFILE` statement, it asks the
+ * client for the contents of the file named in the statement. The library
+ * then calls the handler repeatedly, passing the requested file name and a buffer
+ * to fill. Each call should write up to `buffer.size()` bytes into `buffer`
+ * and return the number of bytes written. Each chunk is sent to the server
+ * as soon as the handler returns, so the file is never held in memory
+ * as a whole. Returning zero signals the end of the data.
+ *
+ * The handler may abort the load by setting its `error_code` argument.
+ * The server is then told that no more data is available, and the
+ * operation fails with the error set by the handler.
+ *
+ * The file name is chosen by the server, so handlers must not blindly open it.
+ * The handler is called synchronously, even within asynchronous operations.
+ */
+using local_infile_handler = std::function<std::size_t(
+    boost::string_view filename,
+    boost::asio::mutable_buffer buffer,
+    error_code& err
+)>;
+
+} // mysql
+} // boost
+
+#endif
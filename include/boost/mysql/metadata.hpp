@@ -11,10 +11,29 @@
 #include <boost/mysql/detail/protocol/common_messages.hpp>
 #include <boost/mysql/detail/auxiliar/bytestring.hpp>
 #include <boost/mysql/field_type.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/utility/string_view.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace boost {
 namespace mysql {
 
+/**
+ * \brief Controls how field names are compared when looking up fields by name.
+ * \details See [refmem resultset field_index].
+ */
+enum class case_sensitivity
+{
+    /// Names must match exactly.
+    case_sensitive,
+
+    /// Names are compared ignoring the case of ASCII letters, as MySQL does for column names.
+    case_insensitive
+};
+
 /**
  * \brief Holds [link mysql.resultsets.metadata metadata] about a field in a SQL query.
  * \details All strings point into externally owned memory. The object
@@ -119,20 +138,54 @@ public:
 
 namespace detail {
 
+// Open addressing hash table mapping field names to field indices.
+// Names are hashed ignoring case, so the same table serves both
+// case sensitive and insensitive lookups
+class field_name_index
+{
+    std::vector<std::uint32_t> slots_; // field index + 1, zero means empty
+public:
+    bool built() const noexcept { return !slots_.empty(); }
+    void build(const std::vector<field_metadata>& fields);
+    boost::optional<std::size_t> find(
+        const std::vector<field_metadata>& fields,
+        boost::string_view name,
+        case_sensitivity cs
+    ) const noexcept;
+};
+
+// field_metadata objects point into the buffers they were deserialized from,
+// so both are kept together. The name index is built on the first lookup,
+// so resultsets that are never looked up by name don't pay for it
+struct resultset_metadata_storage
+{
+    std::vector<bytestring> buffers;
+    std::vector<field_metadata> fields;
+    std::once_flag index_once;
+    field_name_index index;
+
+    resultset_metadata_storage(std::vector<bytestring>&& bufs, std::vector<field_metadata>&& flds):
+        buffers(std::move(bufs)), fields(std::move(flds)) {};
+};
+
 class resultset_metadata
 {
-    std::vector<bytestring> buffers_;
-    std::vector<field_metadata> fields_;
+    // Points into a resultset_metadata_storage. Shared, so objects
+    // referencing the metadata (e.g. lazy_row) can outlive the resultset
+    std::shared_ptr<const std::vector<field_metadata>> fields_;
+    std::shared_ptr<resultset_metadata_storage> storage_;
 public:
     resultset_metadata() = default;
-    resultset_metadata(std::vector<bytestring>&& buffers, std::vector<field_metadata>&& fields):
-        buffers_(std::move(buffers)), fields_(std::move(fields)) {};
+    inline resultset_metadata(std::vector<bytestring>&& buffers, std::vector<field_metadata>&& fields);
     resultset_metadata(const resultset_metadata&) = delete;
     resultset_metadata(resultset_metadata&&) = default;
     resultset_metadata& operator=(const resultset_metadata&) = delete;
     resultset_metadata& operator=(resultset_metadata&&) = default;
     ~resultset_metadata() = default;
-    const std::vector<field_metadata>& fields() const noexcept { return fields_; }
+    inline const std::vector<field_metadata>& fields() const noexcept;
+    const std::shared_ptr<const std::vector<field_metadata>>& shared_fields() const noexcept { return fields_; }
+    boost::optional<std::size_t> field_index(boost::string_view name, case_sensitivity cs) const;
+    bool field_index_built() const noexcept { return storage_ && storage_->index.built(); } // for tests
 };
 
 } // detail
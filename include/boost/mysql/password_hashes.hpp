@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_PASSWORD_HASHES_HPP
+#define BOOST_MYSQL_PASSWORD_HASHES_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <array>
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief Password hashes, precomputed to avoid hashing the password on every handshake.
+ * \details Authentication plugins don't send the password, but a hash of it, salted
+ * with a random challenge generated by the server. Part of this calculation only depends
+ * on the password, and can be done just once. Objects of this type hold the results
+ * of this calculation for both `mysql_native_password` and `caching_sha2_password`,
+ * and don't keep the password itself.
+ *
+ * Pass them to [refmem connection_params set_password_hashes]. A single object can be
+ * shared by any number of connections (e.g. all connections in a pool), as handshakes
+ * only read it.
+ */
+class password_hashes
+{
+public:
+    /// Type of `SHA1` hashes.
+    using sha1_type = std::array<std::uint8_t, 20>;
+
+    /// Type of `SHA256` hashes.
+    using sha256_type = std::array<std::uint8_t, 32>;
+
+    /// Default constructor. Constructs the hashes for an empty password.
+    password_hashes() noexcept = default;
+
+    /// Computes the hashes for `password`. `password` is not stored.
+    explicit inline password_hashes(boost::string_view password) noexcept;
+
+    /// Copy constructor.
+    password_hashes(const password_hashes&) = default;
+
+    /// Copy assignment.
+    password_hashes& operator=(const password_hashes&) = default;
+
+    /// Destructor. Overwrites the hashes, so they are not kept in memory.
+    inline ~password_hashes();
+
+    /// Returns whether these are the hashes of an empty password.
+    bool empty() const noexcept { return empty_; }
+
+    /// `SHA1(password)`, used by `mysql_native_password`.
+    const sha1_type& sha1() const noexcept { return sha1_; }
+
+    /// `SHA1(SHA1(password))`, used by `mysql_native_password`.
+    const sha1_type& double_sha1() const noexcept { return double_sha1_; }
+
+    /// `SHA256(password)`, used by `caching_sha2_password`.
+    const sha256_type& sha256() const noexcept { return sha256_; }
+
+    /// `SHA256(SHA256(password))`, used by `caching_sha2_password`.
+    const sha256_type& double_sha256() const noexcept { return double_sha256_; }
+private:
+    sha1_type sha1_ {};
+    sha1_type double_sha1_ {};
+    sha256_type sha256_ {};
+    sha256_type double_sha256_ {};
+    bool empty_ {true};
+};
+
+} // mysql
+} // boost
+
+#include <boost/mysql/impl/password_hashes.ipp>
+
+#endif
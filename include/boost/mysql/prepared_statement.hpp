@@ -15,7 +15,9 @@
 #include <boost/mysql/detail/auxiliar/value_type_traits.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
+#include <cstdint>
 #include <type_traits>
+#include <vector>
 
 namespace boost {
 namespace mysql {
@@ -47,6 +49,14 @@ class prepared_statement
 {
     detail::channel_observer_ptr<Stream> channel_;
     detail::com_stmt_prepare_ok_packet stmt_msg_;
+    std::vector<bool> long_data_params_; // params sent with send_long_data since the last execution
+
+    void mark_long_data(unsigned param_index)
+    {
+        if (long_data_params_.size() <= param_index)
+            long_data_params_.resize(param_index + 1);
+        long_data_params_[param_index] = true;
+    }
 
     template <class ValueForwardIterator>
     void check_num_params(ValueForwardIterator first, ValueForwardIterator last, error_code& err, error_info& info) const;
@@ -304,6 +314,177 @@ public:
         CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
     );
 
+    /**
+     * \brief Sends a chunk of data for a parameter before executing the statement
+     *        (sync with error code version).
+     * \details
+     * Use this function to send large string or blob parameters in pieces, without
+     * having to hold them in memory as a whole. The server appends each chunk
+     * to the value of parameter `param_index` (zero-based). You may call this function
+     * as many times as you need. The data is used by the next execution of the statement,
+     * and is then discarded by the server. When executing the statement, pass any
+     * value for parameters sent this way (e.g. `nullptr`): it will be ignored.
+     *
+     * The server does not reply to this message, so any error (e.g. the data
+     * exceeding `max_allowed_packet`) is reported by the next execution.
+     *
+     * `param_index` must be less than [refmem prepared_statement num_params].
+     */
+    void send_long_data(unsigned param_index, boost::asio::const_buffer data, error_code&, error_info&);
+
+    /**
+     * \brief Sends a chunk of data for a parameter before executing the statement
+     *        (sync with exceptions version).
+     * \details See [refmem prepared_statement send_long_data] for more info.
+     *
+     * `param_index` must be less than [refmem prepared_statement num_params].
+     */
+    void send_long_data(unsigned param_index, boost::asio::const_buffer data);
+
+    /**
+     * \brief Sends a chunk of data for a parameter before executing the statement
+     *        (async without [reflink error_info] version).
+     * \details See [refmem prepared_statement send_long_data] for more info.
+     *
+     * `param_index` must be less than [refmem prepared_statement num_params].
+     * The memory pointed to by `data` may be released or reused
+     * once the initiating function returns.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_send_long_data(
+        unsigned param_index,
+        boost::asio::const_buffer data,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        return async_send_long_data(param_index, data, shared_info(), std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Sends a chunk of data for a parameter before executing the statement
+     *        (async with [reflink error_info] version).
+     * \details See [refmem prepared_statement send_long_data] for more info.
+     *
+     * `param_index` must be less than [refmem prepared_statement num_params].
+     * The memory pointed to by `data` may be released or reused
+     * once the initiating function returns.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_send_long_data(
+        unsigned param_index,
+        boost::asio::const_buffer data,
+        error_info& output_info,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    );
+
+    /**
+     * \brief Executes a statement once per parameter set (sync with error code version).
+     * \details
+     * ParamSetCollection should be a collection (e.g. a `std::vector`) of
+     * [reflink ValueCollection]s, each containing the parameters for an execution.
+     *
+     * Executions are sent to the server in windows of several executions each.
+     * All the executions in a window are sent at once, and then their responses are read,
+     * so the batch takes a single round-trip per window. Statements are executed in order.
+     * If an execution fails, the remaining ones are still run, and the error
+     * of the first failed execution is reported. Rows generated by the statement, if any,
+     * are discarded.
+     *
+     * Returns the sum of the affected rows of all executions.
+     */
+    template <class ParamSetCollection>
+    std::uint64_t execute_many(const ParamSetCollection& param_sets, error_code&, error_info&);
+
+    /**
+     * \brief Executes a statement once per parameter set (sync with exceptions version).
+     * \details
+     * ParamSetCollection should be a collection (e.g. a `std::vector`) of
+     * [reflink ValueCollection]s, each containing the parameters for an execution.
+     *
+     * Executions are sent to the server in windows of several executions each.
+     * All the executions in a window are sent at once, and then their responses are read,
+     * so the batch takes a single round-trip per window. Statements are executed in order.
+     * If an execution fails, the remaining ones are still run, and the error
+     * of the first failed execution is reported. Rows generated by the statement, if any,
+     * are discarded.
+     *
+     * Returns the sum of the affected rows of all executions.
+     */
+    template <class ParamSetCollection>
+    std::uint64_t execute_many(const ParamSetCollection& param_sets);
+
+    /**
+     * \brief Executes a statement once per parameter set
+     *        (async without [reflink error_info] version).
+     * \details
+     * ParamSetCollection should be a collection (e.g. a `std::vector`) of
+     * [reflink ValueCollection]s, each containing the parameters for an execution.
+     * See [refmem prepared_statement execute_many] for more info.
+     *
+     * Parameter sets are serialized one window at a time, so you must keep the
+     * parameter sets and the values they may point to alive until the
+     * operation completes.
+     *
+     * The handler signature for this operation is
+     * `void(boost::mysql::error_code, std::uint64_t)`.
+     */
+    template <
+        class ParamSetCollection,
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, std::uint64_t))
+            CompletionToken
+            BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::uint64_t))
+    async_execute_many(
+        const ParamSetCollection& param_sets,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        return async_execute_many(param_sets, shared_info(), std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Executes a statement once per parameter set
+     *        (async with [reflink error_info] version).
+     * \details
+     * ParamSetCollection should be a collection (e.g. a `std::vector`) of
+     * [reflink ValueCollection]s, each containing the parameters for an execution.
+     * See [refmem prepared_statement execute_many] for more info.
+     *
+     * Parameter sets are serialized one window at a time, so you must keep the
+     * parameter sets and the values they may point to alive until the
+     * operation completes.
+     *
+     * The handler signature for this operation is
+     * `void(boost::mysql::error_code, std::uint64_t)`.
+     */
+    template <
+        class ParamSetCollection,
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, std::uint64_t))
+            CompletionToken
+            BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::uint64_t))
+    async_execute_many(
+        const ParamSetCollection& param_sets,
+        error_info& output_info,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    );
+
     /**
      * \brief Closes a prepared statement, deallocating it from the server
               (sync with error code version).
@@ -13,7 +13,8 @@
 #include <boost/mysql/detail/protocol/common_messages.hpp>
 #include <boost/mysql/detail/protocol/channel.hpp>
 #include <boost/mysql/detail/auxiliar/bytestring.hpp>
-#include <boost/mysql/detail/network_algorithms/common.hpp> // deserialize_row_fn
+#include <boost/mysql/detail/network_algorithms/common.hpp>
+#include <boost/mysql/detail/network_algorithms/read_row_streamed.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
 #include <cassert>
@@ -39,16 +40,16 @@ template <
 >
 class resultset
 {
-    detail::deserialize_row_fn deserializer_ {};
+    detail::resultset_encoding encoding_ {detail::resultset_encoding::text};
     detail::channel_observer_ptr<Stream> channel_;
     detail::resultset_metadata meta_;
     detail::bytestring ok_packet_buffer_;
     detail::ok_packet ok_packet_;
     bool eof_received_ {false};
+    detail::streamed_field_state streamed_;
 
-    error_info& shared_info() noexcept { assert(channel_); return channel_->shared_info(); }
-
-    struct read_one_op;
+    template <class RowType> struct read_one_op;
+    struct read_one_streamed_op;
     struct read_many_op;
     struct read_many_op_impl;
 
@@ -76,11 +77,34 @@ class resultset
 
     // Private, do not use
     resultset(detail::channel<Stream>& channel, detail::resultset_metadata&& meta,
-        detail::deserialize_row_fn deserializer):
-        deserializer_(deserializer), channel_(&channel), meta_(std::move(meta)) {};
+        detail::resultset_encoding encoding):
+        encoding_(encoding), channel_(&channel), meta_(std::move(meta)) {};
     resultset(detail::channel<Stream>& channel, detail::bytestring&& buffer,
         const detail::ok_packet& ok_pack):
         channel_(&channel), ok_packet_buffer_(std::move(buffer)), ok_packet_(ok_pack), eof_received_(true) {};
+
+    // Private, do not use. Used to read rows of the types declared
+    // in other headers (e.g. lazy_row.hpp), so this one doesn't depend on them.
+    // RowType must be supported by detail::read_row
+    error_info& shared_info() noexcept { assert(channel_); return channel_->shared_info(); }
+    const std::shared_ptr<const std::vector<field_metadata>>& shared_fields() const noexcept
+    {
+        return meta_.shared_fields();
+    }
+    template <class RowType>
+    bool read_one_generic(RowType& output, error_code& err, error_info& info);
+
+    // Must be preceded by a call to start_async_operation, which may be
+    // shared by several reads (e.g. when reading all rows)
+    void start_async_operation(error_info& output_info)
+    {
+        assert(valid());
+        output_info.clear();
+        channel_->start_deadline();
+    }
+    template <class RowType, class CompletionToken>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, bool))
+    async_read_one_generic(RowType& output, error_info& output_info, CompletionToken&& token);
 #endif
 
     /// The executor type associated to the object.
@@ -176,6 +200,134 @@ class resultset
         CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
     );
 
+    /**
+     * \brief Reads a single row, except for the contents of its last field,
+     *        which are to be streamed (sync with error code version).
+     * \details Use this function to read rows containing a huge string or blob value,
+     * without holding it in memory as a whole. The last field in the resultset
+     * must be a string, blob or a similar type. If the resultset
+     * was generated by a text query, any type is allowed, and its textual
+     * representation is streamed. Otherwise, the operation fails with
+     * [link mysql.ref.boost__mysql__errc `errc::field_not_streamable`].
+     *
+     * Returns `true` if a row was read successfully, `false` if
+     * there was an error or there were no more rows to read. On success, all the values
+     * in `output` but the last one are populated, as in [refmem resultset read_one].
+     * The last value is NULL if the field is NULL, and an empty string otherwise.
+     * Its contents should then be read, as they arrive from the server, by calling
+     * [refmem resultset read_streamed_chunk] until it returns zero.
+     * You must read the entire field before performing any other operation
+     * on the connection.
+     */
+    bool read_one_streamed(row& output, error_code& err, error_info& info);
+
+    /**
+     * \brief Reads a single row, except for the contents of its last field,
+     *        which are to be streamed (sync with exceptions version).
+     * \details See [refmem resultset read_one_streamed] for more info.
+     */
+    bool read_one_streamed(row& output);
+
+    /**
+     * \brief Reads a single row, except for the contents of its last field,
+     *        which are to be streamed (async without [reflink error_info] version).
+     * \details See [refmem resultset read_one_streamed] for more info.
+     *
+     * The handler signature for this operation is
+     * `void(boost::mysql::error_code, bool)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, bool))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, bool))
+    async_read_one_streamed(row& output, CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    {
+        return async_read_one_streamed(output, shared_info(), std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Reads a single row, except for the contents of its last field,
+     *        which are to be streamed (async with [reflink error_info] version).
+     * \details See [refmem resultset read_one_streamed] for more info.
+     *
+     * The handler signature for this operation is
+     * `void(boost::mysql::error_code, bool)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, bool))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, bool))
+    async_read_one_streamed(
+        row& output,
+        error_info& output_info,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    );
+
+    /**
+     * \brief Reads a piece of the field being streamed (sync with error code version).
+     * \details Reads up to `buffer.size()` bytes of the last field of the row
+     * read by [refmem resultset read_one_streamed] into `buffer`, and returns
+     * the number of bytes read. Returns zero once the entire field has been read.
+     * Bytes are read from the network as they arrive, so chunks may be smaller
+     * than `buffer.size()` even if the field has not been read completely.
+     * `buffer` must not be empty.
+     */
+    std::size_t read_streamed_chunk(boost::asio::mutable_buffer buffer, error_code& err, error_info& info);
+
+    /**
+     * \brief Reads a piece of the field being streamed (sync with exceptions version).
+     * \details See [refmem resultset read_streamed_chunk] for more info.
+     */
+    std::size_t read_streamed_chunk(boost::asio::mutable_buffer buffer);
+
+    /**
+     * \brief Reads a piece of the field being streamed
+     *        (async without [reflink error_info] version).
+     * \details See [refmem resultset read_streamed_chunk] for more info.
+     * `buffer` must be kept alive until the operation completes.
+     *
+     * The handler signature for this operation is
+     * `void(boost::mysql::error_code, std::size_t)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, std::size_t))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+    async_read_streamed_chunk(
+        boost::asio::mutable_buffer buffer,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        return async_read_streamed_chunk(buffer, shared_info(), std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Reads a piece of the field being streamed
+     *        (async with [reflink error_info] version).
+     * \details See [refmem resultset read_streamed_chunk] for more info.
+     * `buffer` must be kept alive until the operation completes.
+     *
+     * The handler signature for this operation is
+     * `void(boost::mysql::error_code, std::size_t)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, std::size_t))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+    async_read_streamed_chunk(
+        boost::asio::mutable_buffer buffer,
+        error_info& output_info,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    );
+
     /// Reads several rows, up to a maximum (sync with error code version).
     std::vector<row> read_many(std::size_t count, error_code& err, error_info& info);
 
@@ -281,6 +433,24 @@ class resultset
      */
     const std::vector<field_metadata>& fields() const noexcept { return meta_.fields(); }
 
+    /**
+     * \brief Returns the position of the field named `name`, if any.
+     * \details The returned index can be used with [refmem resultset fields] and
+     * to index the values of the rows read from this resultset. If several fields
+     * share the same name, returns the first one.
+     *
+     * Lookups are performed using a hash table, built the first time this function is called,
+     * making subsequent lookups O(1). This function is safe to call concurrently from several threads.
+     * Field names are compared as returned by the server (see [refmem field_metadata field_name]).
+     */
+    boost::optional<std::size_t> field_index(
+        boost::string_view name,
+        case_sensitivity cs = case_sensitivity::case_sensitive
+    ) const
+    {
+        return meta_.field_index(name, cs);
+    }
+
     /**
      * \brief The number of rows affected by the SQL that generated this resultset.
      * \details The resultset __must be [link mysql.resultsets.complete complete]__
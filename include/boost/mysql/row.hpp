@@ -12,11 +12,16 @@
 #include <boost/mysql/detail/auxiliar/container_equals.hpp>
 #include <boost/mysql/value.hpp>
 #include <boost/mysql/metadata.hpp>
+#include <boost/utility/string_view.hpp>
 #include <algorithm>
+#include <stdexcept>
 
 namespace boost {
 namespace mysql {
 
+template <class Stream>
+class resultset;
+
 /**
  * \brief Represents a row returned from a database operation.
  * \details A row is a collection of values, plus a buffer holding memory
@@ -60,6 +65,25 @@ public:
     /// Accessor for the sequence of values.
     std::vector<value>& values() noexcept { return values_; }
 
+    /**
+     * \brief Accesses a value by field name.
+     * \details `rs` must be the [reflink resultset] this row was read from.
+     * The name is looked up using [refmem resultset field_index].
+     * Throws `std::out_of_range` if the resultset has no field named `name`.
+     */
+    template <class Stream>
+    const value& at(
+        boost::string_view name,
+        const resultset<Stream>& rs,
+        case_sensitivity cs = case_sensitivity::case_sensitive
+    ) const
+    {
+        auto index = rs.field_index(name, cs);
+        if (!index || *index >= values_.size())
+            throw std::out_of_range("row::at: field not found");
+        return values_[*index];
+    }
+
     /**
      * \brief Clears the row object.
      * \details Clears the value array and the memory buffer associated to this row.
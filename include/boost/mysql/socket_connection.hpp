@@ -13,6 +13,8 @@
 #include <boost/mysql/error.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
+#include <boost/optional/optional.hpp>
+#include <chrono>
 #endif
 
 namespace boost {
@@ -45,6 +47,26 @@ public:
     /// The endpoint type associated to this connection.
     using endpoint_type = typename SocketStream::endpoint_type;
 
+    /**
+     * \brief Sets the timeout for async operations.
+     * \details Every async operation initiated after this call, in this connection and
+     * in the [reflink resultset]s and [reflink prepared_statement]s obtained from it,
+     * must complete within `value`. Otherwise, the underlying socket is closed and the
+     * operation fails with [link mysql.ref.boost__mysql__errc `errc::timeout`]. You
+     * must then re-establish the connection, as described in [link mysql.reconnecting this section].
+     *
+     * A zero timeout (the default) disables timeouts. In this case, no timers are involved.
+     * Sync operations are not affected by this setting, and have no deadline
+     * (see [link mysql.async.timeouts this section]).
+     */
+    void set_timeout(std::chrono::steady_clock::duration value)
+    {
+        this->get_channel().set_timeout(value, &close_on_timeout);
+    }
+
+    /// Returns the timeout for async operations, as set by [refmem socket_connection set_timeout].
+    std::chrono::steady_clock::duration timeout() const noexcept { return this->get_channel().timeout(); }
+
     /**
      * \brief Performs a connection to the MySQL server (sync with error code version).
      * \details Connects the underlying socket and then performs the handshake
@@ -128,6 +150,70 @@ public:
         CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
     );
 
+    /**
+     * \brief Performs the MySQL-level handshake (sync with error code version).
+     * \details Like [refmem connection handshake], but also records the remote endpoint
+     * of the underlying socket, to be used by [refmem socket_connection cancel_running_query].
+     * Prefer [refmem socket_connection connect] if possible.
+     */
+    void handshake(const connection_params& params, error_code& ec, error_info& info);
+
+    /**
+     * \brief Performs the MySQL-level handshake (sync with exceptions version).
+     * \details Like [refmem connection handshake], but also records the remote endpoint
+     * of the underlying socket, to be used by [refmem socket_connection cancel_running_query].
+     * Prefer [refmem socket_connection connect] if possible.
+     */
+    void handshake(const connection_params& params);
+
+    /**
+     * \brief Performs the MySQL-level handshake
+     *        (async without [reflink error_info] version).
+     * \details Like [refmem connection async_handshake], but also records the remote endpoint
+     * of the underlying socket, to be used by [refmem socket_connection cancel_running_query].
+     * Prefer [refmem socket_connection async_connect] if possible.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_handshake(
+        const connection_params& params,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        return async_handshake(params, this->shared_info(), std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Performs the MySQL-level handshake
+     *        (async with [reflink error_info] version).
+     * \details Like [refmem connection async_handshake], but also records the remote endpoint
+     * of the underlying socket, to be used by [refmem socket_connection cancel_running_query].
+     * Prefer [refmem socket_connection async_connect] if possible.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_handshake(
+        const connection_params& params,
+        error_info& output_info,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        record_peer_endpoint();
+        return connection<SocketStream>::async_handshake(params, output_info, std::forward<CompletionToken>(token));
+    }
+
     /**
      * \brief Closes the connection (sync with error code version).
      * \details Sends a quit request and closes the underlying socket.
@@ -178,6 +264,146 @@ public:
         CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
     );
 
+    /**
+     * \brief Cancels the query this connection is running (sync with error code version).
+     * \details Opens a separate control connection to the same server, using `params`,
+     * and issues a `KILL QUERY` statement with this connection's [refmem connection connection_id].
+     * The operation running on this connection then completes, usually with
+     * [link mysql.ref.boost__mysql__errc `errc::query_interrupted`], and the connection
+     * remains usable (including its prepared statements). This must be called while another
+     * thread or coroutine is waiting for that operation.
+     *
+     * The control connection connects to the endpoint recorded by the last
+     * [refmem socket_connection connect] or [refmem socket_connection handshake] call
+     * (or their async counterparts), so this function doesn't access the socket used
+     * by the running operation. If none of these functions was called (e.g. the handshake
+     * was performed through a reference to [reflink connection]), this function fails
+     * with `boost::asio::error::not_connected`. In this case, or to avoid opening a new
+     * connection for each cancellation, use the overload taking a control connection.
+     *
+     * The user in `params` must be the one running the query, or have the
+     * `CONNECTION_ADMIN` or `SUPER` privilege. If the query completes before the
+     * statement reaches the server, nothing is cancelled. Cancelling a query executed
+     * by a different connection is not possible, so make sure the connection
+     * isn't running a different operation by the time the statement reaches the server.
+     */
+    void cancel_running_query(const connection_params& params, error_code& ec, error_info& info);
+
+    /**
+     * \brief Cancels the query this connection is running (sync with exceptions version).
+     * \details See the error code version of this function for more info.
+     */
+    void cancel_running_query(const connection_params& params);
+
+    /**
+     * \brief Cancels the query this connection is running, using an existing control connection
+     *        (sync with error code version).
+     * \details Issues a `KILL QUERY` statement with this connection's [refmem connection connection_id]
+     * using `control`, which must be a different connection, already connected to the same server
+     * and not running any other operation. `control` is left open, and can be reused
+     * for later cancellations. See the overload taking a [reflink connection_params]
+     * for more info.
+     */
+    void cancel_running_query(socket_connection<SocketStream>& control, error_code& ec, error_info& info);
+
+    /**
+     * \brief Cancels the query this connection is running, using an existing control connection
+     *        (sync with exceptions version).
+     * \details See the error code version of this function for more info.
+     */
+    void cancel_running_query(socket_connection<SocketStream>& control);
+
+    /**
+     * \brief Cancels the query this connection is running
+     *        (async without [reflink error_info] version).
+     * \details See [refmem socket_connection cancel_running_query] for more info.
+     * The control connection uses the same executor and timeout as this connection.
+     *
+     * The strings pointed to by params should be kept alive by the caller
+     * until the operation completes, as no copy is made by the library.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_cancel_running_query(
+        const connection_params& params,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        // shared_info() may be in use by the operation being cancelled
+        return async_cancel_running_query_impl(params, nullptr, std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Cancels the query this connection is running
+     *        (async with [reflink error_info] version).
+     * \details See [refmem socket_connection cancel_running_query] for more info.
+     * The control connection uses the same executor and timeout as this connection.
+     *
+     * The strings pointed to by params should be kept alive by the caller
+     * until the operation completes, as no copy is made by the library.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_cancel_running_query(
+        const connection_params& params,
+        error_info& output_info,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    );
+
+    /**
+     * \brief Cancels the query this connection is running, using an existing control connection
+     *        (async without [reflink error_info] version).
+     * \details See [refmem socket_connection cancel_running_query] for more info.
+     * `control` must be kept alive until the operation completes.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_cancel_running_query(
+        socket_connection<SocketStream>& control,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        return async_cancel_running_query(control, control.shared_info(), std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Cancels the query this connection is running, using an existing control connection
+     *        (async with [reflink error_info] version).
+     * \details See [refmem socket_connection cancel_running_query] for more info.
+     * `control` must be kept alive until the operation completes.
+     *
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code))
+        CompletionToken
+        BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)
+    >
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_cancel_running_query(
+        socket_connection<SocketStream>& control,
+        error_info& output_info,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    );
+
     /// Rebinds the connection type to another executor.
     template <class Executor>
     struct rebind_executor
@@ -187,6 +413,32 @@ public:
             typename SocketStream:: template rebind_executor<Executor>::other
         >;
     };
+private:
+    // Set by connect and handshake, so cancel_running_query doesn't need
+    // to access the socket, which may be in use by another thread
+    boost::optional<endpoint_type> peer_endpoint_;
+
+    void record_peer_endpoint()
+    {
+        error_code err;
+        auto endpoint = this->next_layer().remote_endpoint(err);
+        if (err)
+            peer_endpoint_.reset();
+        else
+            peer_endpoint_ = endpoint;
+    }
+
+    struct cancel_running_query_op;
+
+    template <class CompletionToken>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_cancel_running_query_impl(
+        const connection_params& params,
+        error_info* output_info,
+        CompletionToken&& token
+    );
+
+    static void close_on_timeout(detail::channel<SocketStream>& chan) { chan.close(); }
 };
 
 /// A connection to MySQL over a TCP socket.
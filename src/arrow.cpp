@@ -0,0 +1,226 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/arrow.hpp>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using boost::mysql::column;
+using boost::mysql::column_type;
+
+// Owns the memory exported through a column's ArrowArray
+struct column_array_private
+{
+    column col;
+    std::array<const void*, 3> buffers {};
+
+    explicit column_array_private(column&& c): col(std::move(c)) {}
+};
+
+// Releases children that have not been moved by the consumer
+template <class T>
+void release_children(std::vector<T>& children)
+{
+    for (auto& child: children)
+    {
+        if (child.release)
+            child.release(&child);
+    }
+}
+
+// Owns the memory exported through the top-level (struct) ArrowArray
+struct batch_array_private
+{
+    std::array<const void*, 1> buffers {};
+    std::vector<ArrowArray> children;
+    std::vector<ArrowArray*> children_ptrs;
+
+    ~batch_array_private() { release_children(children); }
+};
+
+// Owns the memory exported through a column's ArrowSchema
+struct column_schema_private
+{
+    std::string name;
+
+    explicit column_schema_private(std::string n): name(std::move(n)) {}
+};
+
+// Owns the memory exported through the top-level (struct) ArrowSchema
+struct batch_schema_private
+{
+    std::vector<ArrowSchema> children;
+    std::vector<ArrowSchema*> children_ptrs;
+
+    ~batch_schema_private() { release_children(children); }
+};
+
+extern "C" {
+
+static void release_column_array(ArrowArray* arr)
+{
+    delete static_cast<column_array_private*>(arr->private_data);
+    arr->release = nullptr;
+}
+
+static void release_batch_array(ArrowArray* arr)
+{
+    delete static_cast<batch_array_private*>(arr->private_data);
+    arr->release = nullptr;
+}
+
+static void release_column_schema(ArrowSchema* schema)
+{
+    delete static_cast<column_schema_private*>(schema->private_data);
+    schema->release = nullptr;
+}
+
+static void release_batch_schema(ArrowSchema* schema)
+{
+    delete static_cast<batch_schema_private*>(schema->private_data);
+    schema->release = nullptr;
+}
+
+} // extern "C"
+
+const void* data_buffer(column& col)
+{
+    switch (col.type())
+    {
+    case column_type::int64:
+    case column_type::datetime:
+    case column_type::time:
+        return col.int64_buffer().data();
+    case column_type::uint64: return col.uint64_buffer().data();
+    case column_type::double_: return col.double_buffer().data();
+    case column_type::date: return col.date_buffer().data();
+    default: return col.string_buffer().data();
+    }
+}
+
+void export_column_array(column&& col, ArrowArray& out)
+{
+    std::unique_ptr<column_array_private> priv (new column_array_private(std::move(col)));
+    column& c = priv->col;
+    bool is_string = c.type() == column_type::string;
+    priv->buffers[0] = c.null_count() ? c.validity_buffer().data() : nullptr;
+    if (is_string)
+    {
+        priv->buffers[1] = c.offsets_buffer().data();
+        priv->buffers[2] = c.string_buffer().data();
+    }
+    else
+    {
+        priv->buffers[1] = data_buffer(c);
+    }
+
+    out.length = static_cast<int64_t>(c.size());
+    out.null_count = static_cast<int64_t>(c.null_count());
+    out.offset = 0;
+    out.n_buffers = is_string ? 3 : 2;
+    out.n_children = 0;
+    out.buffers = priv->buffers.data();
+    out.children = nullptr;
+    out.dictionary = nullptr;
+    out.release = &release_column_array;
+    out.private_data = priv.release();
+}
+
+void export_column_schema(const column& col, ArrowSchema& out)
+{
+    std::unique_ptr<column_schema_private> priv (new column_schema_private(col.name()));
+    out.format = boost::mysql::arrow_format(col);
+    out.name = priv->name.c_str();
+    out.metadata = nullptr;
+    out.flags = ARROW_FLAG_NULLABLE;
+    out.n_children = 0;
+    out.children = nullptr;
+    out.dictionary = nullptr;
+    out.release = &release_column_schema;
+    out.private_data = priv.release();
+}
+
+} // anon namespace
+
+const char* boost::mysql::arrow_format(
+    const column& col
+) noexcept
+{
+    switch (col.type())
+    {
+    case column_type::int64: return "l";
+    case column_type::uint64: return "L";
+    case column_type::double_: return "g";
+    case column_type::date: return "tdD";
+    case column_type::datetime: return "tsu:";
+    case column_type::time: return "tDu";
+    default: return col.is_binary() ? "Z" : "U";
+    }
+}
+
+void boost::mysql::export_arrow(
+    column_batch&& batch,
+    ArrowArray* out_array,
+    ArrowSchema* out_schema
+)
+{
+    auto& columns = batch.mutable_columns();
+    std::size_t num_columns = columns.size();
+
+    // Schema. If any allocation fails, the private structures
+    // release any children that have already been exported
+    std::unique_ptr<batch_schema_private> schema_priv (new batch_schema_private);
+    schema_priv->children.reserve(num_columns);
+    for (const auto& col: columns)
+    {
+        ArrowSchema child {};
+        export_column_schema(col, child);
+        schema_priv->children.push_back(child);
+    }
+
+    // Array
+    std::unique_ptr<batch_array_private> array_priv (new batch_array_private);
+    array_priv->children.reserve(num_columns);
+    for (auto& col: columns)
+    {
+        ArrowArray child {};
+        export_column_array(std::move(col), child);
+        array_priv->children.push_back(child);
+    }
+    for (std::size_t i = 0; i < num_columns; ++i)
+    {
+        schema_priv->children_ptrs.push_back(&schema_priv->children[i]);
+        array_priv->children_ptrs.push_back(&array_priv->children[i]);
+    }
+
+    out_schema->format = "+s";
+    out_schema->name = "";
+    out_schema->metadata = nullptr;
+    out_schema->flags = 0;
+    out_schema->n_children = static_cast<int64_t>(num_columns);
+    out_schema->children = schema_priv->children_ptrs.data();
+    out_schema->dictionary = nullptr;
+    out_schema->release = &release_batch_schema;
+    out_schema->private_data = schema_priv.release();
+
+    out_array->length = static_cast<int64_t>(batch.num_rows());
+    out_array->null_count = 0;
+    out_array->offset = 0;
+    out_array->n_buffers = 1;
+    out_array->n_children = static_cast<int64_t>(num_columns);
+    out_array->buffers = array_priv->buffers.data();
+    out_array->children = array_priv->children_ptrs.data();
+    out_array->dictionary = nullptr;
+    out_array->release = &release_batch_array;
+    out_array->private_data = array_priv.release();
+
+    batch.clear();
+}
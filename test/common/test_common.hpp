@@ -74,6 +74,29 @@ inline boost::string_view makesv(const std::uint8_t* value, std::size_t size)
 }
 
 
+inline field_metadata makemeta(
+    boost::string_view name,
+    detail::protocol_field_type type,
+    std::uint16_t flags = 0,
+    std::uint8_t decimals = 0,
+    collation coll = collation::utf8mb4_general_ci
+)
+{
+    return field_metadata(detail::column_definition_packet{
+        detail::string_lenenc("def"),
+        detail::string_lenenc("mydb"),
+        detail::string_lenenc("mytable"),
+        detail::string_lenenc("mytable"),
+        detail::string_lenenc(name),
+        detail::string_lenenc(name),
+        coll,
+        0,
+        type,
+        flags,
+        decimals
+    });
+}
+
 inline void validate_string_contains(
     std::string value,
     const std::vector<std::string>& to_check
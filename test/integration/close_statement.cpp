@@ -38,4 +38,44 @@ BOOST_MYSQL_NETWORK_TEST(existing_or_closed_statement, network_fixture, network_
     exec_result.validate_error(boost::mysql::errc::unknown_stmt_handler, {"unknown prepared statement"});
 }
 
+BOOST_MYSQL_NETWORK_TEST(deferred_close, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    this->conn.set_deferred_close(true);
+    auto* net = sample.net;
+
+    // Prepare a statement
+    auto stmt = net->prepare_statement(this->conn, "SELECT * FROM empty_table");
+    stmt.validate_no_error();
+
+    // Closing just queues the request
+    auto close_result = net->close_statement(stmt.value);
+    close_result.validate_no_error();
+    BOOST_TEST(this->conn.has_deferred_closes());
+
+    // The close request is written together with the next command
+    auto exec_result = net->execute_statement(stmt.value, {});
+    exec_result.validate_error(boost::mysql::errc::unknown_stmt_handler, {"unknown prepared statement"});
+    BOOST_TEST(!this->conn.has_deferred_closes());
+}
+
+BOOST_MYSQL_NETWORK_TEST(flush_deferred_closes, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    this->conn.set_deferred_close(true);
+    auto* net = sample.net;
+
+    auto stmt = net->prepare_statement(this->conn, "SELECT * FROM empty_table");
+    stmt.validate_no_error();
+    auto close_result = net->close_statement(stmt.value);
+    close_result.validate_no_error();
+
+    this->conn.flush_deferred_closes();
+    BOOST_TEST(!this->conn.has_deferred_closes());
+
+    this->conn.set_deferred_close(false);
+    auto exec_result = net->execute_statement(stmt.value, {});
+    exec_result.validate_error(boost::mysql::errc::unknown_stmt_handler, {"unknown prepared statement"});
+}
+
 BOOST_AUTO_TEST_SUITE_END() // test_close_statement
@@ -8,6 +8,7 @@
 -- System variables
 SET NAMES utf8;
 SET global max_connections = 10000;
+SET global local_infile = ON; -- allow LOAD DATA LOCAL INFILE
 SET session sql_mode = ''; -- allow zero and invalid dates
 
 START TRANSACTION;
@@ -144,13 +144,24 @@ BOOST_MYSQL_NETWORK_TEST(ssl_on_cache_miss, caching_sha2_fixture, network_gen)
 BOOST_MYSQL_NETWORK_TEST(ssl_off_cache_miss, caching_sha2_fixture, network_gen)
 {
     // A cache miss would force us send a plaintext password over
-    // a non-TLS connection, so we fail
+    // a non-TLS connection. We can't get the server public key
+    // securely, so we fail
     this->set_credentials("csha2p_user", "csha2p_password");
     this->clear_sha256_cache();
     auto result = do_handshake(this->conn, this->params, sample.net, ssl_mode::disable);
     result.validate_error(errc::auth_plugin_requires_ssl, {});
 }
 
+BOOST_MYSQL_NETWORK_TEST(ssl_off_cache_miss_request_public_key, caching_sha2_fixture, network_gen)
+{
+    // If explicitly allowed, the password is encrypted using
+    // the server RSA public key, requested to the server
+    this->set_credentials("csha2p_user", "csha2p_password");
+    this->params.set_request_server_public_key(true);
+    this->clear_sha256_cache();
+    do_handshake_ok(this->conn, this->params, sample.net, ssl_mode::disable);
+}
+
 BOOST_MYSQL_NETWORK_TEST(empty_password_ssl_on_cache_hit, caching_sha2_fixture, network_gen)
 {
     this->set_credentials("csha2p_empty_password_user", "");
@@ -318,4 +329,33 @@ BOOST_MYSQL_NETWORK_TEST(ssl_enable, handshake_fixture, network_gen)
     do_handshake_ok(this->conn, this->params, sample.net, ssl_mode::enable);
 }
 
+// COM_CHANGE_USER
+BOOST_AUTO_TEST_SUITE(change_user)
+
+BOOST_MYSQL_NETWORK_TEST(ok, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    this->conn.change_user(connection_params("mysqlnp_user", "mysqlnp_password", "boost_mysql_integtests"));
+    auto result = this->conn.query("SELECT SUBSTRING_INDEX(CURRENT_USER(), '@', 1)").read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == make_value_vector("mysqlnp_user"));
+
+    // Back to the original user
+    this->conn.change_user(this->params);
+    result = this->conn.query("SELECT SUBSTRING_INDEX(CURRENT_USER(), '@', 1)").read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == make_value_vector("integ_user"));
+}
+
+BOOST_MYSQL_NETWORK_TEST(bad_password, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    error_code err;
+    boost::mysql::error_info info;
+    this->conn.change_user(connection_params("mysqlnp_user", "bad_password"), err, info);
+    BOOST_TEST(err == make_error_code(errc::access_denied_error));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // change_user
+
 BOOST_AUTO_TEST_SUITE_END() // test_handshake
@@ -6,12 +6,31 @@
 //
 
 #include <boost/mysql/connection.hpp>
+#include <boost/mysql/format_sql.hpp>
+#include <boost/mysql/hedged_query.hpp>
+#include <boost/asio/use_future.hpp>
 #include "metadata_validator.hpp"
 #include "integration_test_common.hpp"
 #include "test_common.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 using namespace boost::mysql::test;
 using boost::mysql::errc;
+using boost::mysql::error_code;
+using boost::mysql::connection_params;
+using boost::mysql::socket_connection;
+using boost::mysql::ssl_mode;
+using boost::mysql::row;
+using boost::mysql::error_info;
 
 BOOST_AUTO_TEST_SUITE(test_query)
 
@@ -48,6 +67,218 @@ BOOST_MYSQL_NETWORK_TEST(insert_error, network_fixture, network_ssl_gen)
     BOOST_TEST(!result.value.valid());
 }
 
+BOOST_MYSQL_NETWORK_TEST(load_data_local_infile_ok, network_fixture, network_ssl_gen)
+{
+    std::string contents = "v0,2010-10-11\nv1,2010-10-12\n";
+    std::size_t offset = 0;
+    this->conn.set_local_infile_handler([&](
+        boost::string_view filename,
+        boost::asio::mutable_buffer buff,
+        boost::mysql::error_code&
+    ) {
+        BOOST_TEST(filename == "data.csv");
+        std::size_t size = (std::min)(buff.size(), contents.size() - offset);
+        std::memcpy(buff.data(), contents.data() + offset, size);
+        offset += size;
+        return size;
+    });
+    this->connect(sample.ssl);
+    this->start_transaction();
+
+    auto result = sample.net->query(this->conn,
+        "LOAD DATA LOCAL INFILE 'data.csv' INTO TABLE inserts_table "
+        "FIELDS TERMINATED BY ',' (field_varchar, field_date)");
+    result.validate_no_error();
+    BOOST_TEST(result.value.complete());
+    BOOST_TEST(result.value.affected_rows() == 2);
+    BOOST_TEST(this->get_table_size("inserts_table") == 2);
+}
+
+BOOST_MYSQL_NETWORK_TEST(load_data_local_infile_no_handler, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    this->start_transaction();
+    auto result = sample.net->query(this->conn,
+        "LOAD DATA LOCAL INFILE 'data.csv' INTO TABLE inserts_table");
+    result.validate_any_error();
+    BOOST_TEST(this->get_table_size("inserts_table") == 0);
+}
+
+BOOST_MYSQL_NETWORK_TEST(bulk_insert_ok, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    this->start_transaction();
+
+    // A small statement size forces splitting rows into several statements
+    std::vector<std::tuple<std::string, boost::mysql::date>> rows;
+    for (int i = 0; i < 50; ++i)
+        rows.emplace_back("it's \\ v" + std::to_string(i), makedate(2010, 10, 11));
+    auto num_rows = this->conn.bulk_insert(boost::mysql::make_bulk_insert_params(
+        "INSERT INTO inserts_table (field_varchar, field_date) VALUES ",
+        rows,
+        256
+    ));
+    BOOST_TEST(num_rows == 50u);
+    BOOST_TEST(this->get_table_size("inserts_table") == 50);
+
+    // Values are escaped properly
+    auto result = this->conn.query(
+        "SELECT field_varchar FROM inserts_table ORDER BY id LIMIT 1").read_all();
+    BOOST_TEST(result.at(0).values().at(0) == boost::mysql::value("it's \\ v0"));
+}
+
+BOOST_MYSQL_NETWORK_TEST(execute_many_ok, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    this->start_transaction();
+
+    auto stmt = this->conn.prepare_statement(
+        "INSERT INTO inserts_table (field_varchar, field_date) VALUES (?, ?)");
+    std::vector<std::vector<boost::mysql::value>> param_sets;
+    for (int i = 0; i < 20; ++i)
+        param_sets.push_back(make_value_vector("v" + std::to_string(i), makedate(2010, 10, 11)));
+    auto num_rows = stmt.execute_many(param_sets);
+    BOOST_TEST(num_rows == 20u);
+    BOOST_TEST(this->get_table_size("inserts_table") == 20);
+
+    // Executions after a failed one are still run, and the connection remains usable
+    param_sets = {
+        make_value_vector("ok", makedate(2010, 10, 11)),
+        make_value_vector("bad", "not_a_date"),
+        make_value_vector("ok", makedate(2010, 10, 11))
+    };
+    boost::mysql::error_code err;
+    boost::mysql::error_info info;
+    num_rows = stmt.execute_many(param_sets, err, info);
+    BOOST_TEST(err != boost::mysql::error_code());
+    BOOST_TEST(num_rows == 2u);
+    BOOST_TEST(this->get_table_size("inserts_table") == 22);
+}
+
+BOOST_MYSQL_NETWORK_TEST(send_long_data_ok, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    this->start_transaction();
+
+    auto stmt = this->conn.prepare_statement(
+        "INSERT INTO inserts_table (field_varchar, field_date) VALUES (?, ?)");
+    stmt.send_long_data(0, boost::asio::buffer("long ", 5));
+    stmt.send_long_data(0, boost::asio::buffer("data", 4));
+    stmt.execute(make_value_vector(nullptr, makedate(2010, 10, 11)));
+
+    // Long data is only used by one execution
+    stmt.execute(make_value_vector("regular", makedate(2010, 10, 11)));
+
+    auto result = this->conn.query(
+        "SELECT field_varchar FROM inserts_table ORDER BY id").read_all();
+    BOOST_TEST_REQUIRE(result.size() == 2u);
+    BOOST_TEST(result[0].values().at(0) == boost::mysql::value("long data"));
+    BOOST_TEST(result[1].values().at(0) == boost::mysql::value("regular"));
+}
+
+BOOST_MYSQL_NETWORK_TEST(read_one_streamed_ok, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+
+    auto result = this->conn.query("SELECT 42, REPEAT('abc', 100000)");
+    boost::mysql::row r;
+    BOOST_TEST_REQUIRE(result.read_one_streamed(r));
+    BOOST_TEST(r.values().at(0) == boost::mysql::value(42));
+
+    // Read the field in chunks, checking its contents
+    char buff [1000];
+    std::size_t total = 0;
+    bool contents_ok = true;
+    while (std::size_t size = result.read_streamed_chunk(boost::asio::buffer(buff)))
+    {
+        for (std::size_t i = 0; i < size; ++i)
+            contents_ok = contents_ok && buff[i] == "abc"[(total + i) % 3];
+        total += size;
+    }
+    BOOST_TEST(total == 300000u);
+    BOOST_TEST(contents_ok);
+
+    BOOST_TEST(!result.read_one_streamed(r));
+    BOOST_TEST(result.complete());
+}
+
+BOOST_MYSQL_NETWORK_TEST(execute_big_string_param, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+
+    // Big strings are sent from the caller's memory, without being copied
+    std::string big (100000, 'a');
+    auto stmt = this->conn.prepare_statement("SELECT LENGTH(?), ?");
+    auto result = stmt.execute(make_value_vector(big, "abc")).read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values().at(0) == boost::mysql::value(100000));
+    BOOST_TEST(result[0].values().at(1) == boost::mysql::value("abc"));
+}
+
+BOOST_MYSQL_NETWORK_TEST(format_sql_ok, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+
+    auto args = make_value_vector("it's", "back\\slash", boost::string_view("nul\0", 4), 42);
+    auto query = boost::mysql::format_sql(this->conn, "SELECT {}, {}, {}, {}", args);
+    auto result = this->conn.query(query).read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == args);
+
+    // The connection tracks the NO_BACKSLASH_ESCAPES SQL mode
+    this->conn.query("SET SESSION sql_mode = 'NO_BACKSLASH_ESCAPES'");
+    BOOST_TEST(!this->conn.format_opts().backslash_escapes());
+    query = boost::mysql::format_sql(this->conn, "SELECT {}, {}, {}, {}", args);
+    result = this->conn.query(query).read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == args);
+}
+
+BOOST_MYSQL_NETWORK_TEST(execute_once_ok, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+
+    auto result = this->conn.execute_once("SELECT ?, ?", make_value_vector(42, "abc")).read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == make_value_vector(42, "abc"));
+
+    // The connection remains usable afterwards
+    result = this->conn.execute_once("SELECT ?", make_value_vector(10)).read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == make_value_vector(10));
+}
+
+BOOST_MYSQL_NETWORK_TEST(execute_once_wrong_num_params, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+
+    boost::mysql::error_code err;
+    boost::mysql::error_info info;
+    this->conn.execute_once("SELECT ?, ?", make_value_vector(42), err, info);
+    BOOST_TEST(err != boost::mysql::error_code());
+
+    auto result = this->conn.query("SELECT 1").read_all();
+    BOOST_TEST(result.size() == 1u);
+}
+
+BOOST_MYSQL_NETWORK_TEST(execute_once_prepare_error, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+
+    // A statement prepared by the user before execute_once
+    auto stmt = this->conn.prepare_statement("SELECT ?");
+
+    boost::mysql::error_code err;
+    boost::mysql::error_info info;
+    this->conn.execute_once("SELECT * FROM bad_table WHERE id = ?", make_value_vector(42), err, info);
+    BOOST_TEST(err == errc::no_such_table);
+
+    // The failed execute_once must not have closed or executed the user's statement
+    auto result = stmt.execute(make_value_vector(10)).read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == make_value_vector(10));
+}
+
 BOOST_MYSQL_NETWORK_TEST(update_ok, network_fixture, network_ssl_gen)
 {
     this->connect(sample.ssl);
@@ -94,4 +325,173 @@ BOOST_MYSQL_NETWORK_TEST(select_error, network_fixture, network_ssl_gen)
     BOOST_TEST(!result.value.valid());
 }
 
+BOOST_AUTO_TEST_SUITE(cancel_running_query)
+
+BOOST_MYSQL_NETWORK_TEST(connection_id, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    auto result = this->conn.query("SELECT CONNECTION_ID()").read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == make_value_vector(std::uint64_t(this->conn.connection_id())));
+}
+
+BOOST_MYSQL_NETWORK_TEST(connection_remains_usable, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    auto start = std::chrono::steady_clock::now();
+    auto fut = this->conn.async_query("SELECT SLEEP(60)", boost::asio::use_future);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    this->conn.cancel_running_query(this->params);
+
+    // An interrupted SLEEP returns 1, rather than an error
+    auto result = fut.get().read_all();
+    BOOST_TEST((std::chrono::steady_clock::now() - start < std::chrono::seconds(30)));
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == make_value_vector(1));
+
+    // The connection can still be used
+    result = this->conn.query("SELECT 2").read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == make_value_vector(2));
+}
+
+BOOST_MYSQL_NETWORK_TEST(control_connection, network_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    socket_connection<Stream> control (this->ctx.get_executor());
+    control.connect(get_endpoint<Stream>(endpoint_kind::localhost), this->params);
+
+    auto fut = this->conn.async_query("SELECT SLEEP(60)", boost::asio::use_future);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    this->conn.cancel_running_query(control);
+    auto result = fut.get().read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == make_value_vector(1));
+
+    // The control connection is left open, and can be reused
+    fut = this->conn.async_query("SELECT SLEEP(60)", boost::asio::use_future);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    this->conn.async_cancel_running_query(control, boost::asio::use_future).get();
+    result = fut.get().read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == make_value_vector(1));
+    control.close();
+}
+
+BOOST_AUTO_TEST_SUITE_END() // cancel_running_query
+
+BOOST_AUTO_TEST_SUITE(hedged_query)
+
+template <class Stream>
+struct hedged_query_fixture : network_fixture<Stream>
+{
+    socket_connection<Stream> secondary;
+    std::promise<std::pair<error_code, error_code>> drained;
+
+    // Signals drained with the (query, cancellation) errors
+    std::function<void(error_code, error_code)> drain_handler()
+    {
+        return [this](error_code query_err, error_code cancel_err) {
+            drained.set_value(std::make_pair(query_err, cancel_err));
+        };
+    }
+
+    hedged_query_fixture() : secondary(this->ctx.get_executor())
+    {
+    }
+
+    void connect_secondary(ssl_mode m)
+    {
+        this->params.set_ssl(m);
+        secondary.connect(get_endpoint<Stream>(endpoint_kind::localhost), this->params);
+    }
+};
+
+BOOST_MYSQL_NETWORK_TEST(primary_responds_before_delay, hedged_query_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    this->connect_secondary(sample.ssl);
+    std::vector<row> rows;
+    error_info info;
+    auto winner = async_hedged_query(this->conn, this->secondary, "SELECT 1",
+        std::chrono::seconds(30), this->params, rows, info, this->drain_handler(),
+        boost::asio::use_future).get();
+    BOOST_TEST(winner == 0u);
+    BOOST_TEST_REQUIRE(rows.size() == 1u);
+    BOOST_TEST(rows[0].values() == make_value_vector(1));
+
+    // The secondary wasn't used, so there is nothing to report
+    auto drain_result = this->drained.get_future().get();
+    BOOST_TEST(drain_result.first == error_code());
+    BOOST_TEST(drain_result.second == error_code());
+}
+
+BOOST_MYSQL_NETWORK_TEST(secondary_responds_first, hedged_query_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    this->connect_secondary(sample.ssl);
+
+    // GET_LOCK succeeds straight away on the connection holding the lock,
+    // and blocks on the other one
+    this->conn.query("SELECT GET_LOCK('hedged_query_test', 0)").read_all();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<row> rows;
+    auto winner = async_hedged_query(
+        this->secondary, // blocks
+        this->conn,      // holds the lock
+        "SELECT GET_LOCK('hedged_query_test', 60)",
+        std::chrono::milliseconds(100),
+        this->params,
+        rows,
+        this->drain_handler(),
+        boost::asio::use_future
+    ).get();
+    BOOST_TEST(winner == 1u);
+    BOOST_TEST((std::chrono::steady_clock::now() - start < std::chrono::seconds(30)));
+    BOOST_TEST_REQUIRE(rows.size() == 1u);
+    BOOST_TEST(rows[0].values() == make_value_vector(1));
+
+    // The query on the other connection is cancelled in the background.
+    // An interrupted GET_LOCK returns NULL, rather than an error
+    auto drain_result = this->drained.get_future().get();
+    BOOST_TEST(drain_result.second == error_code());
+    BOOST_TEST((std::chrono::steady_clock::now() - start < std::chrono::seconds(30)));
+
+    // Both connections can still be used
+    this->conn.query("SELECT RELEASE_ALL_LOCKS()").read_all();
+    auto result = this->secondary.query("SELECT 2").read_all();
+    BOOST_TEST_REQUIRE(result.size() == 1u);
+    BOOST_TEST(result[0].values() == make_value_vector(2));
+}
+
+BOOST_MYSQL_NETWORK_TEST(cancel_error_reported, hedged_query_fixture, network_ssl_gen)
+{
+    this->connect(sample.ssl);
+    this->connect_secondary(sample.ssl);
+    this->conn.query("SELECT GET_LOCK('hedged_query_test', 0)").read_all();
+
+    // The KILL QUERY fails, so the blocked query runs to completion
+    connection_params bad_params (this->params);
+    bad_params.set_password("bad_password");
+    std::vector<row> rows;
+    auto winner = async_hedged_query(
+        this->secondary, // blocks
+        this->conn,      // holds the lock
+        "SELECT GET_LOCK('hedged_query_test', 1)",
+        std::chrono::milliseconds(100),
+        bad_params,
+        rows,
+        this->drain_handler(),
+        boost::asio::use_future
+    ).get();
+    BOOST_TEST(winner == 1u);
+    auto drain_result = this->drained.get_future().get();
+    BOOST_TEST(drain_result.first == error_code());
+    BOOST_TEST(drain_result.second != error_code());
+    this->conn.query("SELECT RELEASE_ALL_LOCKS()").read_all();
+}
+
+BOOST_AUTO_TEST_SUITE_END() // hedged_query
+
 BOOST_AUTO_TEST_SUITE_END() // test_query
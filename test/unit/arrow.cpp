@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/arrow.hpp>
+#include "test_common.hpp"
+#include <boost/test/unit_test_suite.hpp>
+#include <cstring>
+
+using namespace boost::mysql::test;
+using boost::mysql::column_batch;
+using boost::mysql::field_metadata;
+using boost::mysql::collation;
+using boost::mysql::export_arrow;
+using boost::mysql::detail::protocol_field_type;
+namespace column_flags = boost::mysql::detail::column_flags;
+
+BOOST_AUTO_TEST_SUITE(test_arrow)
+
+static column_batch make_batch()
+{
+    std::vector<field_metadata> fields {
+        makemeta("id", protocol_field_type::longlong),
+        makemeta("name", protocol_field_type::var_string),
+        makemeta("data", protocol_field_type::blob, column_flags::binary, 0, collation::binary),
+        makemeta("d", protocol_field_type::date),
+        makemeta("dt", protocol_field_type::datetime),
+        makemeta("t", protocol_field_type::time),
+        makemeta("u", protocol_field_type::long_, column_flags::unsigned_),
+        makemeta("f", protocol_field_type::double_),
+    };
+    column_batch res;
+    res.reset(fields);
+    BOOST_TEST_REQUIRE(!res.append_row(make_value_vector(
+        1, "abc", "\1\2", makedate(2020, 1, 1), makedt(2020, 1, 1), maket(1, 0, 0), 2u, 4.2)));
+    BOOST_TEST_REQUIRE(!res.append_row(make_value_vector(
+        nullptr, "de", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr)));
+    return res;
+}
+
+BOOST_AUTO_TEST_CASE(schema)
+{
+    auto batch = make_batch();
+    ArrowArray arr;
+    ArrowSchema schema;
+    export_arrow(std::move(batch), &arr, &schema);
+
+    BOOST_TEST(std::strcmp(schema.format, "+s") == 0);
+    BOOST_TEST_REQUIRE(schema.n_children == 8);
+    const char* expected_formats [] = { "l", "U", "Z", "tdD", "tsu:", "tDu", "L", "g" };
+    const char* expected_names [] = { "id", "name", "data", "d", "dt", "t", "u", "f" };
+    for (int i = 0; i < 8; ++i)
+    {
+        BOOST_TEST(std::strcmp(schema.children[i]->format, expected_formats[i]) == 0);
+        BOOST_TEST(std::strcmp(schema.children[i]->name, expected_names[i]) == 0);
+        BOOST_TEST(schema.children[i]->flags == ARROW_FLAG_NULLABLE);
+        BOOST_TEST(schema.children[i]->release != nullptr);
+    }
+
+    schema.release(&schema);
+    BOOST_TEST(schema.release == nullptr);
+    arr.release(&arr);
+    BOOST_TEST(arr.release == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(array)
+{
+    auto batch = make_batch();
+    const void* int_buffer = batch[0].int64_values().data();
+    const void* string_buffer = batch[1].string_data().data();
+    ArrowArray arr;
+    ArrowSchema schema;
+    export_arrow(std::move(batch), &arr, &schema);
+
+    BOOST_TEST(batch.columns().empty());
+    BOOST_TEST(batch.num_rows() == 0u);
+
+    BOOST_TEST(arr.length == 2);
+    BOOST_TEST(arr.null_count == 0);
+    BOOST_TEST(arr.n_buffers == 1);
+    BOOST_TEST_REQUIRE(arr.n_children == 8);
+
+    // Integer column: buffers are transferred, not copied
+    const ArrowArray& ints = *arr.children[0];
+    BOOST_TEST(ints.length == 2);
+    BOOST_TEST(ints.null_count == 1);
+    BOOST_TEST(ints.n_buffers == 2);
+    BOOST_TEST(static_cast<const std::uint8_t*>(ints.buffers[0])[0] == 0x01);
+    BOOST_TEST(ints.buffers[1] == int_buffer);
+    BOOST_TEST(static_cast<const std::int64_t*>(ints.buffers[1])[0] == 1);
+
+    // String column without NULLs: no validity buffer
+    const ArrowArray& strings = *arr.children[1];
+    BOOST_TEST(strings.length == 2);
+    BOOST_TEST(strings.null_count == 0);
+    BOOST_TEST(strings.n_buffers == 3);
+    BOOST_TEST(strings.buffers[0] == nullptr);
+    const auto* offsets = static_cast<const std::int64_t*>(strings.buffers[1]);
+    BOOST_TEST(offsets[0] == 0);
+    BOOST_TEST(offsets[1] == 3);
+    BOOST_TEST(offsets[2] == 5);
+    BOOST_TEST(strings.buffers[2] == string_buffer);
+    BOOST_TEST(std::memcmp(strings.buffers[2], "abcde", 5) == 0);
+
+    // Date column
+    const ArrowArray& dates = *arr.children[3];
+    BOOST_TEST(static_cast<const std::int32_t*>(dates.buffers[1])[0] ==
+        makedate(2020, 1, 1).time_since_epoch().count());
+
+    arr.release(&arr);
+    schema.release(&schema);
+}
+
+BOOST_AUTO_TEST_CASE(child_moved_by_consumer)
+{
+    ArrowArray arr;
+    ArrowSchema schema;
+    export_arrow(make_batch(), &arr, &schema);
+
+    // Consumers may move children out of their parent, setting the original's release to null
+    ArrowArray moved = *arr.children[1];
+    arr.children[1]->release = nullptr;
+    arr.release(&arr);
+    BOOST_TEST(std::memcmp(moved.buffers[2], "abcde", 5) == 0);
+    moved.release(&moved);
+    BOOST_TEST(moved.release == nullptr);
+    schema.release(&schema);
+}
+
+BOOST_AUTO_TEST_CASE(empty_batch)
+{
+    ArrowArray arr;
+    ArrowSchema schema;
+    export_arrow(column_batch(), &arr, &schema);
+    BOOST_TEST(arr.length == 0);
+    BOOST_TEST(arr.n_children == 0);
+    BOOST_TEST(schema.n_children == 0);
+    arr.release(&arr);
+    schema.release(&schema);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_arrow
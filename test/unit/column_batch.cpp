@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/column_batch.hpp>
+#include "test_common.hpp"
+#include <boost/test/unit_test_suite.hpp>
+
+using namespace boost::mysql::test;
+using boost::mysql::column_batch;
+using boost::mysql::column_type;
+using boost::mysql::field_metadata;
+using boost::mysql::value;
+using boost::mysql::errc;
+using boost::mysql::collation;
+using boost::mysql::detail::protocol_field_type;
+namespace column_flags = boost::mysql::detail::column_flags;
+
+BOOST_AUTO_TEST_SUITE(test_column_batch)
+
+BOOST_AUTO_TEST_CASE(reset_computes_column_types)
+{
+    std::vector<field_metadata> fields {
+        makemeta("f0", protocol_field_type::long_),
+        makemeta("f1", protocol_field_type::longlong, column_flags::unsigned_),
+        makemeta("f2", protocol_field_type::year, column_flags::unsigned_),
+        makemeta("f3", protocol_field_type::bit, column_flags::unsigned_),
+        makemeta("f4", protocol_field_type::float_),
+        makemeta("f5", protocol_field_type::double_),
+        makemeta("f6", protocol_field_type::date),
+        makemeta("f7", protocol_field_type::timestamp),
+        makemeta("f8", protocol_field_type::time),
+        makemeta("f9", protocol_field_type::var_string),
+        makemeta("f10", protocol_field_type::blob, column_flags::binary, 0, collation::binary),
+        makemeta("f11", protocol_field_type::newdecimal),
+    };
+    column_batch batch;
+    batch.reset(fields);
+
+    BOOST_TEST_REQUIRE(batch.columns().size() == 12u);
+    BOOST_TEST(batch.num_rows() == 0u);
+    BOOST_TEST(batch[0].name() == "f0");
+    BOOST_TEST(batch[0].type() == column_type::int64);
+    BOOST_TEST(batch[1].type() == column_type::uint64);
+    BOOST_TEST(batch[2].type() == column_type::uint64);
+    BOOST_TEST(batch[3].type() == column_type::uint64);
+    BOOST_TEST(batch[4].type() == column_type::double_);
+    BOOST_TEST(batch[5].type() == column_type::double_);
+    BOOST_TEST(batch[6].type() == column_type::date);
+    BOOST_TEST(batch[7].type() == column_type::datetime);
+    BOOST_TEST(batch[8].type() == column_type::time);
+    BOOST_TEST(batch[9].type() == column_type::string);
+    BOOST_TEST(!batch[9].is_binary());
+    BOOST_TEST(batch[10].type() == column_type::string);
+    BOOST_TEST(batch[10].is_binary());
+    BOOST_TEST(batch[11].type() == column_type::string);
+    BOOST_TEST(!batch[11].is_binary());
+}
+
+BOOST_AUTO_TEST_CASE(append_rows_fixed_size)
+{
+    std::vector<field_metadata> fields {
+        makemeta("i", protocol_field_type::long_),
+        makemeta("u", protocol_field_type::long_, column_flags::unsigned_),
+        makemeta("f", protocol_field_type::float_),
+        makemeta("d", protocol_field_type::date),
+        makemeta("dt", protocol_field_type::datetime),
+        makemeta("t", protocol_field_type::time),
+    };
+    column_batch batch;
+    batch.reset(fields);
+
+    auto err = batch.append_row(make_value_vector(
+        std::int64_t(-1), std::uint64_t(2), 4.2f, makedate(2020, 1, 2),
+        makedt(2020, 1, 2, 10, 20, 30, 40), maket(1, 2, 3)));
+    BOOST_TEST(!err);
+    err = batch.append_row(make_value_vector(
+        nullptr, nullptr, nullptr, nullptr, nullptr, nullptr));
+    BOOST_TEST(!err);
+
+    BOOST_TEST(batch.num_rows() == 2u);
+    for (const auto& col: batch.columns())
+    {
+        BOOST_TEST(col.size() == 2u);
+        BOOST_TEST(col.null_count() == 1u);
+        BOOST_TEST(!col.is_null(0));
+        BOOST_TEST(col.is_null(1));
+        BOOST_TEST(col.validity() == std::vector<std::uint8_t>{0x01});
+        BOOST_TEST(col.at(1) == value(nullptr));
+    }
+    BOOST_TEST(batch[0].int64_values() == (std::vector<std::int64_t>{-1, 0}));
+    BOOST_TEST(batch[1].uint64_values() == (std::vector<std::uint64_t>{2, 0}));
+    BOOST_TEST(batch[2].double_values().at(0) == double(4.2f));
+    BOOST_TEST(batch[3].date_values().at(0) == makedate(2020, 1, 2).time_since_epoch().count());
+    BOOST_TEST(batch[4].int64_values().at(0) == makedt(2020, 1, 2, 10, 20, 30, 40).time_since_epoch().count());
+    BOOST_TEST(batch[5].int64_values().at(0) == maket(1, 2, 3).count());
+
+    BOOST_TEST(batch[0].at(0) == value(-1));
+    BOOST_TEST(batch[1].at(0) == value(2u));
+    BOOST_TEST(batch[2].at(0) == value(double(4.2f)));
+    BOOST_TEST(batch[3].at(0) == value(makedate(2020, 1, 2)));
+    BOOST_TEST(batch[4].at(0) == value(makedt(2020, 1, 2, 10, 20, 30, 40)));
+    BOOST_TEST(batch[5].at(0) == value(maket(1, 2, 3)));
+}
+
+BOOST_AUTO_TEST_CASE(append_rows_string)
+{
+    std::vector<field_metadata> fields { makemeta("s", protocol_field_type::var_string) };
+    column_batch batch;
+    batch.reset(fields);
+
+    BOOST_TEST(!batch.append_row(make_value_vector("abc")));
+    BOOST_TEST(!batch.append_row(make_value_vector(nullptr)));
+    BOOST_TEST(!batch.append_row(make_value_vector("")));
+    BOOST_TEST(!batch.append_row(make_value_vector("de")));
+
+    const auto& col = batch[0];
+    BOOST_TEST(col.size() == 4u);
+    BOOST_TEST(col.null_count() == 1u);
+    BOOST_TEST(col.validity() == std::vector<std::uint8_t>{0x0d});
+    BOOST_TEST(col.string_offsets() == (std::vector<std::int64_t>{0, 3, 3, 3, 5}));
+    BOOST_TEST(std::string(col.string_data().begin(), col.string_data().end()) == "abcde");
+    BOOST_TEST(col.at(0) == value("abc"));
+    BOOST_TEST(col.at(1) == value(nullptr));
+    BOOST_TEST(col.at(2) == value(""));
+    BOOST_TEST(col.at(3) == value("de"));
+}
+
+BOOST_AUTO_TEST_CASE(validity_bitmap_spans_several_bytes)
+{
+    std::vector<field_metadata> fields { makemeta("i", protocol_field_type::longlong) };
+    column_batch batch;
+    batch.reset(fields);
+    for (int i = 0; i < 10; ++i)
+    {
+        auto err = i % 3 ? batch.append_row(make_value_vector(i)) : batch.append_row(make_value_vector(nullptr));
+        BOOST_TEST(!err);
+    }
+    // nulls at 0, 3, 6, 9
+    BOOST_TEST(batch[0].validity() == (std::vector<std::uint8_t>{0xb6, 0x01}));
+    BOOST_TEST(batch[0].null_count() == 4u);
+}
+
+BOOST_AUTO_TEST_CASE(type_mismatch)
+{
+    std::vector<field_metadata> fields { makemeta("i", protocol_field_type::longlong) };
+    column_batch batch;
+    batch.reset(fields);
+    auto err = batch.append_row(make_value_vector("not an int"));
+    BOOST_TEST(err == make_error_code(errc::protocol_value_error));
+}
+
+BOOST_AUTO_TEST_CASE(reset_clears_previous_contents)
+{
+    std::vector<field_metadata> fields { makemeta("s", protocol_field_type::var_string) };
+    column_batch batch;
+    batch.reset(fields);
+    BOOST_TEST(!batch.append_row(make_value_vector("abc")));
+    batch.reset(fields);
+    BOOST_TEST(batch.num_rows() == 0u);
+    BOOST_TEST(batch[0].size() == 0u);
+    BOOST_TEST(batch[0].validity().empty());
+    BOOST_TEST(batch[0].string_offsets() == std::vector<std::int64_t>{0});
+    BOOST_TEST(batch[0].string_data().empty());
+}
+
+BOOST_AUTO_TEST_CASE(clear)
+{
+    std::vector<field_metadata> fields { makemeta("s", protocol_field_type::var_string) };
+    column_batch batch;
+    batch.reset(fields);
+    BOOST_TEST(!batch.append_row(make_value_vector("abc")));
+    batch.clear();
+    BOOST_TEST(batch.num_rows() == 0u);
+    BOOST_TEST(batch.columns().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_column_batch
@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/compact_row.hpp>
+#include "test_common.hpp"
+#include <boost/test/unit_test_suite.hpp>
+#include <sstream>
+#include <stdexcept>
+
+using namespace boost::mysql::test;
+using boost::mysql::compact_row;
+using boost::mysql::row;
+using boost::mysql::value;
+using boost::mysql::detail::bytestring;
+
+BOOST_AUTO_TEST_SUITE(test_compact_row)
+
+BOOST_AUTO_TEST_CASE(default_ctor)
+{
+    compact_row r;
+    BOOST_TEST(r.size() == 0u);
+    BOOST_TEST(r.empty());
+    BOOST_TEST(r.values().empty());
+}
+
+BOOST_AUTO_TEST_CASE(all_types)
+{
+    auto values = make_value_vector(
+        nullptr,
+        std::int64_t(-42),
+        std::uint64_t(0xffffffffffffffff),
+        "a_string",
+        "",
+        4.2f,
+        8.1,
+        makedate(2020, 2, 19),
+        makedt(2020, 2, 19, 10, 20, 30, 123456),
+        -maket(838, 59, 59)
+    );
+    compact_row r (values);
+    BOOST_TEST(r.size() == values.size());
+    BOOST_TEST(!r.empty());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        BOOST_TEST_CONTEXT(i)
+        {
+            BOOST_TEST(r[i] == values[i]);
+            BOOST_TEST(r.at(i) == values[i]);
+        }
+    }
+    BOOST_TEST(r.values() == values);
+}
+
+BOOST_AUTO_TEST_CASE(from_row)
+{
+    // The compact row doesn't keep any reference to the original row
+    bytestring buffer {'a', 'b', 'c', 'd'};
+    auto values = make_value_vector(
+        boost::string_view(reinterpret_cast<const char*>(buffer.data()), 2),
+        10,
+        boost::string_view(reinterpret_cast<const char*>(buffer.data()) + 2, 2)
+    );
+    compact_row r;
+    {
+        row original (std::move(values), std::move(buffer));
+        r = compact_row(original);
+    }
+    BOOST_TEST(r.values() == make_value_vector("ab", 10, "cd"));
+}
+
+BOOST_AUTO_TEST_CASE(copy)
+{
+    // Strings are stored as offsets, so copies are independent
+    compact_row r (make_value_vector("abc", 42, "def"));
+    compact_row r2 (r);
+    r = compact_row(make_value_vector("xyz"));
+    BOOST_TEST(r2.values() == make_value_vector("abc", 42, "def"));
+    r = r2;
+    r2.clear();
+    BOOST_TEST(r.values() == make_value_vector("abc", 42, "def"));
+}
+
+BOOST_AUTO_TEST_CASE(at_out_of_range)
+{
+    compact_row r (make_value_vector(42));
+    BOOST_CHECK_THROW(r.at(1), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(clear)
+{
+    compact_row r (make_value_vector(42, "abc"));
+    r.clear();
+    BOOST_TEST(r.empty());
+    BOOST_TEST(r.values().empty());
+}
+
+BOOST_AUTO_TEST_CASE(operator_equals)
+{
+    BOOST_TEST(compact_row() == compact_row());
+    BOOST_TEST(compact_row(make_value_vector(1, "a")) == compact_row(make_value_vector(1, "a")));
+    BOOST_TEST(compact_row(make_value_vector(1, "a")) != compact_row(make_value_vector(1, "b")));
+    BOOST_TEST(compact_row(make_value_vector(1, "a")) != compact_row(make_value_vector(1)));
+    BOOST_TEST(compact_row(make_value_vector(1)) != compact_row(make_value_vector(1u)));
+}
+
+BOOST_AUTO_TEST_CASE(operator_stream)
+{
+    std::ostringstream ss;
+    ss << compact_row(make_value_vector(nullptr, 42, "abc"));
+    BOOST_TEST(ss.str() == "{<NULL>, 42, abc}");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_compact_row
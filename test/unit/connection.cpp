@@ -80,6 +80,24 @@ BOOST_AUTO_TEST_CASE(move_assign_valid_to_valid)
     BOOST_TEST(!c2.valid());
 }
 
+// local infile handler
+BOOST_AUTO_TEST_CASE(set_local_infile_handler)
+{
+    conn_t c;
+    BOOST_TEST(!c.get_local_infile_handler());
+    c.set_local_infile_handler([](boost::string_view, boost::asio::mutable_buffer, boost::mysql::error_code&) {
+        return std::size_t(0);
+    });
+    BOOST_TEST(static_cast<bool>(c.get_local_infile_handler()));
+
+    // Kept when moving the connection
+    conn_t c2 (std::move(c));
+    BOOST_TEST(static_cast<bool>(c2.get_local_infile_handler()));
+
+    c2.set_local_infile_handler(boost::mysql::local_infile_handler());
+    BOOST_TEST(!c2.get_local_infile_handler());
+}
+
 using other_executor = boost::asio::strand<boost::asio::io_context::executor_type>;
 
 BOOST_AUTO_TEST_CASE(connection_rebind_executor)
@@ -0,0 +1,207 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/experimental/connection_engine.hpp>
+#include "test_common.hpp"
+
+using namespace boost::mysql::test;
+using boost::mysql::experimental::connection_engine;
+using boost::mysql::connection_params;
+using boost::mysql::error_code;
+using boost::mysql::errc;
+using boost::mysql::ssl_mode;
+using boost::mysql::detail::bytestring;
+using event = connection_engine::event;
+
+namespace
+{
+
+// Server greeting, without TLS support. Challenge is "abcdefghijklmnopqrst"
+const bytestring greeting {
+    0x0a, '5', '.', '7', '.', '0', 0x00, // protocol version, server version
+    0x01, 0x00, 0x00, 0x00, // connection id
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 0x00, // challenge (1), filler
+    0x00, 0x82, 0x21, 0x02, 0x00, 0x28, 0x01, // capabilities (low), collation, status, capabilities (high)
+    21, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // challenge length, reserved
+    'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 0x00, // challenge (2)
+    'm', 'y', 's', 'q', 'l', '_', 'n', 'a', 't', 'i', 'v', 'e', '_',
+    'p', 'a', 's', 's', 'w', 'o', 'r', 'd', 0x00 // plugin name
+};
+
+// id INT field
+const bytestring field_definition {
+    0x03, 0x64, 0x65, 0x66, 0x07, 0x61, 0x77, 0x65,
+    0x73, 0x6f, 0x6d, 0x65, 0x0a, 0x74, 0x65, 0x73,
+    0x74, 0x5f, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x0a,
+    0x74, 0x65, 0x73, 0x74, 0x5f, 0x74, 0x61, 0x62,
+    0x6c, 0x65, 0x02, 0x69, 0x64, 0x02, 0x69, 0x64,
+    0x0c, 0x3f, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x03,
+    0x03, 0x42, 0x00, 0x00, 0x00
+};
+
+const bytestring ok_packet { 0x00, 0x02, 0x05, 0x02, 0x00, 0x00, 0x00 };
+const bytestring eof_packet { 0xfe, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00 };
+const bytestring error_packet { 0xff, 0x7a, 0x04, '#', '4', '2', '0', '0', '0', 'b', 'a', 'd' };
+
+bytestring framed(const bytestring& message, std::uint8_t seqnum)
+{
+    bytestring res;
+    boost::mysql::detail::frame_message(boost::asio::buffer(message), seqnum, res);
+    return res;
+}
+
+bytestring to_bytes(boost::asio::const_buffer buff)
+{
+    auto first = static_cast<const std::uint8_t*>(buff.data());
+    return bytestring(first, first + buff.size());
+}
+
+struct fixture
+{
+    connection_params params {"user", "pass", "", boost::mysql::collation::utf8_general_ci, ssl_mode::enable};
+    connection_engine engine {params};
+
+    // Writes everything the engine has to write
+    bytestring write()
+    {
+        BOOST_TEST_REQUIRE((engine.next_event() == event::write));
+        auto res = to_bytes(engine.output());
+        engine.consume_output(res.size());
+        return res;
+    }
+
+    void handshake()
+    {
+        BOOST_TEST_REQUIRE((engine.next_event() == event::need_input));
+        engine.feed(boost::asio::buffer(framed(greeting, 0)));
+        write();
+        engine.feed(boost::asio::buffer(framed(ok_packet, 2)));
+        BOOST_TEST_REQUIRE((engine.next_event() == event::done));
+        BOOST_TEST_REQUIRE(engine.ready());
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(test_connection_engine)
+
+BOOST_FIXTURE_TEST_CASE(handshake_ok, fixture)
+{
+    BOOST_TEST(!engine.ready());
+    BOOST_TEST((engine.next_event() == event::need_input));
+    engine.feed(boost::asio::buffer(framed(greeting, 0)));
+
+    // Same response as the one sent by connection
+    connection_params expected_params (params);
+    expected_params.set_ssl(ssl_mode::disable);
+    boost::mysql::detail::handshake_processor processor (expected_params, false);
+    boost::mysql::error_info info;
+    bytestring buff = greeting;
+    BOOST_TEST_REQUIRE(processor.process_handshake(buff, info) == error_code());
+    processor.compose_handshake_response(buff);
+    BOOST_TEST(write() == framed(buff, 1));
+
+    BOOST_TEST((engine.next_event() == event::need_input));
+    engine.feed(boost::asio::buffer(framed(ok_packet, 2)));
+    BOOST_TEST((engine.next_event() == event::done));
+    BOOST_TEST(engine.ready());
+    BOOST_TEST(engine.connection_id() == 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(handshake_ssl_required, fixture)
+{
+    params.set_ssl(ssl_mode::require);
+    connection_engine eng (params);
+    eng.feed(boost::asio::buffer(framed(greeting, 0)));
+    BOOST_TEST((eng.next_event() == event::error)); // the server doesn't support TLS
+    BOOST_TEST(eng.last_error() == make_error_code(errc::server_unsupported));
+    BOOST_TEST(!eng.ready());
+}
+
+BOOST_FIXTURE_TEST_CASE(query_rows, fixture)
+{
+    handshake();
+    engine.start_query("SELECT id FROM test_table");
+    BOOST_TEST(write() == framed(bytestring{0x03, 'S', 'E', 'L', 'E', 'C', 'T', ' ', 'i', 'd', ' ',
+        'F', 'R', 'O', 'M', ' ', 't', 'e', 's', 't', '_', 't', 'a', 'b', 'l', 'e'}, 0));
+
+    // Input is consumed as it arrives, in any chunk size
+    bytestring response = framed(bytestring{0x01}, 1);
+    auto append = [&response](const bytestring& b) { response.insert(response.end(), b.begin(), b.end()); };
+    append(framed(field_definition, 2));
+    append(framed(bytestring{0x02, '4', '2'}, 3));
+    append(framed(bytestring{0x02, '5', '0'}, 4));
+    append(framed(eof_packet, 5));
+    std::size_t split = 10;
+    BOOST_TEST((engine.next_event() == event::need_input));
+    engine.feed(boost::asio::buffer(response.data(), split));
+    BOOST_TEST((engine.next_event() == event::need_input));
+    auto buff = engine.prepare_input(response.size() - split);
+    std::memcpy(buff.data(), response.data() + split, response.size() - split);
+    engine.commit_input(response.size() - split);
+
+    BOOST_TEST_REQUIRE((engine.next_event() == event::fields));
+    BOOST_TEST_REQUIRE(engine.fields().size() == 1u);
+    BOOST_TEST(engine.fields()[0].field_name() == "id");
+    BOOST_TEST_REQUIRE((engine.next_event() == event::row));
+    BOOST_TEST(engine.current_row().values() == make_value_vector(42));
+    BOOST_TEST_REQUIRE((engine.next_event() == event::row));
+    BOOST_TEST(engine.current_row().values() == make_value_vector(50));
+    BOOST_TEST_REQUIRE((engine.next_event() == event::done));
+    BOOST_TEST(engine.ready());
+}
+
+BOOST_FIXTURE_TEST_CASE(query_ok_packet, fixture)
+{
+    handshake();
+    engine.start_query("DELETE FROM t");
+    write();
+    engine.feed(boost::asio::buffer(framed(ok_packet, 1)));
+    BOOST_TEST_REQUIRE((engine.next_event() == event::done));
+    BOOST_TEST(engine.affected_rows() == 2u);
+    BOOST_TEST(engine.last_insert_id() == 5u);
+    BOOST_TEST(engine.warning_count() == 0u);
+    BOOST_TEST(engine.ready());
+}
+
+BOOST_FIXTURE_TEST_CASE(query_server_error, fixture)
+{
+    handshake();
+    engine.start_query("SELECT * FROM bad");
+    write();
+    engine.feed(boost::asio::buffer(framed(error_packet, 1)));
+    BOOST_TEST_REQUIRE((engine.next_event() == event::error));
+    BOOST_TEST(engine.last_error() == make_error_code(errc::no_such_table));
+    BOOST_TEST(engine.last_error_info().message() == "bad");
+
+    // Server errors don't prevent using the connection
+    BOOST_TEST(engine.ready());
+    engine.start_query("SELECT 1");
+    BOOST_TEST((engine.next_event() == event::write));
+}
+
+BOOST_FIXTURE_TEST_CASE(sequence_number_mismatch, fixture)
+{
+    handshake();
+    engine.start_query("SELECT 1");
+    write();
+    engine.feed(boost::asio::buffer(framed(ok_packet, 2)));
+    BOOST_TEST_REQUIRE((engine.next_event() == event::error));
+    BOOST_TEST(engine.last_error() == make_error_code(errc::sequence_number_mismatch));
+    BOOST_TEST(!engine.ready());
+}
+
+BOOST_FIXTURE_TEST_CASE(quit, fixture)
+{
+    handshake();
+    engine.start_quit();
+    BOOST_TEST(write() == framed(bytestring{0x01}, 0));
+    BOOST_TEST((engine.next_event() == event::done));
+    BOOST_TEST(!engine.ready());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_connection_engine
+
+}
@@ -0,0 +1,238 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/decimal.hpp>
+#include "test_common.hpp"
+#include <boost/test/unit_test_suite.hpp>
+#include <boost/test/data/monomorphic/collection.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <limits>
+#include <sstream>
+
+using namespace boost::mysql::test;
+using namespace boost::unit_test;
+using boost::mysql::decimal;
+using boost::mysql::parse_decimal;
+using boost::mysql::get_decimal;
+using boost::mysql::value;
+using boost::mysql::detail::protocol_field_type;
+
+BOOST_AUTO_TEST_SUITE(test_decimal)
+
+// Parsing and serialization. to_chars(parse_decimal(s)) == s for canonical strings
+struct roundtrip_sample
+{
+    std::string name;
+    std::string repr;
+    unsigned expected_scale;
+    bool expected_negative;
+};
+
+std::ostream& operator<<(std::ostream& os, const roundtrip_sample& input)
+{
+    return os << input.name;
+}
+
+std::vector<roundtrip_sample> make_roundtrip_samples()
+{
+    return {
+        { "zero", "0", 0, false },
+        { "zero_scale", "0.00", 2, false },
+        { "integer", "42", 0, false },
+        { "negative_integer", "-42", 0, true },
+        { "fractional", "12.50", 2, false },
+        { "negative_fractional", "-12.50", 2, true },
+        { "only_fractional", "0.05", 2, false },
+        { "negative_only_fractional", "-0.000001", 6, true },
+        { "chunk_boundary", "123456789", 0, false },
+        { "chunk_boundary_plus_one", "1234567890", 0, false },
+        { "max_u64", "18446744073709551615", 0, false },
+        { "max_u64_plus_one", "18446744073709551616", 0, false },
+        { "wide_fractional", "-12345678901234567890.123456", 6, true },
+        { "max_precision", "99999999999999999999999999999999999999", 0, false },
+        { "max_precision_negative", "-9999999999999999999999999999999999999.9", 1, true },
+        { "max_scale", "0.99999999999999999999999999999999999999", 38, false },
+        { "max_scale_negative", "-0.00000000000000000000000000000000000001", 38, true },
+    };
+}
+
+BOOST_DATA_TEST_CASE(parse_to_chars_roundtrip, data::make(make_roundtrip_samples()))
+{
+    auto d = parse_decimal(sample.repr);
+    BOOST_TEST_REQUIRE(d.has_value());
+    BOOST_TEST(d->scale() == sample.expected_scale);
+    BOOST_TEST(d->is_negative() == sample.expected_negative);
+
+    char buff [decimal::max_string_size];
+    std::size_t size = d->to_chars(buff);
+    BOOST_TEST(std::string(buff, size) == sample.repr);
+    BOOST_TEST(d->to_string() == sample.repr);
+
+    std::ostringstream ss;
+    ss << *d;
+    BOOST_TEST(ss.str() == sample.repr);
+}
+
+BOOST_AUTO_TEST_CASE(parse_non_canonical)
+{
+    BOOST_TEST(parse_decimal("+12.5")->to_string() == "12.5");
+    BOOST_TEST(parse_decimal("0012.5")->to_string() == "12.5");
+    BOOST_TEST(parse_decimal("-0.00")->to_string() == "0.00"); // zero is never negative
+    BOOST_TEST(!parse_decimal("-0")->is_negative());
+    BOOST_TEST(parse_decimal("000000000000000000000000000000000000000001")->to_string() == "1");
+}
+
+BOOST_AUTO_TEST_CASE(parse_error)
+{
+    const char* inputs [] = {
+        "",
+        "-",
+        "+",
+        ".",
+        ".5",
+        "5.",
+        "1.2.3",
+        "1,5",
+        "abc",
+        "12a",
+        " 12",
+        "--1",
+        "1e10",
+        "100000000000000000000000000000000000000", // 39 significant digits
+        "1.00000000000000000000000000000000000000", // 39 significant digits
+        "0.000000000000000000000000000000000000001", // scale 39
+    };
+    for (const char* input: inputs)
+    {
+        BOOST_TEST_CONTEXT(input)
+        {
+            BOOST_TEST(!parse_decimal(input).has_value());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parse_with_scale)
+{
+    BOOST_TEST(parse_decimal("12.5", 3)->to_string() == "12.500");
+    BOOST_TEST(parse_decimal("12", 2)->to_string() == "12.00");
+    BOOST_TEST(parse_decimal("12.500", 1)->to_string() == "12.5");
+    BOOST_TEST(parse_decimal("12.500", 0).has_value() == false);
+    BOOST_TEST(parse_decimal("12.5", 39).has_value() == false);
+    BOOST_TEST(parse_decimal("9999999999999999999999999999999999999", 2).has_value() == false);
+}
+
+BOOST_AUTO_TEST_CASE(constructor)
+{
+    BOOST_TEST(decimal().to_string() == "0");
+    BOOST_TEST(decimal(1250, 2).to_string() == "12.50");
+    BOOST_TEST(decimal(-5, 3).to_string() == "-0.005");
+    BOOST_TEST(decimal(0, 1).to_string() == "0.0");
+    BOOST_TEST(decimal((std::numeric_limits<std::int64_t>::min)(), 0).to_string() ==
+        "-9223372036854775808");
+}
+
+BOOST_AUTO_TEST_CASE(unscaled_value)
+{
+    BOOST_TEST(*decimal(1250, 2).unscaled_value() == 1250);
+    BOOST_TEST(*decimal(-1250, 2).unscaled_value() == -1250);
+    auto min = (std::numeric_limits<std::int64_t>::min)();
+    auto max = (std::numeric_limits<std::int64_t>::max)();
+    BOOST_TEST(*decimal(min, 0).unscaled_value() == min);
+    BOOST_TEST(*decimal(max, 0).unscaled_value() == max);
+    BOOST_TEST(!parse_decimal("9223372036854775808")->unscaled_value().has_value());
+    BOOST_TEST(!parse_decimal("-9223372036854775809")->unscaled_value().has_value());
+    BOOST_TEST(!parse_decimal("123456789012345678901234567890")->unscaled_value().has_value());
+}
+
+#ifdef BOOST_HAS_INT128
+BOOST_AUTO_TEST_CASE(unscaled_value_int128)
+{
+    auto d = parse_decimal("-12345678901234567890.123456");
+    boost::int128_type expected = static_cast<boost::int128_type>(12345678901234567890ull) * 1000000 + 123456;
+    BOOST_TEST((d->unscaled_value_int128() == -expected));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(rescale)
+{
+    decimal d (1250, 2);
+    BOOST_TEST(d.rescale(4));
+    BOOST_TEST(d.to_string() == "12.5000");
+    BOOST_TEST(d.rescale(1));
+    BOOST_TEST(d.to_string() == "12.5");
+    BOOST_TEST(!d.rescale(0)); // would drop a non-zero digit
+    BOOST_TEST(d.to_string() == "12.5");
+    BOOST_TEST(!d.rescale(39)); // max scale exceeded
+    BOOST_TEST(!d.rescale(38)); // max precision exceeded
+    BOOST_TEST(d.rescale(36));
+    BOOST_TEST(d.to_string() == "12.500000000000000000000000000000000000");
+    BOOST_TEST(d.rescale(0) == false);
+    BOOST_TEST(d.rescale(1));
+    BOOST_TEST(d.to_string() == "12.5");
+}
+
+BOOST_AUTO_TEST_CASE(to_double)
+{
+    BOOST_TEST(decimal(1250, 2).to_double() == 12.5);
+    BOOST_TEST(decimal(-5, 3).to_double() == -0.005);
+    BOOST_TEST(decimal().to_double() == 0.0);
+    BOOST_TEST(parse_decimal("123456789012345678901234567890")->to_double() == 1.2345678901234568e29,
+        boost::test_tools::tolerance(1e-15));
+}
+
+BOOST_AUTO_TEST_CASE(relational_operators)
+{
+    decimal a (150, 2); // 1.50
+    decimal b (15, 1);  // 1.5
+    decimal c (-2, 0);  // -2
+    decimal d (151, 2); // 1.51
+    auto big = *parse_decimal("99999999999999999999999999999999999999");
+    auto small = *parse_decimal("0.00000000000000000000000000000000000001");
+
+    BOOST_TEST((a == b));
+    BOOST_TEST(!(a != b));
+    BOOST_TEST((a != d));
+    BOOST_TEST((a < d));
+    BOOST_TEST((b < d));
+    BOOST_TEST((c < a));
+    BOOST_TEST((a <= b));
+    BOOST_TEST((d > b));
+    BOOST_TEST((b >= a));
+    BOOST_TEST((small < big));
+    BOOST_TEST((big > small));
+    BOOST_TEST((decimal(0, 3) == decimal()));
+    BOOST_TEST((*parse_decimal("-0.0") == decimal()));
+    BOOST_TEST((decimal(-1, 38) < decimal()));
+}
+
+// get_decimal
+BOOST_AUTO_TEST_CASE(get_decimal_string)
+{
+    auto meta = makemeta("f", protocol_field_type::newdecimal, 0, 3);
+    BOOST_TEST(get_decimal(value("12.500"), meta)->to_string() == "12.500");
+    BOOST_TEST(get_decimal(value("-12.5"), meta)->to_string() == "-12.500");
+    BOOST_TEST(!get_decimal(value("12.5001"), meta).has_value());
+    BOOST_TEST(!get_decimal(value("abc"), meta).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(get_decimal_integer)
+{
+    auto meta = makemeta("f", protocol_field_type::newdecimal, 0, 2);
+    BOOST_TEST(get_decimal(value(-42), meta)->to_string() == "-42.00");
+    BOOST_TEST(get_decimal(value(std::uint64_t(18446744073709551615ull)), meta)->to_string() ==
+        "18446744073709551615.00");
+}
+
+BOOST_AUTO_TEST_CASE(get_decimal_other_types)
+{
+    auto meta = makemeta("f", protocol_field_type::newdecimal, 0, 2);
+    BOOST_TEST(!get_decimal(value(), meta).has_value());
+    BOOST_TEST(!get_decimal(value(4.2), meta).has_value());
+    BOOST_TEST(!get_decimal(value(makedate(2020, 1, 1)), meta).has_value());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_decimal
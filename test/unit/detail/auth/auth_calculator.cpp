@@ -12,6 +12,7 @@ using namespace boost::mysql::detail;
 using namespace boost::mysql::test;
 using boost::mysql::error_code;
 using boost::mysql::errc;
+using boost::mysql::password_hashes;
 
 BOOST_AUTO_TEST_SUITE(test_auth_calculator)
 
@@ -73,6 +74,22 @@ BOOST_FIXTURE_TEST_CASE(bad_challenge_length, mysql_native_password)
             make_error_code(errc::protocol_value_error));
 }
 
+BOOST_FIXTURE_TEST_CASE(password_hashes_ssl_false, mysql_native_password)
+{
+    password_hashes hashes ("root");
+    auto err = calc.calculate("mysql_native_password", "", challenge, false, &hashes);
+    BOOST_TEST_REQUIRE(err == error_code());
+    BOOST_TEST(calc.response() == expected);
+}
+
+BOOST_FIXTURE_TEST_CASE(password_hashes_empty, mysql_native_password)
+{
+    password_hashes hashes;
+    auto err = calc.calculate("mysql_native_password", "", challenge, false, &hashes);
+    BOOST_TEST_REQUIRE(err == error_code());
+    BOOST_TEST(calc.response() == "");
+}
+
 // caching_sha2_password
 struct caching_sha2_password_test
 {
@@ -155,6 +172,27 @@ BOOST_FIXTURE_TEST_CASE(empty_password_cleartext_auth_ssl_true, caching_sha2_pas
     BOOST_TEST(calc.plugin_name() == "caching_sha2_password");
 }
 
+BOOST_FIXTURE_TEST_CASE(password_hashes_challenge_auth, caching_sha2_password_test)
+{
+    password_hashes hashes ("hola");
+    auto err = calc.calculate("caching_sha2_password", "", challenge, false, &hashes);
+    BOOST_TEST_REQUIRE(err == error_code());
+    BOOST_TEST(calc.response() == expected);
+}
+
+BOOST_FIXTURE_TEST_CASE(password_hashes_cleartext_auth, caching_sha2_password_test)
+{
+    password_hashes hashes ("hola");
+
+    // Without the cleartext password, full authentication can't be performed
+    auto err = calc.calculate("caching_sha2_password", "", cleartext_challenge, true, &hashes);
+    BOOST_TEST(err == make_error_code(errc::cleartext_password_unavailable));
+
+    err = calc.calculate("caching_sha2_password", "hola", cleartext_challenge, true, &hashes);
+    BOOST_TEST_REQUIRE(err == error_code());
+    BOOST_TEST(calc.response() == std::string("hola") + '\0');
+}
+
 BOOST_FIXTURE_TEST_CASE(caching_sha2_bad_challenge_length, caching_sha2_password_test)
 {
     BOOST_TEST((calc.calculate("caching_sha2_password", "password", "", true)) ==
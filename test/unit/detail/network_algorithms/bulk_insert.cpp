@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/detail/network_algorithms/bulk_insert.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include "test_common.hpp"
+#include <limits>
+#include <string>
+#include <tuple>
+
+using namespace boost::mysql::test;
+using namespace boost::unit_test;
+using namespace boost::mysql::detail;
+using boost::mysql::value;
+using boost::mysql::error_code;
+using boost::mysql::errc;
+using boost::mysql::format_options;
+using boost::mysql::collation;
+
+namespace
+{
+
+std::string to_string(const bytestring& buff)
+{
+    return std::string(buff.begin(), buff.end());
+}
+
+std::string statement_text(bulk_insert_processor& proc)
+{
+    bytestring& buff = proc.statement().buffer;
+    BOOST_TEST_REQUIRE(!buff.empty());
+    BOOST_TEST(buff[0] == com_query_packet::command_id);
+    return std::string(buff.begin() + 1, buff.end());
+}
+
+BOOST_AUTO_TEST_SUITE(test_bulk_insert)
+
+// SQL literals
+struct literal_sample
+{
+    std::string name;
+    value input;
+    std::string expected;
+};
+
+std::ostream& operator<<(std::ostream& os, const literal_sample& input)
+{
+    return os << input.name;
+}
+
+std::vector<literal_sample> make_literal_samples()
+{
+    return {
+        { "null", value(), "NULL" },
+        { "int64_positive", value(42), "42" },
+        { "int64_negative", value(-42), "-42" },
+        { "int64_min", value(std::numeric_limits<std::int64_t>::min()), "-9223372036854775808" },
+        { "uint64_max", value(std::numeric_limits<std::uint64_t>::max()), "18446744073709551615" },
+        { "string_empty", value(""), "''" },
+        { "string_regular", value("abc"), "'abc'" },
+        { "string_quotes", value("it's \"quoted\""), "'it\\'s \"quoted\"'" },
+        { "string_newline", value("a\nb"), "'a\nb'" },
+        { "string_backslash", value("a\\b"), "'a\\\\b'" },
+        { "string_null_byte", value(boost::string_view("a\0b", 3)), "'a\\0b'" },
+        { "string_ctrl_z", value("\x1a"), "'\\Z'" },
+        { "string_utf8", value("\xc3\xb1"), "'\xc3\xb1'" },
+        { "float", value(4.2f), "4.19999981" },
+        { "double", value(-4.2), "-4.2000000000000002" },
+        { "double_exponent", value(1e20), "1e+20" },
+        { "date", value(makedate(2020, 2, 19)), "'2020-02-19'" },
+        { "datetime", value(makedt(2020, 2, 19, 10, 20, 30, 123456)), "'2020-02-19 10:20:30.123456'" },
+        { "datetime_before_epoch", value(makedt(1960, 1, 1, 1)), "'1960-01-01 01:00:00.000000'" },
+        { "time_positive", value(maket(838, 59, 59)), "'838:59:59.000000'" },
+        { "time_negative", value(-maket(1, 2, 3, 4)), "'-01:02:03.000004'" },
+    };
+}
+
+BOOST_DATA_TEST_CASE(sql_literal_ok, data::make(make_literal_samples()))
+{
+    bytestring output;
+    auto err = serialize_sql_literal(sample.input, true, output);
+    BOOST_TEST(err == errc::ok);
+    BOOST_TEST(to_string(output) == sample.expected);
+}
+
+BOOST_AUTO_TEST_CASE(sql_literal_no_backslash_escapes)
+{
+    // Only quotes are escaped, by doubling them
+    bytestring output;
+    serialize_sql_literal(value(boost::string_view("it's a\\b\0\x1a", 10)), false, output);
+    BOOST_TEST(to_string(output) == std::string("'it''s a\\b\0\x1a'", 13));
+}
+
+BOOST_AUTO_TEST_CASE(sql_literal_long_strings)
+{
+    // Exercise word-at-a-time scanning, with special characters in different positions
+    std::string plain (37, 'a');
+    for (std::size_t i = 0; i < plain.size(); ++i)
+    {
+        std::string input = plain;
+        input[i] = '\\';
+        bytestring output;
+        serialize_sql_literal(value(input), true, output);
+        BOOST_TEST(to_string(output) == "'" + plain.substr(0, i) + "\\\\" + plain.substr(i + 1) + "'");
+        output.clear();
+        serialize_sql_literal(value(input), false, output);
+        BOOST_TEST(to_string(output) == "'" + input + "'");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sql_literal_unrepresentable)
+{
+    bytestring output;
+    BOOST_TEST(serialize_sql_literal(value(std::numeric_limits<double>::infinity()), true, output) ==
+        errc::unrepresentable_value);
+    BOOST_TEST(serialize_sql_literal(value(std::numeric_limits<float>::quiet_NaN()), true, output) ==
+        errc::unrepresentable_value);
+}
+
+// Statement building
+BOOST_AUTO_TEST_CASE(value_collection_rows)
+{
+    bulk_insert_processor proc ("INSERT INTO t VALUES ", 1024, format_options());
+    BOOST_TEST(!proc.has_rows());
+    BOOST_TEST(proc.add_row(make_value_vector(1, "a")) == error_code());
+    BOOST_TEST(proc.add_row(make_value_vector(2, nullptr)) == error_code());
+    BOOST_TEST(proc.has_rows());
+    BOOST_TEST(!proc.full());
+    BOOST_TEST(statement_text(proc) == "INSERT INTO t VALUES (1,'a'),(2,NULL)");
+}
+
+BOOST_AUTO_TEST_CASE(tuple_rows)
+{
+    bulk_insert_processor proc ("INSERT INTO t VALUES ", 1024, format_options());
+    BOOST_TEST(proc.add_row(std::make_tuple(1, std::string("a'b"), 4.5)) == error_code());
+    BOOST_TEST(proc.add_row(std::make_tuple(2u, "c", nullptr)) == error_code());
+    BOOST_TEST(statement_text(proc) == "INSERT INTO t VALUES (1,'a\\'b',4.5),(2,'c',NULL)");
+}
+
+BOOST_AUTO_TEST_CASE(split_statements)
+{
+    // Each row takes 7 bytes, plus the comma. Prefix takes 3 bytes
+    std::uint64_t total_rows = 0;
+    bulk_insert_processor proc ("IN ", 20, format_options());
+    BOOST_TEST(proc.add_row(make_value_vector("abc")) == error_code()); // 10 bytes
+    BOOST_TEST(proc.add_row(make_value_vector("def")) == error_code()); // 18 bytes
+    BOOST_TEST(!proc.full());
+    BOOST_TEST(proc.add_row(make_value_vector("ghi")) == error_code()); // 26 bytes, doesn't fit
+    BOOST_TEST(proc.full());
+    BOOST_TEST(statement_text(proc) == "IN ('abc'),('def')");
+
+    // Execution takes ownership of the buffer
+    bytestring sent;
+    sent.swap(proc.statement().buffer);
+    proc.on_statement_executed(2);
+    total_rows += 2;
+    BOOST_TEST(!proc.full());
+    BOOST_TEST(proc.has_rows());
+    BOOST_TEST(statement_text(proc) == "IN ('ghi')");
+
+    BOOST_TEST(proc.add_row(make_value_vector("jkl")) == error_code());
+    BOOST_TEST(statement_text(proc) == "IN ('ghi'),('jkl')");
+    proc.on_statement_executed(2);
+    total_rows += 2;
+    BOOST_TEST(!proc.has_rows());
+    BOOST_TEST(proc.affected_rows() == total_rows);
+}
+
+BOOST_AUTO_TEST_CASE(row_bigger_than_limit)
+{
+    // A row that exceeds the limit on its own is sent in its own statement
+    bulk_insert_processor proc ("IN ", 5, format_options());
+    BOOST_TEST(proc.add_row(make_value_vector("abcdef")) == error_code());
+    BOOST_TEST(!proc.full());
+    BOOST_TEST(proc.add_row(make_value_vector("g")) == error_code());
+    BOOST_TEST(proc.full());
+    BOOST_TEST(statement_text(proc) == "IN ('abcdef')");
+    proc.on_statement_executed(1);
+    BOOST_TEST(statement_text(proc) == "IN ('g')");
+}
+
+BOOST_AUTO_TEST_CASE(row_error)
+{
+    bulk_insert_processor proc ("IN ", 1024, format_options());
+    BOOST_TEST(proc.add_row(make_value_vector(1, std::numeric_limits<double>::quiet_NaN())) ==
+        error_code(errc::unrepresentable_value));
+}
+
+BOOST_AUTO_TEST_CASE(no_backslash_escapes)
+{
+    bulk_insert_processor proc ("IN ", 1024, format_options(collation::utf8mb4_general_ci, false));
+    BOOST_TEST(proc.add_row(make_value_vector("a'\\")) == error_code());
+    BOOST_TEST(statement_text(proc) == "IN ('a''\\')");
+}
+
+BOOST_AUTO_TEST_CASE(unsafe_charset)
+{
+    bulk_insert_processor proc ("IN ", 1024, format_options(collation::gbk_chinese_ci));
+    BOOST_TEST(proc.add_row(make_value_vector("abc")) == error_code(errc::unsafe_charset));
+    BOOST_TEST(!proc.has_rows());
+}
+
+BOOST_AUTO_TEST_CASE(make_params)
+{
+    std::vector<std::vector<value>> rows (3);
+    auto params = boost::mysql::make_bulk_insert_params("INSERT ", rows);
+    BOOST_TEST(params.statement_prefix() == "INSERT ");
+    BOOST_TEST((params.first() == rows.cbegin()));
+    BOOST_TEST((params.last() == rows.cend()));
+    BOOST_TEST(params.max_statement_size() == boost::mysql::default_bulk_insert_statement_size);
+
+    auto params2 = boost::mysql::make_bulk_insert_params("INSERT ", rows.begin(), rows.end(), 10);
+    BOOST_TEST(params2.max_statement_size() == 10u);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_bulk_insert
+
+}
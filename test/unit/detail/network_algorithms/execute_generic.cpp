@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/detail/network_algorithms/execute_generic.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <string>
+
+using namespace boost::mysql::detail;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+using boost::mysql::local_infile_handler;
+
+namespace
+{
+
+constexpr capabilities caps (CLIENT_PROTOCOL_41 | CLIENT_DEPRECATE_EOF | CLIENT_LOCAL_FILES);
+
+void set_buffer(execute_processor& proc, const bytestring& contents)
+{
+    proc.get_buffer() = contents;
+}
+
+bytestring local_infile_request { 0xfb, 'f', '.', 'c', 's', 'v' };
+bytestring ok_response { 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00 };
+
+BOOST_AUTO_TEST_SUITE(test_execute_generic)
+
+BOOST_AUTO_TEST_CASE(local_infile_streams_chunks)
+{
+    std::string contents (local_infile_chunk_size + 10, 'a');
+    std::size_t offset = 0;
+    std::string requested_filename;
+    local_infile_handler handler = [&](
+        boost::string_view filename,
+        boost::asio::mutable_buffer buff,
+        error_code&
+    ) {
+        requested_filename = filename.to_string();
+        std::size_t size = (std::min)(buff.size(), contents.size() - offset);
+        std::memcpy(buff.data(), contents.data() + offset, size);
+        offset += size;
+        return size;
+    };
+
+    execute_processor proc (resultset_encoding::text, caps);
+    error_code err;
+    error_info info;
+    set_buffer(proc, local_infile_request);
+    proc.process_response(err, info);
+    BOOST_TEST(err == error_code());
+    BOOST_TEST(proc.local_infile_requested());
+
+    proc.read_local_infile_chunk(handler);
+    BOOST_TEST(proc.get_buffer().size() == local_infile_chunk_size);
+    BOOST_TEST(requested_filename == "f.csv");
+    proc.read_local_infile_chunk(handler);
+    BOOST_TEST(proc.get_buffer().size() == 10u);
+    proc.read_local_infile_chunk(handler);
+    BOOST_TEST(proc.get_buffer().empty());
+
+    set_buffer(proc, ok_response);
+    proc.process_response(err, info);
+    BOOST_TEST(err == error_code());
+    BOOST_TEST(!proc.local_infile_requested());
+    BOOST_TEST(proc.field_count() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(local_infile_handler_error)
+{
+    int num_calls = 0;
+    local_infile_handler handler = [&](
+        boost::string_view,
+        boost::asio::mutable_buffer,
+        error_code& err
+    ) {
+        ++num_calls;
+        err = boost::asio::error::access_denied;
+        return std::size_t(0);
+    };
+
+    execute_processor proc (resultset_encoding::text, caps);
+    error_code err;
+    error_info info;
+    set_buffer(proc, local_infile_request);
+    proc.process_response(err, info);
+    BOOST_TEST(err == error_code());
+
+    // The handler is not called again after failing
+    proc.read_local_infile_chunk(handler);
+    BOOST_TEST(proc.get_buffer().empty());
+    proc.read_local_infile_chunk(handler);
+    BOOST_TEST(proc.get_buffer().empty());
+    BOOST_TEST(num_calls == 1);
+
+    // The error is reported once the server acknowledges the end of the data
+    set_buffer(proc, ok_response);
+    proc.process_response(err, info);
+    BOOST_TEST(err == error_code(boost::asio::error::access_denied));
+}
+
+BOOST_AUTO_TEST_CASE(local_infile_no_handler)
+{
+    execute_processor proc (resultset_encoding::text, caps);
+    error_code err;
+    error_info info;
+    set_buffer(proc, local_infile_request);
+    proc.process_response(err, info);
+    BOOST_TEST(err == error_code());
+    BOOST_TEST(proc.local_infile_requested());
+
+    proc.read_local_infile_chunk(local_infile_handler());
+    BOOST_TEST(proc.get_buffer().empty());
+
+    set_buffer(proc, ok_response);
+    proc.process_response(err, info);
+    BOOST_TEST(err == error_code(errc::local_infile_disabled));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_execute_generic
+
+}
@@ -0,0 +1,275 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/detail/network_algorithms/execute_many.hpp>
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <vector>
+
+using namespace boost::mysql::detail;
+using boost::mysql::value;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+
+namespace
+{
+
+constexpr capabilities caps (CLIENT_PROTOCOL_41 | CLIENT_DEPRECATE_EOF);
+
+bytestring ok_response (std::uint8_t affected_rows)
+{
+    return { 0x00, affected_rows, 0x00, 0x02, 0x00, 0x00, 0x00 };
+}
+
+// ER_DUP_ENTRY
+bytestring error_response { 0xff, 0x26, 0x04, '#', '2', '3', '0', '0', '0', 'd', 'u', 'p' };
+
+error_code process(execute_many_processor& proc, const bytestring& packet, error_info& info)
+{
+    proc.get_buffer() = packet;
+    return proc.process_packet(info);
+}
+
+using param_set_collection = std::vector<std::vector<value>>;
+
+param_set_collection make_param_sets(std::size_t num_sets)
+{
+    param_set_collection res;
+    for (std::size_t i = 0; i < num_sets; ++i)
+        res.push_back({ value(static_cast<std::int64_t>(i)), value("abc") });
+    return res;
+}
+
+// Validates the parameter sets and serializes the first window
+param_set_collection::const_iterator start(
+    execute_many_processor& proc,
+    const param_set_collection& param_sets,
+    error_info& info
+)
+{
+    auto err = proc.process_requests(1, 2, param_sets, nullptr, info);
+    BOOST_TEST_REQUIRE(err == error_code());
+    return proc.serialize_window(param_sets.begin(), param_sets.end());
+}
+
+// Counts the requests in the buffer, checking that each is a single packet
+// with sequence number zero
+int count_requests(const bytestring& buff)
+{
+    std::uint8_t command_id = com_stmt_execute_packet<const value*>::command_id;
+    std::size_t offset = 0;
+    int num_packets = 0;
+    while (offset < buff.size())
+    {
+        std::size_t size = buff[offset] | (buff[offset + 1] << 8) | (buff[offset + 2] << 16);
+        BOOST_TEST(buff[offset + 3] == 0);
+        BOOST_TEST(buff[offset + 4] == command_id);
+        offset += 4 + size;
+        ++num_packets;
+    }
+    BOOST_TEST(offset == buff.size());
+    return num_packets;
+}
+
+BOOST_AUTO_TEST_SUITE(test_execute_many)
+
+BOOST_AUTO_TEST_SUITE(test_frame_message)
+
+BOOST_AUTO_TEST_CASE(small_message)
+{
+    bytestring msg { 0x01, 0x02, 0x03 };
+    bytestring output { 0xaa };
+    auto seqnum = frame_message(boost::asio::buffer(msg), 5, output);
+    BOOST_TEST(seqnum == 6);
+    bytestring expected { 0xaa, 0x03, 0x00, 0x00, 0x05, 0x01, 0x02, 0x03 };
+    BOOST_TEST(output == expected);
+}
+
+BOOST_AUTO_TEST_CASE(empty_message)
+{
+    bytestring output;
+    auto seqnum = frame_message(boost::asio::const_buffer(), 0, output);
+    BOOST_TEST(seqnum == 1);
+    bytestring expected { 0x00, 0x00, 0x00, 0x00 };
+    BOOST_TEST(output == expected);
+}
+
+BOOST_AUTO_TEST_CASE(max_size_message)
+{
+    // A message of exactly MAX_PACKET_SIZE bytes requires a trailing empty packet
+    bytestring msg (MAX_PACKET_SIZE, 0x01);
+    bytestring output;
+    auto seqnum = frame_message(boost::asio::buffer(msg), 0, output);
+    BOOST_TEST(seqnum == 2);
+    BOOST_TEST_REQUIRE(output.size() == MAX_PACKET_SIZE + 8);
+    BOOST_TEST(output[0] == 0xff);
+    BOOST_TEST(output[1] == 0xff);
+    BOOST_TEST(output[2] == 0xff);
+    BOOST_TEST(output[3] == 0x00);
+    bytestring trailer (output.end() - 4, output.end());
+    bytestring expected_trailer { 0x00, 0x00, 0x00, 0x01 };
+    BOOST_TEST(trailer == expected_trailer);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_frame_message
+
+BOOST_AUTO_TEST_CASE(requests_framed_individually)
+{
+    execute_many_processor proc (caps);
+    error_info info;
+    auto param_sets = make_param_sets(3);
+    auto next = start(proc, param_sets, info);
+    BOOST_TEST((next == param_sets.end()));
+    BOOST_TEST(proc.has_pending_responses());
+    BOOST_TEST(count_requests(proc.get_buffer()) == 3);
+    BOOST_TEST(*proc.response_sequence_number() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(window_smaller_than_batch)
+{
+    // Windows of at most two executions
+    execute_many_processor proc (caps, 2);
+    error_info info;
+    auto param_sets = make_param_sets(5);
+    auto next = start(proc, param_sets, info);
+
+    // First window
+    BOOST_TEST((next == param_sets.begin() + 2));
+    BOOST_TEST(count_requests(proc.get_buffer()) == 2);
+    BOOST_TEST(process(proc, ok_response(1), info) == error_code());
+    BOOST_TEST(process(proc, ok_response(2), info) == error_code());
+    BOOST_TEST(!proc.has_pending_responses());
+
+    // Second window
+    next = proc.serialize_window(next, param_sets.cend());
+    BOOST_TEST((next == param_sets.begin() + 4));
+    BOOST_TEST(count_requests(proc.get_buffer()) == 2);
+    BOOST_TEST(*proc.response_sequence_number() == 1);
+    BOOST_TEST(process(proc, error_response, info) == error_code());
+    BOOST_TEST(process(proc, ok_response(3), info) == error_code());
+    BOOST_TEST(!proc.has_pending_responses());
+
+    // Last window
+    next = proc.serialize_window(next, param_sets.cend());
+    BOOST_TEST((next == param_sets.end()));
+    BOOST_TEST(count_requests(proc.get_buffer()) == 1);
+    BOOST_TEST(process(proc, ok_response(4), info) == error_code());
+    BOOST_TEST(!proc.has_pending_responses());
+
+    BOOST_TEST(proc.affected_rows() == 10u);
+    BOOST_TEST(proc.server_error() == error_code(errc::dup_entry));
+    BOOST_TEST(info.message() == "dup");
+}
+
+BOOST_AUTO_TEST_CASE(window_size_limit)
+{
+    // The window is full once it exceeds the size limit, but always
+    // contains at least one execution
+    execute_many_processor proc (caps, 256, 1);
+    error_info info;
+    auto param_sets = make_param_sets(2);
+    auto next = start(proc, param_sets, info);
+    BOOST_TEST((next == param_sets.begin() + 1));
+    BOOST_TEST(count_requests(proc.get_buffer()) == 1);
+    BOOST_TEST(process(proc, ok_response(1), info) == error_code());
+    next = proc.serialize_window(next, param_sets.cend());
+    BOOST_TEST((next == param_sets.end()));
+    BOOST_TEST(count_requests(proc.get_buffer()) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(wrong_num_params)
+{
+    std::vector<std::vector<value>> param_sets {
+        { value(1), value(2) },
+        { value(1) }
+    };
+    execute_many_processor proc (caps);
+    error_info info;
+    auto err = proc.process_requests(1, 2, param_sets, nullptr, info);
+    BOOST_TEST(err == make_error_code(errc::wrong_num_params));
+    BOOST_TEST(info.message() ==
+        "prepared_statement::execute_many: expected 2 params, but got 1 in parameter set 1");
+}
+
+BOOST_AUTO_TEST_CASE(empty_param_sets)
+{
+    execute_many_processor proc (caps);
+    error_info info;
+    auto param_sets = make_param_sets(0);
+    auto next = start(proc, param_sets, info);
+    BOOST_TEST((next == param_sets.end()));
+    BOOST_TEST(!proc.has_pending_responses());
+}
+
+BOOST_AUTO_TEST_CASE(affected_rows_aggregated)
+{
+    execute_many_processor proc (caps);
+    error_info info;
+    auto param_sets = make_param_sets(2);
+    start(proc, param_sets, info);
+    BOOST_TEST(process(proc, ok_response(2), info) == error_code());
+    BOOST_TEST(proc.has_pending_responses());
+    BOOST_TEST(process(proc, ok_response(3), info) == error_code());
+    BOOST_TEST(!proc.has_pending_responses());
+    BOOST_TEST(proc.affected_rows() == 5u);
+    BOOST_TEST(proc.server_error() == error_code());
+}
+
+BOOST_AUTO_TEST_CASE(first_error_reported)
+{
+    execute_many_processor proc (caps);
+    error_info info;
+    auto param_sets = make_param_sets(3);
+    start(proc, param_sets, info);
+    BOOST_TEST(process(proc, error_response, info) == error_code());
+    BOOST_TEST(info.message() == "dup");
+    auto other_error = error_response;
+    other_error.back() = 'x';
+    BOOST_TEST(process(proc, other_error, info) == error_code());
+    BOOST_TEST(process(proc, ok_response(1), info) == error_code());
+    BOOST_TEST(!proc.has_pending_responses());
+    BOOST_TEST(proc.server_error() == error_code(errc::dup_entry));
+    BOOST_TEST(info.message() == "dup");
+    BOOST_TEST(proc.affected_rows() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(rows_skipped)
+{
+    execute_many_processor proc (caps);
+    error_info info;
+    auto param_sets = make_param_sets(2);
+    start(proc, param_sets, info);
+
+    // First response: one field and one row
+    BOOST_TEST(process(proc, bytestring{ 0x01 }, info) == error_code());
+    BOOST_TEST(!proc.response_sequence_number());
+    BOOST_TEST(process(proc, bytestring{ 0x03, 'd', 'e', 'f' }, info) == error_code());
+    BOOST_TEST(process(proc, bytestring{ 0x00, 0x00, 0x01 }, info) == error_code());
+    BOOST_TEST(process(proc, bytestring{ 0xfe, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00 }, info) == error_code());
+    BOOST_TEST(proc.response_sequence_number().has_value());
+
+    // Second response: an error while reading rows
+    BOOST_TEST(process(proc, bytestring{ 0x01 }, info) == error_code());
+    BOOST_TEST(process(proc, bytestring{ 0x03, 'd', 'e', 'f' }, info) == error_code());
+    BOOST_TEST(process(proc, error_response, info) == error_code());
+    BOOST_TEST(!proc.has_pending_responses());
+    BOOST_TEST(proc.server_error() == error_code(errc::dup_entry));
+}
+
+BOOST_AUTO_TEST_CASE(malformed_response)
+{
+    execute_many_processor proc (caps);
+    error_info info;
+    auto param_sets = make_param_sets(1);
+    start(proc, param_sets, info);
+    BOOST_TEST(process(proc, bytestring{ 0x00, 0xfc }, info) != error_code());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_execute_many
+
+}
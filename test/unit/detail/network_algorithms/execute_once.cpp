@@ -0,0 +1,156 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/detail/network_algorithms/execute_once.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace boost::mysql::detail;
+using boost::mysql::value;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+
+namespace
+{
+
+constexpr capabilities caps (CLIENT_PROTOCOL_41 | CLIENT_DEPRECATE_EOF);
+
+template <class Serializable>
+void append_framed(const Serializable& request, bytestring& output)
+{
+    bytestring message;
+    serialize_message(request, caps, message);
+    frame_message(boost::asio::buffer(message), 0, output);
+}
+
+bytestring to_bytes(boost::asio::const_buffer buff)
+{
+    auto first = static_cast<const std::uint8_t*>(buff.data());
+    return bytestring(first, first + buff.size());
+}
+
+struct fixture
+{
+    std::vector<value> params { value(42), value("abc") };
+    error_code err;
+    error_info info;
+
+    bytestring prepare_request() const
+    {
+        bytestring res;
+        append_framed(com_stmt_prepare_packet{string_eof("SELECT ?, ?")}, res);
+        return res;
+    }
+
+    bytestring execute_request(std::uint32_t statement_id) const
+    {
+        bytestring res;
+        append_framed(make_stmt_execute_packet(statement_id, params.begin(), params.end()), res);
+        return res;
+    }
+
+    bytestring close_request(std::uint32_t statement_id) const
+    {
+        bytestring res;
+        append_framed(com_stmt_close_packet{statement_id}, res);
+        return res;
+    }
+
+    static void set_prepare_response(
+        execute_once_processor& processor,
+        std::uint16_t num_columns,
+        std::uint16_t num_params
+    )
+    {
+        processor.get_buffer() = {
+            0x00, 0x07, 0x00, 0x00, 0x00,
+            static_cast<std::uint8_t>(num_columns), 0x00,
+            static_cast<std::uint8_t>(num_params), 0x00,
+            0x00, 0x00, 0x00
+        };
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(test_execute_once)
+
+BOOST_FIXTURE_TEST_CASE(mariadb_prepare_and_execute_pipelined, fixture)
+{
+    execute_once_processor processor (caps, true);
+    processor.process_request("SELECT ?, ?", params.begin(), params.end());
+    BOOST_TEST(processor.pipeline());
+
+    bytestring expected = prepare_request();
+    bytestring execute = execute_request(mariadb_last_statement_id);
+    expected.insert(expected.end(), execute.begin(), execute.end());
+    BOOST_TEST(to_bytes(processor.first_requests()) == expected);
+
+    // Close uses the actual statement ID
+    set_prepare_response(processor, 2, 2);
+    BOOST_TEST(processor.process_prepare_response(info) == error_code());
+    BOOST_TEST(to_bytes(processor.second_requests(err, info)) == close_request(7));
+    BOOST_TEST(err == error_code());
+}
+
+BOOST_FIXTURE_TEST_CASE(mariadb_prepare_error_doesnt_close, fixture)
+{
+    // If preparing fails, the last statement may be one prepared by the user
+    // earlier, so nothing referring to it must have been sent
+    execute_once_processor processor (caps, true);
+    processor.process_request("SELECT ?, ?", params.begin(), params.end());
+    bytestring first = to_bytes(processor.first_requests());
+    bytestring close = close_request(mariadb_last_statement_id);
+    BOOST_TEST((std::search(first.begin(), first.end(), close.begin(), close.end()) == first.end()));
+
+    processor.get_buffer() = { 0xff, 0x28, 0x04, '#', '4', '2', '0', '0', '0', 'e', 'r', 'r' };
+    BOOST_TEST(processor.process_prepare_response(info) != error_code());
+}
+
+BOOST_AUTO_TEST_CASE(last_statement_id_support)
+{
+    BOOST_TEST(supports_last_statement_id(true, 100200));
+    BOOST_TEST(supports_last_statement_id(true, 100604));
+    BOOST_TEST(!supports_last_statement_id(true, 100138));
+    BOOST_TEST(!supports_last_statement_id(true, 0)); // unknown version
+    BOOST_TEST(!supports_last_statement_id(false, 80027));
+}
+
+BOOST_FIXTURE_TEST_CASE(mysql_prepare_then_execute_and_close, fixture)
+{
+    execute_once_processor processor (caps, false);
+    processor.process_request("SELECT ?, ?", params.begin(), params.end());
+    BOOST_TEST(!processor.pipeline());
+    BOOST_TEST(to_bytes(processor.first_requests()) == prepare_request());
+
+    set_prepare_response(processor, 2, 2);
+    BOOST_TEST(processor.process_prepare_response(info) == error_code());
+    BOOST_TEST(processor.num_metadata_packets() == 4u);
+
+    bytestring expected = execute_request(7);
+    bytestring close = close_request(7);
+    expected.insert(expected.end(), close.begin(), close.end());
+    BOOST_TEST(to_bytes(processor.second_requests(err, info)) == expected);
+    BOOST_TEST(err == error_code());
+}
+
+BOOST_FIXTURE_TEST_CASE(mysql_wrong_num_params_only_closes, fixture)
+{
+    execute_once_processor processor (caps, false);
+    processor.process_request("SELECT ?, ?", params.begin(), params.end());
+
+    set_prepare_response(processor, 2, 3);
+    BOOST_TEST(processor.process_prepare_response(info) == error_code());
+
+    BOOST_TEST(to_bytes(processor.second_requests(err, info)) == close_request(7));
+    BOOST_TEST(err == make_error_code(errc::wrong_num_params));
+    BOOST_TEST(info.message() != "");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_execute_once
+
+}
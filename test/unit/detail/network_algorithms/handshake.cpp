@@ -0,0 +1,307 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/detail/network_algorithms/handshake.hpp>
+#include <boost/test/unit_test.hpp>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#include <memory>
+#include <string>
+
+using namespace boost::mysql::detail;
+using boost::mysql::connection_params;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+using boost::mysql::ssl_mode;
+using boost::mysql::collation;
+
+namespace
+{
+
+// An RSA key pair, generated once for all tests
+class rsa_key_pair
+{
+    std::unique_ptr<EVP_PKEY, caching_sha2_password::evp_pkey_deleter> key_;
+    std::string public_pem_;
+public:
+    rsa_key_pair()
+    {
+        std::unique_ptr<EVP_PKEY_CTX, caching_sha2_password::evp_pkey_ctx_deleter> ctx (
+            EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, nullptr));
+        EVP_PKEY* key = nullptr;
+        EVP_PKEY_keygen_init(ctx.get());
+        EVP_PKEY_CTX_set_rsa_keygen_bits(ctx.get(), 2048);
+        EVP_PKEY_keygen(ctx.get(), &key);
+        key_.reset(key);
+
+        std::unique_ptr<BIO, caching_sha2_password::bio_deleter> bio (BIO_new(BIO_s_mem()));
+        PEM_write_bio_PUBKEY(bio.get(), key);
+        char* data = nullptr;
+        long size = BIO_get_mem_data(bio.get(), &data);
+        public_pem_.assign(data, static_cast<std::size_t>(size));
+    }
+
+    static const rsa_key_pair& instance()
+    {
+        static rsa_key_pair res;
+        return res;
+    }
+
+    const std::string& public_pem() const noexcept { return public_pem_; }
+
+    std::string decrypt(const bytestring& input) const
+    {
+        std::unique_ptr<EVP_PKEY_CTX, caching_sha2_password::evp_pkey_ctx_deleter> ctx (
+            EVP_PKEY_CTX_new(key_.get(), nullptr));
+        EVP_PKEY_decrypt_init(ctx.get());
+        EVP_PKEY_CTX_set_rsa_padding(ctx.get(), RSA_PKCS1_OAEP_PADDING);
+        std::size_t size = 0;
+        EVP_PKEY_decrypt(ctx.get(), nullptr, &size, input.data(), input.size());
+        std::string res (size, '\0');
+        EVP_PKEY_decrypt(ctx.get(), reinterpret_cast<unsigned char*>(&res[0]), &size, input.data(), input.size());
+        res.resize(size);
+        return res;
+    }
+};
+
+const std::string scramble ("abcdefghijklmnopqrst");
+const std::string password ("hola");
+
+bytestring to_bytes(boost::string_view s)
+{
+    return bytestring(s.begin(), s.end());
+}
+
+// What the server should get, once decrypted
+std::string scrambled_password()
+{
+    std::string res = password + '\0';
+    for (std::size_t i = 0; i < res.size(); ++i)
+        res[i] ^= scramble[i % scramble.size()];
+    return res;
+}
+
+struct fixture
+{
+    connection_params params {"user", password, "", collation::utf8_general_ci, ssl_mode::disable};
+    bytestring buffer;
+    auth_result result {auth_result::invalid};
+    error_info info;
+
+    // Makes processor select caching_sha2_password, with our scramble
+    void switch_plugin(handshake_processor& processor)
+    {
+        buffer = to_bytes(std::string("\xfe" "caching_sha2_password") + '\0' + scramble + '\0');
+        auto err = processor.process_handshake_server_response(buffer, result, info);
+        BOOST_TEST_REQUIRE(err == error_code());
+        BOOST_TEST_REQUIRE((result == auth_result::send_more_data));
+    }
+
+    error_code process(handshake_processor& processor, bytestring message)
+    {
+        buffer = std::move(message);
+        return processor.process_handshake_server_response(buffer, result, info);
+    }
+
+    error_code request_full_auth(handshake_processor& processor)
+    {
+        return process(processor, { 0x01, 0x04 });
+    }
+
+    error_code send_public_key(handshake_processor& processor)
+    {
+        bytestring message { 0x01 };
+        const auto& pem = rsa_key_pair::instance().public_pem();
+        message.insert(message.end(), pem.begin(), pem.end());
+        return process(processor, std::move(message));
+    }
+
+    void check_encrypted_password() const
+    {
+        BOOST_TEST((result == auth_result::send_more_data));
+        BOOST_TEST(rsa_key_pair::instance().decrypt(buffer) == scrambled_password());
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(test_handshake)
+
+BOOST_AUTO_TEST_SUITE(rsa_full_auth)
+
+BOOST_FIXTURE_TEST_CASE(key_requested_then_cached, fixture)
+{
+    params.set_request_server_public_key(true);
+    server_public_key_cache::instance().erase("rsa_test_1");
+
+    // First connection: request the key
+    handshake_processor processor1 (params, false, "rsa_test_1");
+    switch_plugin(processor1);
+    BOOST_TEST_REQUIRE(request_full_auth(processor1) == error_code());
+    BOOST_TEST((result == auth_result::send_more_data));
+    BOOST_TEST(buffer == bytestring{ caching_sha2_password::request_public_key });
+    BOOST_TEST_REQUIRE(send_public_key(processor1) == error_code());
+    check_encrypted_password();
+
+    // Second connection: use the cached key
+    handshake_processor processor2 (params, false, "rsa_test_1");
+    switch_plugin(processor2);
+    BOOST_TEST_REQUIRE(request_full_auth(processor2) == error_code());
+    check_encrypted_password();
+}
+
+BOOST_FIXTURE_TEST_CASE(cached_key_erased_on_error, fixture)
+{
+    params.set_request_server_public_key(true);
+    server_public_key_cache::instance().put("rsa_test_2", rsa_key_pair::instance().public_pem());
+
+    handshake_processor processor1 (params, false, "rsa_test_2");
+    switch_plugin(processor1);
+    BOOST_TEST_REQUIRE(request_full_auth(processor1) == error_code());
+    check_encrypted_password();
+    auto err = process(processor1, { 0xff, 0x15, 0x04, '#', '2', '8', '0', '0', '0', 'd', 'e', 'n' });
+    BOOST_TEST(err == make_error_code(errc::access_denied_error));
+
+    handshake_processor processor2 (params, false, "rsa_test_2");
+    switch_plugin(processor2);
+    BOOST_TEST_REQUIRE(request_full_auth(processor2) == error_code());
+    BOOST_TEST(buffer == bytestring{ caching_sha2_password::request_public_key });
+}
+
+BOOST_FIXTURE_TEST_CASE(configured_key, fixture)
+{
+    server_public_key_cache::instance().erase("rsa_test_3");
+    params.set_server_public_key(rsa_key_pair::instance().public_pem());
+
+    handshake_processor processor (params, false, "rsa_test_3");
+    switch_plugin(processor);
+    BOOST_TEST_REQUIRE(request_full_auth(processor) == error_code());
+    check_encrypted_password();
+}
+
+BOOST_FIXTURE_TEST_CASE(no_endpoint_not_cached, fixture)
+{
+    params.set_request_server_public_key(true);
+    handshake_processor processor1 (params, false);
+    switch_plugin(processor1);
+    BOOST_TEST_REQUIRE(request_full_auth(processor1) == error_code());
+    BOOST_TEST_REQUIRE(send_public_key(processor1) == error_code());
+    check_encrypted_password();
+
+    handshake_processor processor2 (params, false);
+    switch_plugin(processor2);
+    BOOST_TEST_REQUIRE(request_full_auth(processor2) == error_code());
+    BOOST_TEST(buffer == bytestring{ caching_sha2_password::request_public_key });
+}
+
+BOOST_FIXTURE_TEST_CASE(invalid_key, fixture)
+{
+    params.set_request_server_public_key(true);
+    handshake_processor processor (params, false);
+    switch_plugin(processor);
+    BOOST_TEST_REQUIRE(request_full_auth(processor) == error_code());
+    auto err = process(processor, to_bytes("\x01not a key"));
+    BOOST_TEST(err == make_error_code(errc::invalid_public_key));
+}
+
+BOOST_FIXTURE_TEST_CASE(only_password_hashes, fixture)
+{
+    params.set_request_server_public_key(true);
+    boost::mysql::password_hashes hashes (password);
+    params.set_password("");
+    params.set_password_hashes(&hashes);
+
+    handshake_processor processor (params, false);
+    switch_plugin(processor);
+    BOOST_TEST(request_full_auth(processor) == make_error_code(errc::cleartext_password_unavailable));
+}
+
+BOOST_FIXTURE_TEST_CASE(key_not_requested_by_default, fixture)
+{
+    handshake_processor processor (params, false, "rsa_test_4");
+    switch_plugin(processor);
+    BOOST_TEST(request_full_auth(processor) == make_error_code(errc::auth_plugin_requires_ssl));
+}
+
+BOOST_FIXTURE_TEST_CASE(cached_key_ignored_by_default, fixture)
+{
+    server_public_key_cache::instance().put("rsa_test_5", rsa_key_pair::instance().public_pem());
+
+    handshake_processor processor (params, false, "rsa_test_5");
+    switch_plugin(processor);
+    BOOST_TEST(request_full_auth(processor) == make_error_code(errc::auth_plugin_requires_ssl));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // rsa_full_auth
+
+BOOST_AUTO_TEST_SUITE(change_user)
+
+constexpr capabilities change_user_caps (CLIENT_PROTOCOL_41 | CLIENT_PLUGIN_AUTH | CLIENT_SECURE_CONNECTION);
+
+BOOST_FIXTURE_TEST_CASE(request_uses_previous_auth_state, fixture)
+{
+    params.set_database("db");
+    handshake_processor processor (params, false);
+    auto err = processor.compose_change_user(change_user_caps, "mysql_native_password", scramble, buffer);
+    BOOST_TEST_REQUIRE(err == error_code());
+
+    auth_calculator calc;
+    BOOST_TEST_REQUIRE(calc.calculate("mysql_native_password", password, scramble, false) == error_code());
+    bytestring expected;
+    serialize_message(
+        com_change_user_packet {
+            string_null("user"),
+            string_lenenc(calc.response()),
+            string_null("db"),
+            static_cast<std::uint16_t>(collation::utf8_general_ci),
+            string_null("mysql_native_password")
+        },
+        change_user_caps,
+        expected
+    );
+    BOOST_TEST(buffer == expected);
+}
+
+BOOST_FIXTURE_TEST_CASE(auth_switch, fixture)
+{
+    handshake_processor processor (params, false);
+    auto err = processor.compose_change_user(change_user_caps, "mysql_native_password", "12345678901234567890", buffer);
+    BOOST_TEST_REQUIRE(err == error_code());
+
+    // The server may switch plugins and challenges, as in the handshake.
+    // These are the ones to use in subsequent COM_CHANGE_USERs
+    switch_plugin(processor);
+    BOOST_TEST_REQUIRE(process(processor, { 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00 }) == error_code());
+    BOOST_TEST((result == auth_result::complete));
+    BOOST_TEST(processor.auth_plugin() == "caching_sha2_password");
+    BOOST_TEST(processor.scramble() == scramble);
+}
+
+BOOST_FIXTURE_TEST_CASE(no_previous_handshake, fixture)
+{
+    handshake_processor processor (params, false);
+    auto err = processor.compose_change_user(change_user_caps, "", "", buffer);
+    BOOST_TEST(err == make_error_code(errc::unknown_auth_plugin));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // change_user
+
+BOOST_AUTO_TEST_CASE(server_version)
+{
+    BOOST_TEST(parse_server_version("8.0.27") == 80027u);
+    BOOST_TEST(parse_server_version("5.7.36-log") == 50736u);
+    BOOST_TEST(parse_server_version("10.6.4-MariaDB") == 100604u);
+    BOOST_TEST(parse_server_version("5.5.5-10.1.48-MariaDB-1~bionic") == 100148u);
+    BOOST_TEST(parse_server_version("5.5.5-10.2.0-MariaDB") == 100200u);
+    BOOST_TEST(parse_server_version("") == 0u);
+    BOOST_TEST(parse_server_version("10.6") == 0u);
+    BOOST_TEST(parse_server_version("abc") == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_handshake
+
+}
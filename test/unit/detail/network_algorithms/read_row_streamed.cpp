@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/detail/network_algorithms/read_row_streamed.hpp>
+#include <boost/test/unit_test.hpp>
+#include "test_common.hpp"
+#include <string>
+#include <vector>
+
+using namespace boost::mysql::test;
+using namespace boost::mysql::detail;
+using boost::mysql::value;
+using boost::mysql::row;
+using boost::mysql::field_metadata;
+using boost::mysql::error_code;
+using boost::mysql::error_info;
+using boost::mysql::errc;
+
+namespace
+{
+
+constexpr capabilities caps (CLIENT_PROTOCOL_41 | CLIENT_DEPRECATE_EOF);
+
+struct fixture
+{
+    std::vector<field_metadata> meta {
+        makemeta("id", protocol_field_type::longlong),
+        makemeta("contents", protocol_field_type::blob)
+    };
+    row output;
+    bytestring ok_packet_buffer;
+    ok_packet ok;
+    streamed_field_state state;
+    read_row_result result {read_row_result::error};
+    error_code err;
+    error_info info;
+
+    // Simulates having read the given bytes. Returns false if more bytes are required
+    bool process(
+        const bytestring& bytes,
+        bool message_done,
+        resultset_encoding encoding = resultset_encoding::text,
+        std::uint32_t first_packet_size = 0xff
+    )
+    {
+        output.buffer().insert(output.buffer().end(), bytes.begin(), bytes.end());
+        return process_streamed_row(
+            encoding,
+            caps,
+            meta,
+            output,
+            message_done,
+            first_packet_size,
+            ok_packet_buffer,
+            ok,
+            state,
+            result,
+            err,
+            info
+        );
+    }
+
+    std::string consume_all()
+    {
+        std::string res;
+        char buff [2];
+        while (has_streamed_buffered(state))
+        {
+            std::size_t size = consume_streamed_buffered(state, boost::asio::buffer(buff));
+            res.append(buff, size);
+        }
+        return res;
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(test_read_row_streamed)
+
+BOOST_FIXTURE_TEST_CASE(text_row_in_pieces, fixture)
+{
+    // id = 42 (text), contents = "abcde"
+    BOOST_TEST(!process({ 0x02, '4' }, false));
+    BOOST_TEST(process({ '2', 0x05, 'a', 'b', 'c' }, false));
+    BOOST_TEST(err == error_code());
+    BOOST_TEST((result == read_row_result::row));
+    BOOST_TEST_REQUIRE(output.values().size() == 2u);
+    BOOST_TEST(output.values()[0] == value(42));
+    BOOST_TEST(output.values()[1] == value(""));
+    BOOST_TEST(output.buffer().size() == 4u);
+
+    // Bytes read together with the row are served first
+    BOOST_TEST(state.remaining == 5u);
+    BOOST_TEST(consume_all() == "abc");
+    BOOST_TEST(state.remaining == 2u);
+
+    // The rest are read directly into the user buffer
+    char buff [16];
+    auto read_buff = streamed_read_buffer(state, boost::asio::buffer(buff));
+    BOOST_TEST(read_buff.size() == 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(text_row_null_last_field, fixture)
+{
+    BOOST_TEST(process({ 0x01, '1', 0xfb }, true));
+    BOOST_TEST(err == error_code());
+    BOOST_TEST((result == read_row_result::row));
+    BOOST_TEST(output.values()[1] == value(nullptr));
+    BOOST_TEST(state.remaining == 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(binary_row, fixture)
+{
+    // header, null bitmap, id = 42, contents = "ab" (header only)
+    BOOST_TEST(!process({ 0x00, 0x00, 0x2a, 0x00, 0x00, 0x00 }, false, resultset_encoding::binary));
+    BOOST_TEST(process({ 0x00, 0x00, 0x00, 0x00, 0x02 }, false, resultset_encoding::binary));
+    BOOST_TEST(err == error_code());
+    BOOST_TEST((result == read_row_result::row));
+    BOOST_TEST(output.values()[0] == value(42));
+    BOOST_TEST(state.remaining == 2u);
+    BOOST_TEST(!has_streamed_buffered(state));
+}
+
+BOOST_FIXTURE_TEST_CASE(binary_row_not_streamable, fixture)
+{
+    meta[1] = makemeta("contents", protocol_field_type::longlong);
+    BOOST_TEST(process({ 0x00, 0x00, 0x2a, 0, 0, 0, 0, 0, 0, 0, 0x01 }, false, resultset_encoding::binary));
+    BOOST_TEST(err == error_code(errc::field_not_streamable));
+    BOOST_TEST((result == read_row_result::error));
+}
+
+BOOST_FIXTURE_TEST_CASE(eof_read_entirely, fixture)
+{
+    BOOST_TEST(!process({ 0xfe, 0x00 }, false));
+    BOOST_TEST(process({ 0x00, 0x02, 0x00, 0x00, 0x00 }, true));
+    BOOST_TEST(err == error_code());
+    BOOST_TEST((result == read_row_result::eof));
+}
+
+// A 16MB field's length prefix starts with 0xfe, like an OK packet. Such a row
+// spans several packets, so it can't be mistaken for one
+BOOST_FIXTURE_TEST_CASE(text_row_big_field_starts_with_eof_header, fixture)
+{
+    meta = { makemeta("contents", protocol_field_type::blob) };
+    BOOST_TEST(process(
+        { 0xfe, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00 },
+        false,
+        resultset_encoding::text,
+        0xffffff
+    ));
+    BOOST_TEST(err == error_code());
+    BOOST_TEST((result == read_row_result::row));
+    BOOST_TEST(state.remaining == 0x1000000u);
+    BOOST_TEST(!has_streamed_buffered(state));
+}
+
+BOOST_FIXTURE_TEST_CASE(error_packet, fixture)
+{
+    BOOST_TEST(process({ 0xff, 0x26, 0x04, '#', '2', '3', '0', '0', '0', 'e', 'r', 'r' }, true));
+    BOOST_TEST(err == error_code(errc::dup_entry));
+    BOOST_TEST(info.message() == "err");
+    BOOST_TEST((result == read_row_result::error));
+}
+
+BOOST_FIXTURE_TEST_CASE(incomplete_message, fixture)
+{
+    BOOST_TEST(process({ 0x02, '4' }, true));
+    BOOST_TEST(err == error_code(errc::incomplete_message));
+    BOOST_TEST((result == read_row_result::error));
+}
+
+BOOST_FIXTURE_TEST_CASE(extra_bytes, fixture)
+{
+    BOOST_TEST(process({ 0x01, '1', 0x01, 'a', 'b' }, true));
+    BOOST_TEST(err == error_code(errc::extra_bytes));
+    BOOST_TEST((result == read_row_result::error));
+}
+
+BOOST_AUTO_TEST_CASE(prepare_read_grows_buffer)
+{
+    row r;
+    streamed_field_state state;
+    auto buff = prepare_streamed_row_read(r, state);
+    BOOST_TEST(buff.size() == streamed_row_min_read_size);
+    commit_streamed_row_read(r, state, 10);
+    BOOST_TEST(r.buffer().size() == 10u);
+    r.buffer().resize(1000);
+    buff = prepare_streamed_row_read(r, state);
+    BOOST_TEST(buff.size() == 1000u);
+    commit_streamed_row_read(r, state, 0);
+    BOOST_TEST(r.buffer().size() == 1000u);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_read_row_streamed
+
+}
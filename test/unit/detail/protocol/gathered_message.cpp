@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/detail/protocol/channel.hpp>
+#include <boost/mysql/detail/protocol/prepared_statement_messages.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace boost::mysql::detail;
+using boost::mysql::value;
+
+namespace
+{
+
+constexpr capabilities caps (CLIENT_PROTOCOL_41 | CLIENT_DEPRECATE_EOF);
+
+bytestring concat(const gathered_message& msg)
+{
+    bytestring res;
+    msg.for_each_buffer([&res](boost::asio::const_buffer buff) {
+        auto first = static_cast<const std::uint8_t*>(buff.data());
+        res.insert(res.end(), first, first + buff.size());
+    });
+    return res;
+}
+
+bytestring concat(const std::vector<boost::asio::const_buffer>& buffers)
+{
+    bytestring res;
+    for (const auto& buff: buffers)
+    {
+        auto first = static_cast<const std::uint8_t*>(buff.data());
+        res.insert(res.end(), first, first + buff.size());
+    }
+    return res;
+}
+
+std::size_t num_external_buffers(const gathered_message& msg, const std::string& external)
+{
+    std::size_t res = 0;
+    msg.for_each_buffer([&](boost::asio::const_buffer buff) {
+        if (buff.data() == external.data())
+            ++res;
+    });
+    return res;
+}
+
+BOOST_AUTO_TEST_SUITE(test_gathered_message)
+
+BOOST_AUTO_TEST_SUITE(serialize_stmt_execute_gathered_)
+
+BOOST_AUTO_TEST_CASE(small_params_copied)
+{
+    std::vector<value> params { value(42), value("abc"), value(nullptr) };
+    auto packet = com_stmt_execute_packet<std::vector<value>::const_iterator> {
+        1, 0, 1, 1, params.begin(), params.end(), nullptr };
+    bytestring expected;
+    serialize_message(packet, caps, expected);
+
+    gathered_message msg;
+    serialize_stmt_execute_gathered(packet, caps, msg);
+    BOOST_TEST(msg.size() == expected.size());
+    BOOST_TEST(concat(msg) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(big_strings_referenced)
+{
+    std::string big1 (min_gathered_string_size, 'a');
+    std::string big2 (min_gathered_string_size * 3, 'b');
+    std::vector<value> params { value(big1), value(42), value(big2), value("abc") };
+    auto packet = com_stmt_execute_packet<std::vector<value>::const_iterator> {
+        1, 0, 1, 1, params.begin(), params.end(), nullptr };
+    bytestring expected;
+    serialize_message(packet, caps, expected);
+
+    gathered_message msg;
+    serialize_stmt_execute_gathered(packet, caps, msg);
+    BOOST_TEST(msg.size() == expected.size());
+    BOOST_TEST(concat(msg) == expected);
+    BOOST_TEST(num_external_buffers(msg, big1) == 1u);
+    BOOST_TEST(num_external_buffers(msg, big2) == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(long_data_params_not_sent)
+{
+    std::string big (min_gathered_string_size, 'a');
+    std::vector<value> params { value(big), value(big) };
+    std::vector<bool> long_data { true, false };
+    auto packet = com_stmt_execute_packet<std::vector<value>::const_iterator> {
+        1, 0, 1, 1, params.begin(), params.end(), &long_data };
+    bytestring expected;
+    serialize_message(packet, caps, expected);
+
+    gathered_message msg;
+    serialize_stmt_execute_gathered(packet, caps, msg);
+    BOOST_TEST(concat(msg) == expected);
+    BOOST_TEST(num_external_buffers(msg, big) == 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // serialize_stmt_execute_gathered_
+
+BOOST_AUTO_TEST_SUITE(frame_gathered_message_)
+
+gathered_message make_message(const bytestring& owned, const std::string& external)
+{
+    gathered_message res;
+    res.reset(owned.size());
+    std::copy(owned.begin(), owned.end(), res.owned_data());
+    res.add_external(res.owned_data() + 1, external.data(), external.size());
+    res.finish(res.owned_data() + owned.size());
+    return res;
+}
+
+BOOST_AUTO_TEST_CASE(single_packet)
+{
+    std::string external ("abc");
+    auto msg = make_message({ 0x01, 0x02 }, external);
+    bytestring storage;
+    std::vector<boost::asio::const_buffer> buffers;
+    auto seqnum = frame_gathered_message(msg, 5, storage, buffers);
+    BOOST_TEST(seqnum == 6);
+    bytestring expected { 0x05, 0x00, 0x00, 0x05, 0x01, 'a', 'b', 'c', 0x02 };
+    BOOST_TEST(concat(buffers) == expected);
+    BOOST_TEST(buffers.size() == 3u); // header and owned bytes, external, owned bytes
+}
+
+BOOST_AUTO_TEST_CASE(empty_message)
+{
+    gathered_message msg;
+    msg.reset(0);
+    msg.finish(msg.owned_data());
+    bytestring storage;
+    std::vector<boost::asio::const_buffer> buffers;
+    auto seqnum = frame_gathered_message(msg, 0, storage, buffers);
+    BOOST_TEST(seqnum == 1);
+    bytestring expected { 0x00, 0x00, 0x00, 0x00 };
+    BOOST_TEST(concat(buffers) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(external_split_across_packets)
+{
+    // Splitting must match frame_message
+    std::string external (MAX_PACKET_SIZE + 10, 'a');
+    auto msg = make_message({ 0x01, 0x02 }, external);
+    bytestring storage;
+    std::vector<boost::asio::const_buffer> buffers;
+    auto seqnum = frame_gathered_message(msg, 0, storage, buffers);
+
+    bytestring contiguous = concat(msg);
+    bytestring expected;
+    auto expected_seqnum = frame_message(boost::asio::buffer(contiguous), 0, expected);
+    BOOST_TEST(seqnum == expected_seqnum);
+    BOOST_TEST(concat(buffers) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(max_size_message)
+{
+    // A message of exactly MAX_PACKET_SIZE bytes requires a trailing empty packet
+    std::string external (MAX_PACKET_SIZE - 2, 'a');
+    auto msg = make_message({ 0x01, 0x02 }, external);
+    bytestring storage;
+    std::vector<boost::asio::const_buffer> buffers;
+    auto seqnum = frame_gathered_message(msg, 0, storage, buffers);
+    BOOST_TEST(seqnum == 2);
+
+    bytestring contiguous = concat(msg);
+    bytestring expected;
+    frame_message(boost::asio::buffer(contiguous), 0, expected);
+    BOOST_TEST(concat(buffers) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(owned_bytes_coalesced)
+{
+    // Small params are copied into a single buffer, together with the header,
+    // so SSL streams don't send a record per buffer
+    std::string big (min_gathered_string_size, 'a');
+    std::vector<value> params { value(1), value("abc"), value(big), value(2), value("def") };
+    auto packet = com_stmt_execute_packet<std::vector<value>::const_iterator> {
+        1, 0, 1, 1, params.begin(), params.end(), nullptr };
+    gathered_message msg;
+    serialize_stmt_execute_gathered(packet, caps, msg);
+    bytestring storage;
+    std::vector<boost::asio::const_buffer> buffers;
+    frame_gathered_message(msg, 0, storage, buffers);
+
+    bytestring contiguous = concat(msg);
+    bytestring expected;
+    frame_message(boost::asio::buffer(contiguous), 0, expected);
+    BOOST_TEST(concat(buffers) == expected);
+    BOOST_TEST_REQUIRE(buffers.size() == 3u);
+    BOOST_TEST(buffers[1].data() == big.data());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // frame_gathered_message_
+
+BOOST_AUTO_TEST_SUITE(deframe_message_)
+
+BOOST_AUTO_TEST_CASE(inverse_of_frame_message)
+{
+    // A message of exactly MAX_PACKET_SIZE bytes spans two packets
+    bytestring message (MAX_PACKET_SIZE, 0x01);
+    bytestring input;
+    frame_message(boost::asio::buffer(message), 3, input);
+    input.push_back(0xaa); // start of the next message, not consumed
+
+    std::uint8_t seqnum = 3;
+    bytestring output;
+    boost::mysql::error_code err;
+    auto consumed = deframe_message(boost::asio::buffer(input), seqnum, output, err);
+    BOOST_TEST(err == boost::mysql::error_code());
+    BOOST_TEST(consumed == input.size() - 1);
+    BOOST_TEST(seqnum == 5);
+    BOOST_TEST((output == message));
+}
+
+BOOST_AUTO_TEST_CASE(incomplete_message)
+{
+    bytestring message { 0x01, 0x02, 0x03 };
+    bytestring input;
+    frame_message(boost::asio::buffer(message), 0, input);
+
+    std::uint8_t seqnum = 0;
+    bytestring output;
+    boost::mysql::error_code err;
+    for (std::size_t size : { std::size_t(0), std::size_t(3), input.size() - 1 })
+    {
+        BOOST_TEST(deframe_message(boost::asio::buffer(input.data(), size), seqnum, output, err) == 0u);
+        BOOST_TEST(err == boost::mysql::error_code());
+        BOOST_TEST(seqnum == 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sequence_number_mismatch)
+{
+    bytestring input { 0x01, 0x00, 0x00, 0x02, 0xff };
+    std::uint8_t seqnum = 1;
+    bytestring output;
+    boost::mysql::error_code err;
+    BOOST_TEST(deframe_message(boost::asio::buffer(input), seqnum, output, err) == 0u);
+    BOOST_TEST(err == make_error_code(boost::mysql::errc::sequence_number_mismatch));
+    BOOST_TEST(seqnum == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // deframe_message_
+
+BOOST_AUTO_TEST_SUITE_END() // test_gathered_message
+
+}
@@ -5,14 +5,17 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
-// Tests for both deserialize_binary_row() and deserialize_text_row()
+// Tests for both deserialize_binary_row() and deserialize_text_row(),
+// and for their lazy counterparts, index_binary_row() and index_text_row()
 
 #include <boost/mysql/detail/protocol/text_deserialization.hpp>
 #include <boost/mysql/detail/protocol/binary_deserialization.hpp>
 #include <boost/mysql/detail/network_algorithms/common.hpp> // for deserialize_row_fn
+#include <boost/mysql/lazy_row.hpp>
 #include "test_common.hpp"
 #include <boost/test/data/monomorphic/collection.hpp>
 #include <boost/test/data/test_case.hpp>
+#include <stdexcept>
 
 using namespace boost::mysql::detail;
 using namespace boost::mysql::test;
@@ -43,6 +46,11 @@ std::vector<field_metadata> make_meta(
 constexpr auto text = &deserialize_text_row;
 constexpr auto bin =  &deserialize_binary_row;
 
+resultset_encoding to_encoding(deserialize_row_fn deserializer)
+{
+    return deserializer == text ? resultset_encoding::text : resultset_encoding::binary;
+}
+
 // Success cases
 struct row_sample
 {
@@ -176,6 +184,47 @@ BOOST_DATA_TEST_CASE(deserialize_row_ok, data::make(make_ok_samples()))
     BOOST_TEST(actual == sample.expected);
 }
 
+BOOST_DATA_TEST_CASE(index_row_ok, data::make(make_ok_samples()))
+{
+    resultset_metadata meta ({}, std::vector<field_metadata>(sample.meta));
+    boost::mysql::lazy_row r;
+    r.set_metadata(meta.shared_fields());
+    r.buffer() = sample.from;
+    deserialization_context ctx (boost::asio::buffer(r.buffer()), capabilities());
+
+    auto err = r.index(ctx, meta.fields(), to_encoding(sample.deserializer));
+    BOOST_TEST(err == error_code());
+    BOOST_TEST_REQUIRE(r.size() == sample.expected.size());
+    for (std::size_t i = 0; i < r.size(); ++i)
+    {
+        BOOST_TEST(r.is_null(i) == sample.expected[i].is_null());
+        BOOST_TEST(r.at(i) == sample.expected[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(lazy_row_outlives_metadata)
+{
+    boost::mysql::lazy_row r;
+    {
+        resultset_metadata meta ({}, make_meta({protocol_field_type::var_string, protocol_field_type::tiny}));
+        r.set_metadata(meta.shared_fields());
+        r.buffer() = {0x03, 0x61, 0x62, 0x63, 0x01, 0x35};
+        deserialization_context ctx (boost::asio::buffer(r.buffer()), capabilities());
+        auto err = r.index(ctx, meta.fields(), resultset_encoding::text);
+        BOOST_TEST_REQUIRE(err == error_code());
+    }
+    BOOST_TEST(r.at(0) == value("abc"));
+    BOOST_TEST(r.at(1) == value(std::int64_t(5)));
+}
+
+BOOST_AUTO_TEST_CASE(lazy_row_at_out_of_range)
+{
+    boost::mysql::lazy_row r;
+    error_code err;
+    BOOST_CHECK_THROW(r.at(0), std::out_of_range);
+    BOOST_CHECK_THROW(r.at(0, err), std::out_of_range);
+}
+
 // Error cases
 struct row_err_sample
 {
@@ -259,6 +308,21 @@ BOOST_DATA_TEST_CASE(deserialize_row_error, data::make(make_err_samples()))
     BOOST_TEST(err == make_error_code(sample.expected));
 }
 
+BOOST_DATA_TEST_CASE(index_row_error, data::make(make_err_samples()))
+{
+    resultset_metadata meta ({}, std::vector<field_metadata>(sample.meta));
+    boost::mysql::lazy_row r;
+    r.set_metadata(meta.shared_fields());
+    r.buffer() = sample.from;
+    deserialization_context ctx (boost::asio::buffer(r.buffer()), capabilities());
+
+    // Errors in values are only detected when the value is accessed
+    auto err = r.index(ctx, meta.fields(), to_encoding(sample.deserializer));
+    for (std::size_t i = 0; !err && i < r.size(); ++i)
+        r.at(i, err);
+    BOOST_TEST(err == make_error_code(sample.expected));
+}
+
 
 BOOST_AUTO_TEST_SUITE_END() // test_row_deserialization
 
@@ -89,6 +89,7 @@ samples_by_type make_all_samples()
 
         &handshake_packet_spec,
         &handshake_response_packet_spec,
+        &com_change_user_packet_spec,
         &auth_switch_request_packet_spec,
         &auth_switch_response_packet_spec,
         &ssl_request_spec,
@@ -101,6 +102,7 @@ samples_by_type make_all_samples()
         &com_stmt_prepare_packet_spec,
         &com_stmt_prepare_ok_packet_spec,
         &com_stmt_execute_packet_spec,
+        &com_stmt_send_long_data_packet_spec,
         &com_stmt_close_packet_spec,
     };
 
@@ -149,6 +149,26 @@ const serialization_test_spec handshake_response_packet_spec {
     }
 };
 
+const serialization_test_spec com_change_user_packet_spec {
+    serialization_test_type::serialization, {
+        { "com_change_user_packet", detail::com_change_user_packet{
+            string_null("root"),
+            string_lenenc(makesv(handshake_response_auth_data)),
+            string_null("db"),
+            static_cast<std::uint16_t>(collation::utf8_general_ci),
+            string_null("mysql_native_password")
+        }, {
+            0x11, 0x72, 0x6f, 0x6f, 0x74, 0x00, 0x14, 0xfe,
+            0xc6, 0x2c, 0x9f, 0xab, 0x43, 0x69, 0x46, 0xc5,
+            0x51, 0x35, 0xa5, 0xff, 0xdb, 0x3f, 0x48, 0xe6,
+            0xfc, 0x34, 0xc9, 0x64, 0x62, 0x00, 0x21, 0x00,
+            0x6d, 0x79, 0x73, 0x71, 0x6c, 0x5f, 0x6e, 0x61,
+            0x74, 0x69, 0x76, 0x65, 0x5f, 0x70, 0x61, 0x73,
+            0x73, 0x77, 0x6f, 0x72, 0x64, 0x00
+        }, handshake_response_caps }
+    }
+};
+
 constexpr std::uint8_t auth_switch_request_auth_data [] = {
     0x49, 0x49, 0x7e, 0x51, 0x5d, 0x1f, 0x19, 0x6a,
     0x0f, 0x5a, 0x63, 0x15, 0x3e, 0x28, 0x31, 0x3e,
@@ -13,6 +13,8 @@
 #include <forward_list>
 #include <array>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace boost {
 namespace mysql {
@@ -56,10 +58,15 @@ serialization_sample make_stmt_execute_sample(
     std::uint8_t new_params_flag,
     const std::array<value, N>& params,
     std::vector<std::uint8_t>&& buffer,
-    std::string&& test_name
+    std::string&& test_name,
+    std::vector<bool>&& long_data_params = {}
 )
 {
-    auto params_shared = std::make_shared<Collection>(params.begin(), params.end());
+    using storage_type = std::pair<Collection, std::vector<bool>>;
+    auto storage = std::make_shared<storage_type>(
+        Collection(params.begin(), params.end()),
+        std::move(long_data_params)
+    );
     return serialization_sample(
         std::move(test_name),
         detail::com_stmt_execute_packet<typename Collection::const_iterator> {
@@ -67,12 +74,13 @@ serialization_sample make_stmt_execute_sample(
             flags,
             itercount,
             new_params_flag,
-            params_shared->begin(),
-            params_shared->end()
+            storage->first.begin(),
+            storage->first.end(),
+            &storage->second
         },
         std::move(buffer),
         0, // capabilities
-        params_shared
+        storage
     );
 }
 
@@ -184,10 +192,30 @@ const serialization_test_spec com_stmt_execute_packet_spec {
                 0xab, 0x00, 0x00, 0x00, 0x00, 0x00
             },
             "forward_list_iterator"
+        ),
+        make_stmt_execute_sample(1, 0, 1, 1,
+            make_values(std::int64_t(1), nullptr, nullptr), {
+                0x17, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+                0x00, 0x00, 0x04, 0x01, 0x08, 0x00, 0xfc, 0x00,
+                0x06, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+                0x00, 0x00
+            },
+            "long_data",
+            { false, true }
         )
     }
 };
 
+const serialization_test_spec com_stmt_send_long_data_packet_spec {
+    serialization_test_type::serialization, {
+        { "com_stmt_send_long_data_packet", detail::com_stmt_send_long_data_packet{
+            1, 2, string_eof("abc")
+        }, {
+            0x18, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x61, 0x62, 0x63
+        } }
+    }
+};
+
 const serialization_test_spec com_stmt_close_packet_spec {
     serialization_test_type::serialization, {
         { "com_stmt_close_packet", detail::com_stmt_close_packet{1}, {0x19, 0x01, 0x00, 0x00, 0x00} }
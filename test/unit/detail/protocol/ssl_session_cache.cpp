@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/detail/protocol/ssl_session_cache.hpp>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+
+using namespace boost::mysql::detail;
+
+namespace
+{
+
+struct ssl_deleter
+{
+    void operator()(SSL* ssl) const noexcept { SSL_free(ssl); }
+};
+
+using ssl_ptr = std::unique_ptr<SSL, ssl_deleter>;
+
+ssl_ptr make_ssl()
+{
+    return ssl_ptr(SSL_new(default_ssl_context::instance().context().native_handle()));
+}
+
+BOOST_AUTO_TEST_SUITE(test_ssl_session_cache)
+
+BOOST_AUTO_TEST_CASE(resume_empty)
+{
+    ssl_session_cache cache;
+    auto ssl = make_ssl();
+    BOOST_TEST(!cache.resume("localhost:3306", ssl.get()));
+    BOOST_TEST(cache.size() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(put_resume)
+{
+    ssl_session_cache cache;
+    SSL_SESSION* session = SSL_SESSION_new();
+    cache.put("localhost:3306", session);
+    BOOST_TEST(cache.size() == 1u);
+
+    auto ssl = make_ssl();
+    BOOST_TEST(cache.resume("localhost:3306", ssl.get()));
+    BOOST_TEST(SSL_get_session(ssl.get()) == session);
+    BOOST_TEST(!cache.resume("localhost:3307", make_ssl().get()));
+}
+
+BOOST_AUTO_TEST_CASE(put_replaces)
+{
+    ssl_session_cache cache;
+    SSL_SESSION* session1 = SSL_SESSION_new();
+    SSL_SESSION* session2 = SSL_SESSION_new();
+    cache.put("localhost:3306", session1);
+    cache.put("localhost:3306", session2);
+    BOOST_TEST(cache.size() == 1u);
+
+    auto ssl = make_ssl();
+    BOOST_TEST(cache.resume("localhost:3306", ssl.get()));
+    BOOST_TEST(SSL_get_session(ssl.get()) == session2);
+}
+
+BOOST_AUTO_TEST_CASE(session_outlives_cache)
+{
+    // SSL objects hold their own reference to the resumed session
+    auto ssl = make_ssl();
+    {
+        ssl_session_cache cache;
+        cache.put("localhost:3306", SSL_SESSION_new());
+        BOOST_TEST(cache.resume("localhost:3306", ssl.get()));
+    }
+    BOOST_TEST(SSL_get_session(ssl.get()) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(default_context_shared)
+{
+    BOOST_TEST(&default_ssl_context::instance().context() == &default_ssl_context::instance().context());
+    auto mode = SSL_CTX_get_session_cache_mode(default_ssl_context::instance().context().native_handle());
+    BOOST_TEST((mode & SSL_SESS_CACHE_CLIENT) != 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_ssl_session_cache
+
+}
@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2019-2021 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/format_sql.hpp>
+#include <boost/mysql/prepared_statement.hpp>
+#include "test_common.hpp"
+#include <boost/test/unit_test.hpp>
+#include <limits>
+#include <string>
+
+using boost::mysql::format_sql;
+using boost::mysql::format_options;
+using boost::mysql::collation;
+using boost::mysql::make_values;
+using boost::mysql::no_statement_params;
+using boost::mysql::value;
+using boost::mysql::error_code;
+using boost::mysql::errc;
+using namespace boost::mysql::test;
+
+namespace
+{
+
+constexpr format_options opts (collation::utf8mb4_general_ci, true);
+
+BOOST_AUTO_TEST_SUITE(test_format_sql)
+
+BOOST_AUTO_TEST_CASE(placeholders)
+{
+    BOOST_TEST(format_sql(opts, "SELECT {}, {} FROM t WHERE id = {}", make_values(42, "abc", nullptr)) ==
+        "SELECT 42, 'abc' FROM t WHERE id = NULL");
+}
+
+BOOST_AUTO_TEST_CASE(no_placeholders)
+{
+    BOOST_TEST(format_sql(opts, "SELECT 1", no_statement_params) == "SELECT 1");
+    BOOST_TEST(format_sql(opts, "", no_statement_params) == "");
+}
+
+BOOST_AUTO_TEST_CASE(escaped_braces)
+{
+    BOOST_TEST(format_sql(opts, "SELECT '{{}}', {}", make_values(1)) == "SELECT '{}', 1");
+}
+
+BOOST_AUTO_TEST_CASE(value_collections)
+{
+    auto args = make_value_vector(makedate(2020, 2, 19), 4.2);
+    BOOST_TEST(format_sql(opts, "{}{}", args) == "'2020-02-19'4.2000000000000002");
+}
+
+BOOST_AUTO_TEST_CASE(long_strings)
+{
+    // Exercise word-at-a-time scanning, with special characters in different positions
+    std::string plain (37, 'a');
+    BOOST_TEST(format_sql(opts, "{}", make_values(plain)) == "'" + plain + "'");
+    for (std::size_t i = 0; i < plain.size(); ++i)
+    {
+        std::string quoted = plain;
+        quoted[i] = '\'';
+        std::string expected = "'" + plain.substr(0, i) + "\\'" + plain.substr(i + 1) + "'";
+        BOOST_TEST(format_sql(opts, "{}", make_values(quoted)) == expected);
+
+        std::string null_byte = plain;
+        null_byte[i] = '\0';
+        expected = "'" + plain.substr(0, i) + "\\0" + plain.substr(i + 1) + "'";
+        BOOST_TEST(format_sql(opts, "{}", make_values(null_byte)) == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(no_backslash_escapes)
+{
+    format_options no_backslash (collation::utf8mb4_general_ci, false);
+    BOOST_TEST(format_sql(no_backslash, "SELECT {}", make_values("it's a\\b")) == "SELECT 'it''s a\\b'");
+}
+
+BOOST_AUTO_TEST_CASE(unsafe_charsets)
+{
+    std::string output;
+    error_code err;
+    for (auto col: { collation::gbk_chinese_ci, collation::sjis_japanese_ci, collation::big5_bin,
+                     collation::cp932_japanese_ci, collation::gb18030_chinese_ci })
+    {
+        format_sql(format_options(col), "SELECT {}", make_values("abc"), output, err);
+        BOOST_TEST(err == error_code(errc::unsafe_charset));
+    }
+    format_sql(format_options(collation::latin1_swedish_ci), "SELECT {}", make_values("abc"), output, err);
+    BOOST_TEST(err == error_code());
+}
+
+BOOST_AUTO_TEST_CASE(output_reused)
+{
+    std::string output ("previous contents");
+    error_code err (errc::no);
+    format_sql(opts, "SELECT {}", make_values("a'b"), output, err);
+    BOOST_TEST(err == error_code());
+    BOOST_TEST(output == "SELECT 'a\\'b'");
+}
+
+BOOST_AUTO_TEST_CASE(errors)
+{
+    std::string output;
+    error_code err;
+    format_sql(opts, "SELECT {}", no_statement_params, output, err);
+    BOOST_TEST(err == error_code(errc::invalid_format_string));
+    format_sql(opts, "SELECT 1", make_values(1), output, err);
+    BOOST_TEST(err == error_code(errc::invalid_format_string));
+    format_sql(opts, "SELECT {", no_statement_params, output, err);
+    BOOST_TEST(err == error_code(errc::invalid_format_string));
+    format_sql(opts, "SELECT }", no_statement_params, output, err);
+    BOOST_TEST(err == error_code(errc::invalid_format_string));
+    format_sql(opts, "SELECT {0}", make_values(1), output, err);
+    BOOST_TEST(err == error_code(errc::invalid_format_string));
+    format_sql(opts, "SELECT {}", make_values(std::numeric_limits<double>::quiet_NaN()), output, err);
+    BOOST_TEST(err == error_code(errc::unrepresentable_value));
+}
+
+BOOST_AUTO_TEST_CASE(errors_exceptions)
+{
+    BOOST_CHECK_THROW(format_sql(opts, "SELECT {}", no_statement_params), boost::system::system_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // test_format_sql
+
+}
@@ -7,11 +7,14 @@
 
 #include <boost/mysql/metadata.hpp>
 #include "test_common.hpp"
+#include <thread>
 
 using namespace boost::mysql::detail;
 using boost::mysql::collation;
 using boost::mysql::field_metadata;
 using boost::mysql::field_type;
+using boost::mysql::case_sensitivity;
+using boost::mysql::test::makemeta;
 
 BOOST_AUTO_TEST_SUITE(test_metadata)
 
@@ -127,4 +130,109 @@ BOOST_AUTO_TEST_CASE(field_metadata_float_field)
 
 }
 
+// resultset_metadata::field_index
+resultset_metadata make_resultset_metadata(std::vector<field_metadata> fields)
+{
+    return resultset_metadata({}, std::move(fields));
+}
+
+BOOST_AUTO_TEST_CASE(field_index_case_sensitive)
+{
+    auto meta = make_resultset_metadata({
+        makemeta("id", protocol_field_type::long_),
+        makemeta("name", protocol_field_type::var_string),
+        makemeta("Name", protocol_field_type::var_string),
+    });
+    BOOST_TEST(meta.field_index("id", case_sensitivity::case_sensitive).value() == 0u);
+    BOOST_TEST(meta.field_index("name", case_sensitivity::case_sensitive).value() == 1u);
+    BOOST_TEST(meta.field_index("Name", case_sensitivity::case_sensitive).value() == 2u);
+    BOOST_TEST(!meta.field_index("ID", case_sensitivity::case_sensitive));
+    BOOST_TEST(!meta.field_index("other", case_sensitivity::case_sensitive));
+    BOOST_TEST(!meta.field_index("", case_sensitivity::case_sensitive));
+}
+
+BOOST_AUTO_TEST_CASE(field_index_case_insensitive)
+{
+    auto meta = make_resultset_metadata({
+        makemeta("id", protocol_field_type::long_),
+        makemeta("Name", protocol_field_type::var_string),
+        makemeta("name", protocol_field_type::var_string),
+    });
+    BOOST_TEST(meta.field_index("ID", case_sensitivity::case_insensitive).value() == 0u);
+    BOOST_TEST(meta.field_index("name", case_sensitivity::case_insensitive).value() == 1u);
+    BOOST_TEST(meta.field_index("NAME", case_sensitivity::case_insensitive).value() == 1u);
+    BOOST_TEST(!meta.field_index("names", case_sensitivity::case_insensitive));
+
+    // The same table serves case sensitive lookups
+    BOOST_TEST(meta.field_index("name", case_sensitivity::case_sensitive).value() == 2u);
+}
+
+BOOST_AUTO_TEST_CASE(field_index_many_fields)
+{
+    static const char* names [] = {
+        "f0", "f1", "f2", "f3", "f4", "f5", "f6", "f7", "f8", "f9",
+        "f10", "f11", "f12", "f13", "f14", "f15", "f16", "f17", "f18", "f19"
+    };
+    std::vector<field_metadata> fields;
+    for (const char* name: names)
+        fields.push_back(makemeta(name, protocol_field_type::long_));
+    auto meta = make_resultset_metadata(std::move(fields));
+    for (std::size_t i = 0; i < 20; ++i)
+    {
+        BOOST_TEST_CONTEXT(i)
+        {
+            BOOST_TEST(meta.field_index(names[i], case_sensitivity::case_sensitive).value() == i);
+            BOOST_TEST(meta.field_index(names[i], case_sensitivity::case_insensitive).value() == i);
+        }
+    }
+    BOOST_TEST(!meta.field_index("f20", case_sensitivity::case_sensitive));
+}
+
+BOOST_AUTO_TEST_CASE(field_index_no_fields)
+{
+    resultset_metadata meta;
+    BOOST_TEST(!meta.field_index("id", case_sensitivity::case_sensitive));
+    BOOST_TEST(!meta.field_index("id", case_sensitivity::case_insensitive));
+}
+
+BOOST_AUTO_TEST_CASE(field_index_after_move)
+{
+    auto meta = make_resultset_metadata({
+        makemeta("id", protocol_field_type::long_),
+        makemeta("name", protocol_field_type::var_string),
+    });
+    BOOST_TEST(meta.field_index("name", case_sensitivity::case_sensitive).value() == 1u);
+    resultset_metadata meta2 (std::move(meta));
+    BOOST_TEST(meta2.field_index("name", case_sensitivity::case_sensitive).value() == 1u);
+    BOOST_TEST(meta2.field_index("ID", case_sensitivity::case_insensitive).value() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(field_index_built_on_first_lookup)
+{
+    auto meta = make_resultset_metadata({
+        makemeta("id", protocol_field_type::longlong),
+        makemeta("name", protocol_field_type::var_string)
+    });
+    BOOST_TEST(!meta.field_index_built());
+    BOOST_TEST(meta.field_index("name", case_sensitivity::case_sensitive).value() == 1u);
+    BOOST_TEST(meta.field_index_built());
+}
+
+BOOST_AUTO_TEST_CASE(field_index_concurrent_lookups)
+{
+    auto meta = make_resultset_metadata({
+        makemeta("id", protocol_field_type::long_),
+        makemeta("name", protocol_field_type::var_string),
+    });
+    auto lookup = [&meta] {
+        for (int i = 0; i < 100; ++i)
+            meta.field_index("NAME", case_sensitivity::case_insensitive);
+    };
+    std::thread t1 (lookup);
+    std::thread t2 (lookup);
+    t1.join();
+    t2.join();
+    BOOST_TEST(meta.field_index("NAME", case_sensitivity::case_insensitive).value() == 1u);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // test_metadata
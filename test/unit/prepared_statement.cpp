@@ -102,6 +102,23 @@ BOOST_AUTO_TEST_CASE(move_assign_valid_to_valid)
     BOOST_TEST(s2.num_params() == 8);
 }
 
+// deferred close
+BOOST_AUTO_TEST_CASE(close_deferred_queues_request)
+{
+    chan_t chan;
+    chan.set_deferred_close(true);
+    stmt_t s1 (chan, com_stmt_prepare_ok_packet{10, 9, 8, 7});
+    stmt_t s2 (chan, com_stmt_prepare_ok_packet{1, 2, 3, 4});
+    BOOST_TEST(!chan.has_pending_writes());
+    s1.close();
+    s2.close();
+    BOOST_TEST(chan.has_pending_writes());
+
+    // Statements don't survive reconnection, so neither do their close requests
+    chan.reset();
+    BOOST_TEST(!chan.has_pending_writes());
+}
+
 // rebind executor
 BOOST_AUTO_TEST_CASE(rebind_executor)
 {
@@ -6,11 +6,15 @@
 //
 
 #include <boost/mysql/resultset.hpp>
+#include <boost/mysql/lazy_row.hpp>
+#include <boost/mysql/column_batch.hpp>
 #include <boost/mysql/detail/protocol/channel.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/test/unit_test.hpp>
 #include "test_stream.hpp"
+#include "test_common.hpp"
+#include <stdexcept>
 
 using resultset_t = boost::mysql::resultset<boost::mysql::test::test_stream>;
 using chan_t = boost::mysql::detail::channel<boost::mysql::test::test_stream>; 
@@ -96,4 +100,58 @@ BOOST_AUTO_TEST_CASE(rebind_executor)
     BOOST_TEST((std::is_same<rebound_type, expected_type>::value));
 }
 
+// read_columns
+BOOST_AUTO_TEST_CASE(read_columns_complete_resultset)
+{
+    chan_t chan;
+    resultset_t r (chan, boost::mysql::detail::bytestring(), boost::mysql::detail::ok_packet());
+    boost::mysql::column_batch batch;
+    boost::mysql::error_code err;
+    boost::mysql::error_info info;
+    read_columns(r, batch, err, info);
+    BOOST_TEST(err == boost::mysql::error_code());
+    BOOST_TEST(batch.columns().empty());
+    BOOST_TEST(batch.num_rows() == 0u);
+}
+
+// read_one with lazy rows
+BOOST_AUTO_TEST_CASE(read_one_lazy_row_complete_resultset)
+{
+    chan_t chan;
+    resultset_t r (chan, boost::mysql::detail::bytestring(), boost::mysql::detail::ok_packet());
+    boost::mysql::lazy_row output;
+    boost::mysql::error_code err;
+    boost::mysql::error_info info;
+    BOOST_TEST(!read_one(r, output, err, info));
+    BOOST_TEST(err == boost::mysql::error_code());
+    BOOST_TEST(output.empty());
+}
+
+// lookup by field name
+BOOST_AUTO_TEST_CASE(field_index_and_row_at)
+{
+    using boost::mysql::case_sensitivity;
+    using boost::mysql::detail::protocol_field_type;
+    using boost::mysql::test::makemeta;
+
+    std::vector<boost::mysql::field_metadata> fields {
+        makemeta("id", protocol_field_type::long_),
+        makemeta("name", protocol_field_type::var_string)
+    };
+    chan_t chan;
+    resultset_t r (
+        chan,
+        boost::mysql::detail::resultset_metadata({}, std::move(fields)),
+        boost::mysql::detail::resultset_encoding::text
+    );
+    BOOST_TEST(r.field_index("name").value() == 1u);
+    BOOST_TEST(!r.field_index("NAME"));
+    BOOST_TEST(r.field_index("NAME", case_sensitivity::case_insensitive).value() == 1u);
+
+    boost::mysql::row rw (boost::mysql::test::make_value_vector(42, "abc"), {});
+    BOOST_TEST(rw.at("id", r) == boost::mysql::value(42));
+    BOOST_TEST(rw.at("Name", r, case_sensitivity::case_insensitive) == boost::mysql::value("abc"));
+    BOOST_CHECK_THROW(rw.at("Name", r), std::out_of_range);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // test_resultset
@@ -6,13 +6,42 @@
 //
 
 #include <boost/mysql/socket_connection.hpp>
+#include <boost/mysql/hedged_query.hpp>
+#include <boost/mysql/detail/auxiliar/cancellation.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
+#ifdef BOOST_MYSQL_HAS_CANCELLATION_SLOTS
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#elif defined(BOOST_MYSQL_REQUIRE_CANCELLATION_SLOTS)
+#error "Per-operation cancellation tests require Boost 1.77 or later"
+#endif
 #include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using boost::mysql::error_code;
+using boost::mysql::errc;
 
 BOOST_AUTO_TEST_SUITE(test_socket_connection)
 
 using other_executor = boost::asio::strand<boost::asio::io_context::executor_type>;
 
+// A server that accepts connections but never sends anything. Connections
+// beyond the first one stay in the listen backlog, which also completes
+// the client's connect
+struct silent_server_fixture
+{
+    boost::asio::io_context ctx;
+    boost::asio::ip::tcp::acceptor acceptor {ctx, {boost::asio::ip::address_v4::loopback(), 0}};
+    boost::asio::ip::tcp::socket server_sock {ctx};
+    boost::mysql::tcp_connection conn {ctx};
+    boost::mysql::connection_params params {"user", "password"};
+
+    silent_server_fixture() { acceptor.async_accept(server_sock, [](error_code) {}); }
+};
+
 BOOST_AUTO_TEST_CASE(socket_connection_rebind_executor)
 {
     using rebound_type = boost::mysql::tcp_connection::rebind_executor<other_executor>::other;
@@ -25,4 +54,228 @@ BOOST_AUTO_TEST_CASE(socket_connection_rebind_executor)
     BOOST_TEST((std::is_same<rebound_type, expected_type>::value));
 }
 
+BOOST_AUTO_TEST_SUITE(cancel_running_query)
+
+// The endpoint is recorded by connect or handshake, so the socket
+// (which may be in use by another thread) isn't accessed
+BOOST_AUTO_TEST_CASE(not_connected)
+{
+    boost::asio::io_context ctx;
+    boost::mysql::tcp_connection conn (ctx);
+    boost::mysql::connection_params params {"user", "password"};
+    error_code err;
+    boost::mysql::error_info info;
+    conn.cancel_running_query(params, err, info);
+    BOOST_TEST(err == make_error_code(boost::asio::error::not_connected));
+
+    err.clear();
+    conn.async_cancel_running_query(params, [&err](error_code ec) { err = ec; });
+    ctx.run();
+    BOOST_TEST(err == make_error_code(boost::asio::error::not_connected));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // cancel_running_query
+
+BOOST_AUTO_TEST_SUITE(timeout)
+
+BOOST_AUTO_TEST_CASE(disabled_by_default)
+{
+    boost::asio::io_context ctx;
+    boost::mysql::tcp_connection conn (ctx);
+    BOOST_TEST(conn.timeout().count() == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(handshake_times_out, silent_server_fixture)
+{
+    conn.set_timeout(std::chrono::milliseconds(50));
+    error_code err;
+    conn.async_connect(acceptor.local_endpoint(), params, [&err](error_code ec) { err = ec; });
+    ctx.run();
+    BOOST_TEST(err == make_error_code(errc::timeout));
+    BOOST_TEST(!conn.next_layer().is_open());
+}
+
+BOOST_FIXTURE_TEST_CASE(deadline_taken_when_operation_starts, silent_server_fixture)
+{
+    // The timeout is changed after initiating the operation, which doesn't affect it
+    conn.set_timeout(std::chrono::milliseconds(50));
+    error_code err;
+    conn.async_connect(acceptor.local_endpoint(), params, [&err](error_code ec) { err = ec; });
+    conn.set_timeout(std::chrono::hours(1));
+    ctx.run();
+    BOOST_TEST(err == make_error_code(errc::timeout));
+}
+
+BOOST_FIXTURE_TEST_CASE(timer_cancelled_on_completion, silent_server_fixture)
+{
+    // The server closes the connection, so the handshake fails before the deadline.
+    // If the timer was left armed, run() wouldn't return until it expired
+    acceptor.cancel();
+    acceptor.async_accept(server_sock, [this](error_code) { server_sock.close(); });
+    conn.set_timeout(std::chrono::hours(1));
+    error_code err;
+    conn.async_connect(acceptor.local_endpoint(), params, [&err](error_code ec) { err = ec; });
+    ctx.run();
+    BOOST_TEST(err != error_code());
+    BOOST_TEST(err != make_error_code(errc::timeout));
+}
+
+BOOST_FIXTURE_TEST_CASE(destroyed_with_timer_handler_queued, silent_server_fixture)
+{
+    // The server closes the connection and blocks the io_context past the deadline,
+    // so the I/O completion and the expired timer handler are both queued.
+    // The connection is destroyed from the completion handler, before
+    // the timer handler runs, which must then not access it
+    acceptor.cancel();
+    acceptor.async_accept(server_sock, [this](error_code) {
+        server_sock.close();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    });
+    std::unique_ptr<boost::mysql::tcp_connection> owned_conn (new boost::mysql::tcp_connection(ctx));
+    owned_conn->set_timeout(std::chrono::milliseconds(20));
+    error_code err;
+    owned_conn->async_connect(acceptor.local_endpoint(), params, [&err, &owned_conn](error_code ec) {
+        err = ec;
+        owned_conn.reset();
+    });
+    ctx.run();
+    BOOST_TEST(err != error_code());
+    BOOST_TEST(!owned_conn);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // timeout
+
+#ifdef BOOST_MYSQL_HAS_CANCELLATION_SLOTS
+
+BOOST_AUTO_TEST_SUITE(cancellation)
+
+struct cancellation_fixture : silent_server_fixture
+{
+    boost::asio::cancellation_signal sig;
+    boost::asio::steady_timer timer {ctx};
+
+    // Gives the operation time to reach a network read
+    void emit_later(boost::asio::cancellation_type type)
+    {
+        timer.expires_after(std::chrono::milliseconds(50));
+        timer.async_wait([this, type](error_code) { sig.emit(type); });
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(terminal_cancellation, cancellation_fixture)
+{
+    error_code err;
+    conn.async_connect(
+        acceptor.local_endpoint(),
+        params,
+        boost::asio::bind_cancellation_slot(sig.slot(), [&err](error_code ec) { err = ec; })
+    );
+    boost::asio::post(ctx, [this] { sig.emit(boost::asio::cancellation_type::terminal); });
+    ctx.run();
+    BOOST_TEST(err == error_code(boost::asio::error::operation_aborted));
+    BOOST_TEST(!conn.next_layer().is_open());
+}
+
+// Filtered out by async_compose, so the operation runs until the timeout
+BOOST_FIXTURE_TEST_CASE(partial_and_total_ignored, cancellation_fixture)
+{
+    conn.set_timeout(std::chrono::milliseconds(100));
+    error_code err;
+    conn.async_connect(
+        acceptor.local_endpoint(),
+        params,
+        boost::asio::bind_cancellation_slot(sig.slot(), [&err](error_code ec) { err = ec; })
+    );
+    boost::asio::post(ctx, [this] { sig.emit(boost::asio::cancellation_type::partial); });
+    emit_later(boost::asio::cancellation_type::total);
+    ctx.run();
+    BOOST_TEST(err == make_error_code(errc::timeout));
+}
+
+BOOST_FIXTURE_TEST_CASE(cancel_running_query, cancellation_fixture)
+{
+    // Records the server's endpoint
+    error_code err;
+    conn.async_connect(
+        acceptor.local_endpoint(),
+        params,
+        boost::asio::bind_cancellation_slot(sig.slot(), [&err](error_code ec) { err = ec; })
+    );
+    boost::asio::post(ctx, [this] { sig.emit(boost::asio::cancellation_type::terminal); });
+    ctx.run();
+    BOOST_TEST(err == error_code(boost::asio::error::operation_aborted));
+
+    // The control connection's handshake never completes
+    ctx.restart();
+    err.clear();
+    conn.async_cancel_running_query(
+        params,
+        boost::asio::bind_cancellation_slot(sig.slot(), [&err](error_code ec) { err = ec; })
+    );
+    emit_later(boost::asio::cancellation_type::terminal);
+    ctx.run();
+    BOOST_TEST(err == error_code(boost::asio::error::operation_aborted));
+}
+
+// The queries are sent over bare TCP connections, and never get a response
+struct hedged_query_fixture : cancellation_fixture
+{
+    boost::mysql::tcp_connection secondary {ctx};
+    std::vector<boost::mysql::row> rows;
+    error_code err;
+    std::size_t index {2};
+    bool drained {false};
+    error_code drain_err;
+
+    hedged_query_fixture()
+    {
+        conn.next_layer().connect(acceptor.local_endpoint());
+        secondary.next_layer().connect(acceptor.local_endpoint());
+    }
+
+    void run(std::chrono::steady_clock::duration delay)
+    {
+        boost::mysql::async_hedged_query(
+            conn,
+            secondary,
+            "SELECT 1",
+            delay,
+            params,
+            rows,
+            [this](error_code query_err, error_code) {
+                drained = true;
+                drain_err = query_err;
+            },
+            boost::asio::bind_cancellation_slot(sig.slot(), [this](error_code ec, std::size_t i) {
+                err = ec;
+                index = i;
+            })
+        );
+        emit_later(boost::asio::cancellation_type::terminal);
+        ctx.run();
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(hedged_query_secondary_not_started, hedged_query_fixture)
+{
+    run(std::chrono::hours(1));
+    BOOST_TEST(err == error_code(boost::asio::error::operation_aborted));
+    BOOST_TEST(index == 0u);
+    BOOST_TEST(drained);
+    BOOST_TEST(drain_err == error_code());
+}
+
+BOOST_FIXTURE_TEST_CASE(hedged_query_both_running, hedged_query_fixture)
+{
+    run(std::chrono::milliseconds(0));
+    BOOST_TEST(err == error_code(boost::asio::error::operation_aborted));
+    BOOST_TEST(index == 0u);
+    BOOST_TEST(drained);
+    BOOST_TEST(drain_err == error_code(boost::asio::error::operation_aborted));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // cancellation
+
+#endif
+
 BOOST_AUTO_TEST_SUITE_END() // test_socket_connection
\ No newline at end of file
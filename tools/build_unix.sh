@@ -23,11 +23,18 @@ function get_cmake {
     fi
 }
 
-# Build latest boost (for CMake builds)
+# Build latest boost (for CMake builds), or the release in BOOST_VERSION (e.g. 1.77.0)
 function build_boost {
     sudo mkdir $BOOST_ROOT
     sudo chmod 777 $BOOST_ROOT
-    git clone https://github.com/anarthal/boost-unix-mirror.git boost-latest
+    if [ "$BOOST_VERSION" != "" ]; then
+        local boost_dir=boost_${BOOST_VERSION//./_}
+        wget https://boostorg.jfrog.io/artifactory/main/release/$BOOST_VERSION/source/$boost_dir.tar.gz -q -O boost.tar.gz
+        tar -xzf boost.tar.gz
+        mv $boost_dir boost-latest
+    else
+        git clone https://github.com/anarthal/boost-unix-mirror.git boost-latest
+    fi
     cd boost-latest
     ./bootstrap.sh --prefix=$BOOST_ROOT
     ./b2 --prefix=$BOOST_ROOT \